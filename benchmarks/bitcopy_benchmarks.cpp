@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/bitcopy.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// Copies range(0) bytes worth of bits from bit range(1) of the source to bit range(2)
+// of the destination
+class BitcopyBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        nbits = static_cast<size_t>(state.range(0)) * 8;
+        src_bit = static_cast<size_t>(state.range(1));
+        dest_bit = static_cast<size_t>(state.range(2));
+        src.assign(nbits / 8 + 2, 0x5A);
+        dest.assign(nbits / 8 + 2, 0);
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        src.clear();
+        src.shrink_to_fit();
+        dest.clear();
+        dest.shrink_to_fit();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(nbits / 8));
+    }
+
+    size_t nbits = 0;
+    size_t src_bit = 0;
+    size_t dest_bit = 0;
+    std::vector<uint8_t> src;
+    std::vector<uint8_t> dest;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(BitcopyBenchmark, Bitcopy)(benchmark::State& state) {
+    for (auto _ : state) {
+        omm::bitcopy(dest.data(), dest_bit, src.data(), src_bit, nbits);
+        benchmark::DoNotOptimize(dest.data());
+        benchmark::ClobberMemory();
+    }
+    report(state);
+}
+
+// Baseline: the byte-at-a-time shift loop, one output byte assembled from two source bytes
+BENCHMARK_DEFINE_F(BitcopyBenchmark, ByteShiftLoop)(benchmark::State& state) {
+    for (auto _ : state) {
+        uint8_t* d = dest.data() + dest_bit / 8;
+        const uint8_t* s = src.data() + src_bit / 8;
+        const unsigned src_shift = src_bit % 8;
+        const unsigned dest_shift = dest_bit % 8;
+        // Source bits realigned to the destination offset, carried across bytes
+        unsigned carry = d[0] & ((1u << dest_shift) - 1);
+        for (size_t i = 0; i < nbits / 8; ++i) {
+            const unsigned byte = ((s[i] >> src_shift) | (s[i + 1] << (8 - src_shift))) & 0xFF;
+            d[i] = static_cast<uint8_t>(carry | (byte << dest_shift));
+            carry = byte >> (8 - dest_shift);
+        }
+        d[nbits / 8] = static_cast<uint8_t>((d[nbits / 8] & ~((1u << dest_shift) - 1)) | carry);
+        benchmark::DoNotOptimize(dest.data());
+        benchmark::ClobberMemory();
+    }
+    report(state);
+}
+
+// === Benchmark Configuration ===
+
+// Payload sizes in bytes, with byte-aligned, source-shifted and doubly shifted offsets
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(BitcopyBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{64, 4 * KB, 1 * MB, 64 * MB}, {0, 3}, {0, 5}}) \
+        ->ArgNames({"size", "src_bit", "dest_bit"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(Bitcopy);
+CONFIGURE_BENCHMARK(ByteShiftLoop);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/compress_copy.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// range(0) bytes of T, each kept with probability range(1) percent
+template <typename T>
+class CompressCopyBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        count = static_cast<size_t>(state.range(0)) / sizeof(T);
+        src.resize(count);
+        for (size_t i = 0; i < count; ++i) src[i] = static_cast<T>(i);
+        mask.assign((count + 7) / 8, 0);
+        std::mt19937 rng(42);
+        std::bernoulli_distribution keep(static_cast<double>(state.range(1)) / 100.0);
+        for (size_t i = 0; i < count; ++i) {
+            if (keep(rng)) mask[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        }
+        dest.assign(count, T{});
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        src.clear();
+        src.shrink_to_fit();
+        dest.clear();
+        dest.shrink_to_fit();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count * sizeof(T)));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count));
+    }
+
+    size_t count = 0;
+    std::vector<T> src;
+    std::vector<uint8_t> mask;
+    std::vector<T> dest;
+};
+
+// === Benchmark Functions ===
+
+#define DEFINE_TYPE(suffix, T) \
+    BENCHMARK_TEMPLATE_DEFINE_F(CompressCopyBenchmark, CompressCopy_##suffix, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            benchmark::DoNotOptimize(omm::compress_copy(dest.data(), src.data(), mask.data(), count)); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    } \
+    /* Baseline: a branch per element on its mask bit */ \
+    BENCHMARK_TEMPLATE_DEFINE_F(CompressCopyBenchmark, ScalarBranchy_##suffix, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            size_t written = 0; \
+            for (size_t i = 0; i < count; ++i) { \
+                if (mask[i / 8] >> (i % 8) & 1) dest[written++] = src[i]; \
+            } \
+            benchmark::DoNotOptimize(written); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    } \
+    /* Baseline: an unconditional store per element, advancing by the mask bit */ \
+    BENCHMARK_TEMPLATE_DEFINE_F(CompressCopyBenchmark, ScalarBranchless_##suffix, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            size_t written = 0; \
+            for (size_t i = 0; i < count; ++i) { \
+                dest[written] = src[i]; \
+                written += mask[i / 8] >> (i % 8) & 1; \
+            } \
+            benchmark::DoNotOptimize(written); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    }
+
+DEFINE_TYPE(U8, uint8_t)
+DEFINE_TYPE(U16, uint16_t)
+DEFINE_TYPE(U32, uint32_t)
+DEFINE_TYPE(U64, uint64_t)
+
+// === Benchmark Configuration ===
+
+// Input bytes from L2-resident to well past the L3, at low, even and high selectivity
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(CompressCopyBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{64 * KB, 4 * MB, 128 * MB}, {10, 50, 90}}) \
+        ->ArgNames({"size", "percent_kept"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+#define CONFIGURE_TYPE(suffix) \
+    CONFIGURE_BENCHMARK(CompressCopy_##suffix); \
+    CONFIGURE_BENCHMARK(ScalarBranchy_##suffix); \
+    CONFIGURE_BENCHMARK(ScalarBranchless_##suffix)
+
+CONFIGURE_TYPE(U8);
+CONFIGURE_TYPE(U16);
+CONFIGURE_TYPE(U32);
+CONFIGURE_TYPE(U64);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,134 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/convert_copy.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// Converts range(0) bytes of From elements into a To buffer
+template <typename From, typename To>
+class ConvertCopyBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        count = static_cast<size_t>(state.range(0)) / sizeof(From);
+        src.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            if constexpr (std::is_same_v<From, float>) src[i] = static_cast<float>(i % 4099) * 0.37f - 700.0f;
+            else if constexpr (std::is_same_v<From, omm::float16>) src[i] = omm::to_float16(static_cast<float>(i % 4099) * 0.37f);
+            else src[i] = static_cast<From>(i * 2654435761u);
+        }
+        dest.assign(count, To{});
+        staging.assign(count, From{});
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        src.clear();
+        src.shrink_to_fit();
+        dest.clear();
+        dest.shrink_to_fit();
+        staging.clear();
+        staging.shrink_to_fit();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(count * sizeof(From)));
+    }
+
+    size_t count = 0;
+    std::vector<From> src;
+    std::vector<To> dest;
+    std::vector<From> staging;
+};
+
+// === Benchmark Functions ===
+
+// Fused: one pass that loads, converts and stores
+#define DEFINE_CONVERT_COPY(name, From, To) \
+    BENCHMARK_TEMPLATE_DEFINE_F(ConvertCopyBenchmark, name, From, To)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            omm::convert_copy(dest.data(), src.data(), count); \
+            benchmark::DoNotOptimize(dest.data()); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    }
+
+// Baseline: memcpy into a staging buffer, then a separate conversion pass over it
+#define DEFINE_COPY_THEN_CONVERT(name, From, To) \
+    BENCHMARK_TEMPLATE_DEFINE_F(ConvertCopyBenchmark, name, From, To)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            std::memcpy(staging.data(), src.data(), count * sizeof(From)); \
+            omm::detail::convert_copy_generic(dest.data(), staging.data(), count); \
+            benchmark::DoNotOptimize(dest.data()); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    }
+
+// Reference: omm::memcpy of the same source bytes, with no conversion
+#define DEFINE_PLAIN_COPY(name, From, To) \
+    BENCHMARK_TEMPLATE_DEFINE_F(ConvertCopyBenchmark, name, From, To)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            omm::memcpy(staging.data(), src.data(), count * sizeof(From)); \
+            benchmark::DoNotOptimize(staging.data()); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    }
+
+#define DEFINE_PAIR(suffix, From, To) \
+    DEFINE_CONVERT_COPY(ConvertCopy_##suffix, From, To) \
+    DEFINE_COPY_THEN_CONVERT(CopyThenConvert_##suffix, From, To) \
+    DEFINE_PLAIN_COPY(PlainCopy_##suffix, From, To)
+
+DEFINE_PAIR(F32ToF16, float, omm::float16)
+DEFINE_PAIR(F16ToF32, omm::float16, float)
+DEFINE_PAIR(F32ToBF16, float, omm::bfloat16)
+DEFINE_PAIR(I32ToI8, int32_t, int8_t)
+DEFINE_PAIR(I16ToI64, int16_t, int64_t)
+
+// === Benchmark Configuration ===
+
+// Source sizes in bytes, from L1-resident to well past the L3
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(ConvertCopyBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{4 * KB, 64 * KB, 1 * MB, 16 * MB, 64 * MB}}) \
+        ->ArgNames({"size"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+#define CONFIGURE_PAIR(suffix) \
+    CONFIGURE_BENCHMARK(ConvertCopy_##suffix); \
+    CONFIGURE_BENCHMARK(CopyThenConvert_##suffix); \
+    CONFIGURE_BENCHMARK(PlainCopy_##suffix)
+
+CONFIGURE_PAIR(F32ToF16);
+CONFIGURE_PAIR(F16ToF32);
+CONFIGURE_PAIR(F32ToBF16);
+CONFIGURE_PAIR(I32ToI8);
+CONFIGURE_PAIR(I16ToI64);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/copy_cost.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+
+// === Benchmark Fixture ===
+
+// Copies range(0) bytes split across range(1) threads, each helper started per copy as the
+// cost model assumes, and reports the estimate for the copy next to the measured time.
+// The threads are not pinned: helpers inherit the affinity of the thread that starts them.
+class CopyCostBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        bytes = static_cast<size_t>(state.range(0));
+        threads = static_cast<unsigned>(state.range(1));
+        src.assign(bytes, 0x5A);
+        dest.assign(bytes, 0);
+    }
+
+    void TearDown(const benchmark::State&) override {
+        src.clear();
+        src.shrink_to_fit();
+        dest.clear();
+        dest.shrink_to_fit();
+    }
+
+protected:
+    template <typename Copy>
+    void run(benchmark::State& state, omm::copy_kernel kernel, Copy copy) {
+        const size_t share = (bytes / threads + 63) & ~size_t{63};
+        double total_ns = 0;
+        for (auto _ : state) {
+            const auto start = std::chrono::steady_clock::now();
+            std::vector<std::thread> helpers;
+            for (size_t begin = share; begin < bytes && helpers.size() + 1 < threads; begin += share) {
+                helpers.emplace_back([=, this] { copy(dest.data() + begin, src.data() + begin, std::min(share, bytes - begin)); });
+            }
+            copy(dest.data(), src.data(), std::min(share, bytes));
+            for (auto& helper : helpers) helper.join();
+            const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+            benchmark::DoNotOptimize(dest.data());
+            benchmark::ClobberMemory();
+            state.SetIterationTime(elapsed.count() * 1e-9);
+            total_ns += elapsed.count();
+        }
+
+        const double measured = total_ns / static_cast<double>(state.iterations());
+        const double estimate = omm::estimate_copy_ns(bytes, {kernel, false}, threads);
+        state.counters["measured_ns"] = measured;
+        state.counters["estimate_ns"] = estimate;
+        state.counters["error_pct"] = 100.0 * (estimate - measured) / measured;
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes));
+    }
+
+    size_t bytes = 0;
+    unsigned threads = 1;
+    std::vector<uint8_t> src;
+    std::vector<uint8_t> dest;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(CopyCostBenchmark, Automatic)(benchmark::State& state) {
+    run(state, omm::copy_kernel::automatic, [](void* d, const void* s, size_t n) { omm::memcpy(d, s, n); });
+}
+
+BENCHMARK_DEFINE_F(CopyCostBenchmark, Temporal)(benchmark::State& state) {
+    run(state, omm::copy_kernel::temporal, [](void* d, const void* s, size_t n) { omm::detail::copy_temporal(d, s, n); });
+}
+
+BENCHMARK_DEFINE_F(CopyCostBenchmark, Streaming)(benchmark::State& state) {
+    run(state, omm::copy_kernel::streaming, [](void* d, const void* s, size_t n) { omm::detail::copy_streaming(d, s, n); });
+}
+
+// === Benchmark Configuration ===
+
+// Sizes from the L1 to DRAM, copied by one thread or split across several
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(CopyCostBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{4 * KB, 64 * KB, 1 * MB, 16 * MB, 256 * MB}, {1, 2, 4}}) \
+        ->ArgNames({"bytes", "threads"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseManualTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(Automatic);
+CONFIGURE_BENCHMARK(Temporal);
+CONFIGURE_BENCHMARK(Streaming);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    // Calibrate before the first benchmark, and show what the estimates are built from
+    const auto& calibration = omm::detail::host_copy_calibration();
+    static const char* const TIERS[] = {"L1", "L2", "L3", "DRAM"};
+    for (size_t tier = 0; tier < omm::MEMORY_TIERS; ++tier) {
+        std::printf("%-4s latency %7.1f ns, bandwidth %6.2f GB/s, streaming %6.2f GB/s\n", TIERS[tier], calibration.latency_ns[tier],
+                    calibration.bandwidth[tier], calibration.stream_bandwidth[tier]);
+    }
+    std::printf("DRAM peak %.2f GB/s on %u threads, thread start %.0f ns\n",
+                calibration.dram_peak_bandwidth, calibration.hardware_threads, calibration.thread_start_ns);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/copy_job.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t COPY_SIZE = 1024 * MB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+class CopyJobBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State&) override {
+        src.assign(COPY_SIZE, 1);
+        dest.assign(COPY_SIZE, 0);
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        src.clear();
+        dest.clear();
+    }
+
+protected:
+    // Records p50, p99 and max slice latency in microseconds
+    static void report_latencies(benchmark::State& state, std::vector<double>& latencies) {
+        if (latencies.empty()) return;
+        std::sort(latencies.begin(), latencies.end());
+        state.counters["slices"] = static_cast<double>(latencies.size());
+        state.counters["p50_us"] = latencies[latencies.size() / 2];
+        state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+        state.counters["max_us"] = latencies.back();
+    }
+
+    std::vector<char> src;
+    std::vector<char> dest;
+};
+
+// === Benchmark Functions ===
+
+// Copies the whole buffer in time slices of range(0) microseconds and records how long each slice took
+BENCHMARK_DEFINE_F(CopyJobBenchmark, TimeSlices)(benchmark::State& state) {
+    const std::chrono::microseconds budget(state.range(0));
+    std::vector<double> latencies;
+
+    for (auto _ : state) {
+        omm::copy_job job(dest.data(), src.data(), COPY_SIZE);
+        bool done = false;
+        while (!done) {
+            const auto t0 = std::chrono::steady_clock::now();
+            done = job.step(budget);
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+        }
+        benchmark::ClobberMemory();
+    }
+
+    report_latencies(state, latencies);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * COPY_SIZE);
+}
+
+// Copies the whole buffer in byte slices of range(0) KiB
+BENCHMARK_DEFINE_F(CopyJobBenchmark, ByteSlices)(benchmark::State& state) {
+    const size_t slice = static_cast<size_t>(state.range(0)) * KB;
+    std::vector<double> latencies;
+
+    for (auto _ : state) {
+        omm::copy_job job(dest.data(), src.data(), COPY_SIZE);
+        bool done = false;
+        while (!done) {
+            const auto t0 = std::chrono::steady_clock::now();
+            done = job.step(slice);
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+        }
+        benchmark::ClobberMemory();
+    }
+
+    report_latencies(state, latencies);
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * COPY_SIZE);
+}
+
+// Baseline: the same copy in a single non-preemptible call
+BENCHMARK_DEFINE_F(CopyJobBenchmark, Unsliced)(benchmark::State& state) {
+    for (auto _ : state) {
+        omm::memcpy(dest.data(), src.data(), COPY_SIZE);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * COPY_SIZE);
+}
+
+// === Benchmark Configuration ===
+
+#define CONFIGURE_BENCHMARK(name, args, arg_name) \
+    BENCHMARK_REGISTER_F(CopyJobBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({args}) \
+        ->ArgNames({arg_name}) \
+        ->Repetitions(REPETITIONS) \
+        ->Unit(benchmark::kMillisecond) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+// Budgets in microseconds
+CONFIGURE_BENCHMARK(TimeSlices, benchmark::CreateRange(10, 10000, 10), "budget_us");
+// Slice sizes in KiB
+CONFIGURE_BENCHMARK(ByteSlices, benchmark::CreateRange(64, 64 * KB, 8), "slice_kb");
+
+BENCHMARK_REGISTER_F(CopyJobBenchmark, Unsliced)
+        ->Name(omm::benchmark::GetColoredBenchmarkName("Unsliced"))
+        ->Repetitions(REPETITIONS)
+        ->Unit(benchmark::kMillisecond)
+        ->UseRealTime()
+        ->ReportAggregatesOnly(true);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
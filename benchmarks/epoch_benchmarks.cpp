@@ -0,0 +1,156 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/epoch.h"
+
+// === Constants ===
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int WRITER_CPU = 0;
+constexpr size_t BLOCK_SIZE = 256;  // Bytes of each retired block
+
+// === Benchmark Fixture ===
+
+// Read-side overhead: the benchmark threads read a shared block while it is protected by
+// an epoch pin, a shared reference count, or nothing
+class EpochReadBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+        domain = std::make_unique<omm::epoch>();
+        value = 1;
+        references = 0;
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+        domain.reset();
+    }
+
+protected:
+    std::unique_ptr<omm::epoch> domain;
+    alignas(64) std::atomic<uint64_t> value{1};
+    alignas(64) std::atomic<int64_t> references{0};
+};
+
+// Reclamation latency: one writer retires a block and waits for it to be reclaimed while
+// range(0) reader threads pin the domain back to back
+class EpochReclaimBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        domain = std::make_unique<omm::epoch>();
+        stop = false;
+        const auto count = static_cast<size_t>(state.range(0));
+        for (size_t r = 0; r < count; ++r) {
+            readers.emplace_back([this] {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto guard = domain->pin();
+                    benchmark::DoNotOptimize(guard.pinned_epoch());
+                }
+            });
+        }
+        omm::benchmark::PinToCore(WRITER_CPU);
+    }
+
+    void TearDown(const benchmark::State&) override {
+        stop = true;
+        for (auto& reader : readers) reader.join();
+        readers.clear();
+        domain.reset();
+    }
+
+protected:
+    std::unique_ptr<omm::epoch> domain;
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> readers;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(EpochReadBenchmark, EpochPin)(benchmark::State& state) {
+    for (auto _ : state) {
+        auto guard = domain->pin();
+        benchmark::DoNotOptimize(value.load(std::memory_order_acquire));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Baseline: every reader increments and decrements one shared count, so its cache line
+// moves between cores on every read
+BENCHMARK_DEFINE_F(EpochReadBenchmark, SharedRefcount)(benchmark::State& state) {
+    for (auto _ : state) {
+        references.fetch_add(1, std::memory_order_acquire);
+        benchmark::DoNotOptimize(value.load(std::memory_order_acquire));
+        references.fetch_sub(1, std::memory_order_release);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Ceiling: the read alone
+BENCHMARK_DEFINE_F(EpochReadBenchmark, Unprotected)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(value.load(std::memory_order_acquire));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Time from retiring a block to its reclamation
+BENCHMARK_DEFINE_F(EpochReclaimBenchmark, RetireSynchronize)(benchmark::State& state) {
+    for (auto _ : state) {
+        domain->retire(std::malloc(BLOCK_SIZE), BLOCK_SIZE);
+        domain->synchronize();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Amortized cost of retiring with batched reclamation
+BENCHMARK_DEFINE_F(EpochReclaimBenchmark, Retire)(benchmark::State& state) {
+    for (auto _ : state) {
+        domain->retire(std::malloc(BLOCK_SIZE), BLOCK_SIZE);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["pending"] = static_cast<double>(domain->pending());
+}
+
+// === Benchmark Configuration ===
+
+// 1 to 64 reader threads
+#define CONFIGURE_READ_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(EpochReadBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ThreadRange(1, 64) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+// 0 to 64 background reader threads
+#define CONFIGURE_RECLAIM_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(EpochReclaimBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{0, 1, 4, 16, 64}}) \
+        ->ArgNames({"readers"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_READ_BENCHMARK(EpochPin);
+CONFIGURE_READ_BENCHMARK(SharedRefcount);
+CONFIGURE_READ_BENCHMARK(Unprotected);
+CONFIGURE_RECLAIM_BENCHMARK(RetireSynchronize);
+CONFIGURE_RECLAIM_BENCHMARK(Retire);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
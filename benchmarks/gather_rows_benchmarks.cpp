@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/gather_rows.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t ROWS_COPIED = 1 << 20;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// Copies ROWS_COPIED rows of range(0) bytes at random indices into a table of range(1) bytes
+class GatherRowsBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        row_width = static_cast<size_t>(state.range(0));
+        const size_t rows = static_cast<size_t>(state.range(1)) / row_width;
+        table.assign(rows * row_width, 0x5A);
+        rows_buffer.assign(ROWS_COPIED * row_width, 0);
+        std::mt19937 rng(42);
+        indices.resize(ROWS_COPIED);
+        for (auto& index : indices) index = static_cast<uint32_t>(rng() % rows);
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        table.clear();
+        table.shrink_to_fit();
+        rows_buffer.clear();
+        rows_buffer.shrink_to_fit();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(ROWS_COPIED * row_width));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(ROWS_COPIED));
+    }
+
+    size_t row_width = 0;
+    std::vector<uint8_t> table;
+    std::vector<uint8_t> rows_buffer;
+    std::vector<uint32_t> indices;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(GatherRowsBenchmark, GatherRows)(benchmark::State& state) {
+    for (auto _ : state) {
+        omm::gather_rows(rows_buffer.data(), table.data(), row_width, indices.data(), ROWS_COPIED);
+        benchmark::DoNotOptimize(rows_buffer.data());
+        benchmark::ClobberMemory();
+    }
+    report(state);
+}
+
+// Baseline: one memcpy per row, relying on the hardware prefetchers
+BENCHMARK_DEFINE_F(GatherRowsBenchmark, GatherMemcpyLoop)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (size_t i = 0; i < ROWS_COPIED; ++i) {
+            std::memcpy(rows_buffer.data() + i * row_width, table.data() + indices[i] * row_width, row_width);
+        }
+        benchmark::DoNotOptimize(rows_buffer.data());
+        benchmark::ClobberMemory();
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(GatherRowsBenchmark, ScatterRows)(benchmark::State& state) {
+    for (auto _ : state) {
+        omm::scatter_rows(table.data(), rows_buffer.data(), row_width, indices.data(), ROWS_COPIED);
+        benchmark::DoNotOptimize(table.data());
+        benchmark::ClobberMemory();
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(GatherRowsBenchmark, ScatterMemcpyLoop)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (size_t i = 0; i < ROWS_COPIED; ++i) {
+            std::memcpy(table.data() + indices[i] * row_width, rows_buffer.data() + i * row_width, row_width);
+        }
+        benchmark::DoNotOptimize(table.data());
+        benchmark::ClobberMemory();
+    }
+    report(state);
+}
+
+// === Benchmark Configuration ===
+
+// Row widths, with a table that fits the L2, one that fits the L3 and one in DRAM
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(GatherRowsBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{8, 16, 32, 64, 128}, {512 * KB, 16 * MB, 1024 * MB}}) \
+        ->ArgNames({"row_width", "table"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(GatherRows);
+CONFIGURE_BENCHMARK(GatherMemcpyLoop);
+CONFIGURE_BENCHMARK(ScatterRows);
+CONFIGURE_BENCHMARK(ScatterMemcpyLoop);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/interleave.h"
+#include "omm/memcpy.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// range(0) bytes of samples, split across Channels planes of T
+template <size_t Channels, typename T>
+class InterleaveBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        frames = static_cast<size_t>(state.range(0)) / (Channels * sizeof(T));
+        planes.assign(Channels, std::vector<T>(frames));
+        for (size_t c = 0; c < Channels; ++c) {
+            for (size_t i = 0; i < frames; ++i) planes[c][i] = static_cast<T>(i * Channels + c);
+            sources[c] = planes[c].data();
+            targets[c] = planes[c].data();
+        }
+        packed.assign(frames * Channels, T{});
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        planes.clear();
+        planes.shrink_to_fit();
+        packed.clear();
+        packed.shrink_to_fit();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(frames * Channels * sizeof(T)));
+    }
+
+    size_t frames = 0;
+    std::vector<std::vector<T>> planes;
+    std::vector<T> packed;
+    const T* sources[Channels] = {};
+    T* targets[Channels] = {};
+};
+
+// === Benchmark Functions ===
+
+#define DEFINE_SHAPE(suffix, Channels, T) \
+    BENCHMARK_TEMPLATE_DEFINE_F(InterleaveBenchmark, Interleave_##suffix, Channels, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            omm::interleave<Channels>(packed.data(), sources, frames); \
+            benchmark::DoNotOptimize(packed.data()); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    } \
+    BENCHMARK_TEMPLATE_DEFINE_F(InterleaveBenchmark, Deinterleave_##suffix, Channels, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            omm::deinterleave<Channels>(targets, packed.data(), frames); \
+            benchmark::DoNotOptimize(targets); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    } \
+    /* Baseline: the scalar frame loop */ \
+    BENCHMARK_TEMPLATE_DEFINE_F(InterleaveBenchmark, ScalarInterleave_##suffix, Channels, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            omm::detail::interleave_generic<Channels>(packed.data(), sources, frames); \
+            benchmark::DoNotOptimize(packed.data()); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    } \
+    BENCHMARK_TEMPLATE_DEFINE_F(InterleaveBenchmark, ScalarDeinterleave_##suffix, Channels, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            omm::detail::deinterleave_generic<Channels>(targets, packed.data(), frames); \
+            benchmark::DoNotOptimize(targets); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    } \
+    /* Ceiling: omm::memcpy of the same bytes, plane by plane */ \
+    BENCHMARK_TEMPLATE_DEFINE_F(InterleaveBenchmark, Memcpy_##suffix, Channels, T)(benchmark::State& state) { \
+        for (auto _ : state) { \
+            for (size_t c = 0; c < Channels; ++c) { \
+                omm::memcpy(packed.data() + c * frames, sources[c], frames * sizeof(T)); \
+            } \
+            benchmark::DoNotOptimize(packed.data()); \
+            benchmark::ClobberMemory(); \
+        } \
+        report(state); \
+    }
+
+DEFINE_SHAPE(Stereo_F32, 2, float)
+DEFINE_SHAPE(Rgb_U8, 3, uint8_t)
+DEFINE_SHAPE(Surround_I16, 6, int16_t)
+DEFINE_SHAPE(Octo_U8, 8, uint8_t)
+
+// === Benchmark Configuration ===
+
+// Total sample bytes, from L1-resident to well past the L3
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(InterleaveBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{4 * KB, 64 * KB, 1 * MB, 16 * MB, 64 * MB}}) \
+        ->ArgNames({"size"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+#define CONFIGURE_SHAPE(suffix) \
+    CONFIGURE_BENCHMARK(Interleave_##suffix); \
+    CONFIGURE_BENCHMARK(Deinterleave_##suffix); \
+    CONFIGURE_BENCHMARK(ScalarInterleave_##suffix); \
+    CONFIGURE_BENCHMARK(ScalarDeinterleave_##suffix); \
+    CONFIGURE_BENCHMARK(Memcpy_##suffix)
+
+CONFIGURE_SHAPE(Stereo_F32);
+CONFIGURE_SHAPE(Rgb_U8);
+CONFIGURE_SHAPE(Surround_I16);
+CONFIGURE_SHAPE(Octo_U8);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <sys/uio.h>
+#include "benchmark_utils.h"
+#include "omm/iobuf.h"
+#include "omm/memcpy.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t HEADER_SIZE = 64;
+constexpr size_t FRAME_SIZE = 16 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// Each iteration runs one message of range(0) bytes through a pipeline: receive the
+// payload, prepend a header, cut it into FRAME_SIZE frames, and hand every frame to
+// the output stage
+class IobufBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        payload.assign(static_cast<size_t>(state.range(0)), 1);
+        header.assign(HEADER_SIZE, 2);
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        payload.clear();
+        header.clear();
+    }
+
+protected:
+    std::vector<uint8_t> payload;
+    std::vector<uint8_t> header;
+};
+
+// === Benchmark Functions ===
+
+// Frames leave as iovecs, as for writev: the payload is copied once, on receipt
+BENCHMARK_DEFINE_F(IobufBenchmark, ZeroCopy)(benchmark::State& state) {
+    for (auto _ : state) {
+        omm::iobuf message(payload.data(), payload.size());
+        message.prepend(omm::iobuf(header.data(), header.size()));
+
+        size_t sent = 0;
+        while (!message.empty()) {
+            const omm::iobuf frame = message.split(FRAME_SIZE);
+            for (const iovec& slice : frame.iovecs()) sent += slice.iov_len;
+        }
+        benchmark::DoNotOptimize(sent);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(payload.size()));
+}
+
+// Frames are coalesced before output, for consumers that need contiguous bytes
+BENCHMARK_DEFINE_F(IobufBenchmark, Coalesced)(benchmark::State& state) {
+    for (auto _ : state) {
+        omm::iobuf message(payload.data(), payload.size());
+        message.prepend(omm::iobuf(header.data(), header.size()));
+
+        while (!message.empty()) {
+            omm::iobuf frame = message.split(FRAME_SIZE);
+            benchmark::DoNotOptimize(frame.coalesce());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(payload.size()));
+}
+
+// Baseline: contiguous buffers, materialized with omm::memcpy at every stage
+BENCHMARK_DEFINE_F(IobufBenchmark, MaterializedCopies)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<uint8_t> received(payload.size());
+        omm::memcpy(received.data(), payload.data(), payload.size());
+
+        std::vector<uint8_t> message(header.size() + received.size());
+        omm::memcpy(message.data(), header.data(), header.size());
+        omm::memcpy(message.data() + header.size(), received.data(), received.size());
+
+        std::vector<uint8_t> frame(FRAME_SIZE);
+        for (size_t offset = 0; offset < message.size(); offset += FRAME_SIZE) {
+            const size_t size = std::min(FRAME_SIZE, message.size() - offset);
+            omm::memcpy(frame.data(), message.data() + offset, size);
+            benchmark::DoNotOptimize(frame.data());
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(payload.size()));
+}
+
+// === Benchmark Configuration ===
+
+// Message sizes in bytes
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(IobufBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{4 * KB, 64 * KB, 1 * MB, 16 * MB}}) \
+        ->ArgNames({"size"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(ZeroCopy);
+CONFIGURE_BENCHMARK(Coalesced);
+CONFIGURE_BENCHMARK(MaterializedCopies);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/is_zero.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// Scans an all-zero buffer of range(0) bytes, the worst case for an early-exit scan
+class IsZeroBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        data.assign(static_cast<size_t>(state.range(0)), 0);
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        data.clear();
+        data.shrink_to_fit();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(data.size()));
+    }
+
+    std::vector<uint8_t> data;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(IsZeroBenchmark, IsZero)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(omm::is_zero(data.data(), data.size()));
+    }
+    report(state);
+}
+
+// Search with the only non-zero byte in the last position
+BENCHMARK_DEFINE_F(IsZeroBenchmark, FindFirstNonzero)(benchmark::State& state) {
+    data.back() = 1;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(omm::find_first_nonzero(data.data(), data.size()));
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(IsZeroBenchmark, IsZeroParallel)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(omm::is_zero_parallel(data.data(), data.size()));
+    }
+    report(state);
+}
+
+// Baseline: portable 8-byte OR-reduction
+BENCHMARK_DEFINE_F(IsZeroBenchmark, GenericWords)(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(omm::detail::is_zero_generic(data.data(), data.size()));
+    }
+    report(state);
+}
+
+// Baseline: memcmp against a zero buffer of the same size
+BENCHMARK_DEFINE_F(IsZeroBenchmark, MemcmpZeroBuffer)(benchmark::State& state) {
+    const std::vector<uint8_t> zeros(data.size(), 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::memcmp(data.data(), zeros.data(), data.size()) == 0);
+    }
+    report(state);
+}
+
+// === Benchmark Configuration ===
+
+// Buffer sizes in bytes, from L1-resident to DRAM-sized
+#define CONFIGURE_BENCHMARK(name, ...) \
+    BENCHMARK_REGISTER_F(IsZeroBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{__VA_ARGS__}}) \
+        ->ArgNames({"size"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(IsZero, 4 * KB, 64 * KB, 1 * MB, 64 * MB);
+CONFIGURE_BENCHMARK(FindFirstNonzero, 4 * KB, 64 * KB, 1 * MB, 64 * MB);
+CONFIGURE_BENCHMARK(IsZeroParallel, 256 * MB);
+CONFIGURE_BENCHMARK(GenericWords, 4 * KB, 64 * KB, 1 * MB, 64 * MB);
+CONFIGURE_BENCHMARK(MemcmpZeroBuffer, 4 * KB, 64 * KB, 1 * MB, 64 * MB);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
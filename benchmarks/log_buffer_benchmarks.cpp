@@ -0,0 +1,135 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/log_buffer.h"
+#include "omm/detail/tsc.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t SEGMENT_SIZE = 1 * MB;
+constexpr size_t SEGMENT_COUNT = 8;
+
+constexpr uint16_t REPETITIONS = 3;
+
+// === Benchmark Fixture ===
+
+// The benchmark threads append range(0)-byte records while one flusher thread takes
+// completed segments and hands them back
+class LogBufferBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+
+        log = std::make_unique<omm::log_buffer>(SEGMENT_SIZE, SEGMENT_COUNT);
+        flushed = 0;
+        stop = false;
+        flusher = std::thread([this] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (auto segment = log->poll()) {
+                    flushed.fetch_add(segment->size, std::memory_order_relaxed);
+                    log->release(*segment);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        // Baseline log: one locked ring with the same footprint, wrapped in place when full
+        locked_segment.assign(SEGMENT_SIZE * SEGMENT_COUNT, 0);
+        locked_used = 0;
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+        stop = true;
+        if (flusher.joinable()) flusher.join();
+        log.reset();
+    }
+
+protected:
+    // Times each append and reports appends/s and the p50 and p99 latency per thread
+    template <typename Append>
+    void run(benchmark::State& state, Append append) {
+        const size_t size = static_cast<size_t>(state.range(0));
+        std::vector<uint8_t> record(size, static_cast<uint8_t>(state.thread_index()));
+        std::vector<uint64_t> ticks;
+        ticks.reserve(1 << 20);
+
+        for (auto _ : state) {
+            const uint64_t t0 = omm::detail::read_tsc();
+            append(record.data(), size);
+            const uint64_t t1 = omm::detail::read_tsc();
+            if (ticks.size() < ticks.capacity()) ticks.push_back(t1 - t0);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+        if (ticks.empty()) return;
+        std::sort(ticks.begin(), ticks.end());
+        const double ticks_per_ns = omm::detail::tsc_ticks_per_ns();
+        state.counters["p50_ns"] = benchmark::Counter(ticks[ticks.size() / 2] / ticks_per_ns, benchmark::Counter::kAvgThreads);
+        state.counters["p99_ns"] = benchmark::Counter(ticks[ticks.size() * 99 / 100] / ticks_per_ns, benchmark::Counter::kAvgThreads);
+    }
+
+    std::unique_ptr<omm::log_buffer> log;
+    std::atomic<size_t> flushed{0};
+    std::atomic<bool> stop{false};
+    std::thread flusher;
+
+    std::mutex locked_mutex;
+    std::vector<uint8_t> locked_segment;
+    size_t locked_used = 0;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(LogBufferBenchmark, LogBufferAppend)(benchmark::State& state) {
+    run(state, [this](const void* record, size_t n) { log->append(record, n); });
+}
+
+// Baseline: a mutex around a memcpy into a ring of the same size as the log
+BENCHMARK_DEFINE_F(LogBufferBenchmark, MutexAppend)(benchmark::State& state) {
+    run(state, [this](const void* record, size_t n) {
+        std::lock_guard lock(locked_mutex);
+        if (locked_used + n > locked_segment.size()) locked_used = 0;
+        std::memcpy(locked_segment.data() + locked_used, record, n);
+        locked_used += n;
+    });
+}
+
+// === Benchmark Configuration ===
+
+// Record sizes in bytes, below and above the streaming threshold, from 1 to 64 producer threads
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(LogBufferBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{64, 256, 8 * KB}}) \
+        ->ArgNames({"size"}) \
+        ->ThreadRange(1, 64) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(LogBufferAppend);
+CONFIGURE_BENCHMARK(MutexAppend);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <cstring>
+#include <string.h>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/memchr.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// Delimiters of a CSV-like record scan
+constexpr const char* DELIMITERS = ",;\t\r\n\"";
+
+// === Benchmark Fixture ===
+
+// Haystack of range(0) bytes with the only hit in the last position (first for memrchr)
+class MemchrBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        data.assign(static_cast<size_t>(state.range(0)), 'a');
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        data.clear();
+        data.shrink_to_fit();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(data.size()));
+    }
+
+    std::vector<uint8_t> data;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(MemchrBenchmark, Memchr)(benchmark::State& state) {
+    data.back() = 'x';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(omm::memchr(data.data(), 'x', data.size()));
+    }
+    report(state);
+}
+
+// Baseline: glibc memchr
+BENCHMARK_DEFINE_F(MemchrBenchmark, GlibcMemchr)(benchmark::State& state) {
+    data.back() = 'x';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::memchr(data.data(), 'x', data.size()));
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(MemchrBenchmark, Memrchr)(benchmark::State& state) {
+    data.front() = 'x';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(omm::memrchr(data.data(), 'x', data.size()));
+    }
+    report(state);
+}
+
+// Baseline: glibc memrchr
+BENCHMARK_DEFINE_F(MemchrBenchmark, GlibcMemrchr)(benchmark::State& state) {
+    data.front() = 'x';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(::memrchr(data.data(), 'x', data.size()));
+    }
+    report(state);
+}
+
+BENCHMARK_DEFINE_F(MemchrBenchmark, FindAnyOf)(benchmark::State& state) {
+    const omm::byte_set delimiters(DELIMITERS);
+    data.back() = '\n';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(omm::find_any_of(data.data(), data.size(), delimiters));
+    }
+    report(state);
+}
+
+// Baseline: glibc strcspn over the NUL-terminated haystack
+BENCHMARK_DEFINE_F(MemchrBenchmark, GlibcStrcspn)(benchmark::State& state) {
+    data.back() = 0;
+    data[data.size() - 2] = '\n';
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(std::strcspn(reinterpret_cast<const char*>(data.data()), DELIMITERS));
+    }
+    report(state);
+}
+
+// === Benchmark Configuration ===
+
+// Short, medium and long haystacks, from a single token to a DRAM-sized buffer
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(MemchrBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{16, 64, 4 * KB, 64 * KB, 1 * MB, 64 * MB}}) \
+        ->ArgNames({"size"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(Memchr);
+CONFIGURE_BENCHMARK(GlibcMemchr);
+CONFIGURE_BENCHMARK(Memrchr);
+CONFIGURE_BENCHMARK(GlibcMemrchr);
+CONFIGURE_BENCHMARK(FindAnyOf);
+CONFIGURE_BENCHMARK(GlibcStrcspn);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
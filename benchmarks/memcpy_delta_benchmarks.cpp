@@ -0,0 +1,131 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/memcpy.h"
+#include "omm/memcpy_delta.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t MIN_ALLOCATION = 64 * KB;
+constexpr size_t MAX_ALLOCATION = 256 * MB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU_NUM = 0;
+
+// === Benchmark Fixture ===
+
+// Two source versions differ in a given per-mille of their 64-byte lines. Each
+// iteration copies the other version into dest, so every copy sees exactly that
+// change rate.
+class MemcpyDeltaBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        size = state.range(0);
+        const auto change_permille = static_cast<size_t>(state.range(1));
+
+        versions[0].assign(size, 1);
+        versions[1] = versions[0];
+        dest = versions[0];
+        bitmap.assign(omm::dirty_bitmap_words(size), 0);
+
+        std::mt19937 gen{42};
+        std::uniform_int_distribution<size_t> dis(0, 999);
+        for (size_t offset = 0; offset < size; offset += omm::DELTA_LINE_SIZE) {
+            if (dis(gen) < change_permille) versions[1][offset] = 2;
+        }
+
+        omm::benchmark::PinToCore(CPU_NUM);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        versions[0].clear();
+        versions[1].clear();
+        dest.clear();
+    }
+
+protected:
+    size_t size{0};
+    std::vector<char> versions[2];
+    std::vector<char> dest;
+    std::vector<std::uint64_t> bitmap;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(MemcpyDeltaBenchmark, StandardMemcpy)(benchmark::State& state) {
+    size_t version = 0;
+    for (auto _ : state) {
+        version ^= 1;
+        std::memcpy(dest.data(), versions[version].data(), size);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+BENCHMARK_DEFINE_F(MemcpyDeltaBenchmark, OMM_Memcpy)(benchmark::State& state) {
+    size_t version = 0;
+    for (auto _ : state) {
+        version ^= 1;
+        omm::memcpy(dest.data(), versions[version].data(), size);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+BENCHMARK_DEFINE_F(MemcpyDeltaBenchmark, OMM_MemcpyDelta)(benchmark::State& state) {
+    size_t version = 0;
+    size_t changed = 0;
+    for (auto _ : state) {
+        version ^= 1;
+        changed = omm::memcpy_delta(dest.data(), versions[version].data(), size, bitmap.data());
+        benchmark::DoNotOptimize(changed);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+    state.counters["changed_lines"] = static_cast<double>(changed);
+}
+
+// === Benchmark Configuration ===
+
+std::vector<int64_t> BenchmarkRange() {
+    std::vector<int64_t> range;
+    for (int64_t size = MIN_ALLOCATION; size <= int64_t(MAX_ALLOCATION); size *= 8) {
+        range.push_back(size);
+    }
+    return range;
+}
+
+// Change rate in lines per mille: 0%, 0.1%, 1%, 5%, 25%, 100%
+std::vector<int64_t> ChangeRates() {
+    return {0, 1, 10, 50, 250, 1000};
+}
+
+#define CONFIGURE_BENCHMARK(func_name) \
+    BENCHMARK_REGISTER_F(MemcpyDeltaBenchmark, func_name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#func_name)) \
+        ->ArgsProduct({BenchmarkRange(), ChangeRates()}) \
+        ->ArgNames({"size", "permille"}) \
+        ->Repetitions(REPETITIONS) \
+        ->Unit(benchmark::kMicrosecond) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(StandardMemcpy);
+CONFIGURE_BENCHMARK(OMM_Memcpy);
+CONFIGURE_BENCHMARK(OMM_MemcpyDelta);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
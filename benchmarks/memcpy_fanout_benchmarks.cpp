@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/memcpy.h"
+#include "omm/memcpy_fanout.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t MIN_ALLOCATION = 64 * MB;
+constexpr size_t MAX_ALLOCATION = 512 * MB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU_NUM = 0;
+
+// === Benchmark Fixture ===
+
+class MemcpyFanoutBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        size = state.range(0);
+        count = state.range(1);
+        src = new char[size];
+        std::memset(src, 1, size);  // Fill source with 1's
+
+        for (size_t d = 0; d < count; ++d) {
+            // Over-allocate so every destination can share the same 64-byte alignment
+            auto* buffer = new char[size + 64];
+            std::memset(buffer, 0, size + 64);
+            buffers.push_back(buffer);
+            dests.push_back(buffer + ((64 - (reinterpret_cast<std::uintptr_t>(buffer) & 63)) & 63));
+        }
+
+        omm::benchmark::PinToCore(CPU_NUM);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        delete[] src;
+        for (char* buffer : buffers) delete[] buffer;
+        buffers.clear();
+        dests.clear();
+    }
+
+protected:
+    size_t size{0};
+    size_t count{0};
+    char* src{nullptr};
+    std::vector<char*> buffers;
+    std::vector<void*> dests;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(MemcpyFanoutBenchmark, RepeatedMemcpy)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (void* dest : dests) {
+            omm::memcpy(dest, src, size);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size) * int64_t(count));
+}
+
+BENCHMARK_DEFINE_F(MemcpyFanoutBenchmark, OMM_MemcpyFanout)(benchmark::State& state) {
+    for (auto _ : state) {
+        omm::memcpy_fanout(src, size, dests);
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size) * int64_t(count));
+}
+
+// === Benchmark Configuration ===
+
+std::vector<int64_t> BenchmarkRange() {
+    std::vector<int64_t> range;
+    for (int64_t size = MIN_ALLOCATION; size <= int64_t(MAX_ALLOCATION); size *= 2) {
+        range.push_back(size);
+    }
+    return range;
+}
+
+#define CONFIGURE_BENCHMARK(func_name) \
+    BENCHMARK_REGISTER_F(MemcpyFanoutBenchmark, func_name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#func_name)) \
+        ->ArgsProduct({BenchmarkRange(), {1, 2, 4, 8}}) \
+        ->ArgNames({"size", "dests"}) \
+        ->Repetitions(REPETITIONS) \
+        ->Unit(benchmark::kMillisecond) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(RepeatedMemcpy);
+CONFIGURE_BENCHMARK(OMM_MemcpyFanout);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
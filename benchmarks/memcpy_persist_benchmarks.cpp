@@ -0,0 +1,142 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "benchmark_utils.h"
+#include "omm/memcpy_persist.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t MIN_SIZE = 64;
+constexpr size_t MAX_SIZE = 64 * MB;
+constexpr size_t MAPPING_SIZE = 2 * MAX_SIZE;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+// Copies into a shared mapping of a tmpfs file, standing in for a DAX mapping. Successive
+// iterations write at advancing offsets, like appends to a write-ahead log.
+class PersistBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        const size_t size = static_cast<size_t>(state.range(0));
+
+        char path[] = "/dev/shm/omm_persist_bench_XXXXXX";
+        fd = mkstemp(path);
+        if (fd < 0) return;
+        unlink(path);
+        if (ftruncate(fd, MAPPING_SIZE) != 0) return;
+        mapping = static_cast<char*>(mmap(nullptr, MAPPING_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        if (mapping == MAP_FAILED) {
+            mapping = nullptr;
+            return;
+        }
+        std::memset(mapping, 0, MAPPING_SIZE);  // Allocate the tmpfs pages up front
+
+        src.assign(size, 1);
+        offset = 0;
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        if (mapping != nullptr) munmap(mapping, MAPPING_SIZE);
+        if (fd >= 0) close(fd);
+        mapping = nullptr;
+        fd = -1;
+        src.clear();
+    }
+
+protected:
+    // Next write position; wraps so the working set exceeds the cache for large sizes
+    char* next_dest(size_t size) {
+        if (offset + size > MAPPING_SIZE) offset = 0;
+        char* dest = mapping + offset;
+        offset += size;
+        return dest;
+    }
+
+    template <typename PersistCopy>
+    void run(benchmark::State& state, PersistCopy&& persist_copy) {
+        if (mapping == nullptr) {
+            state.SkipWithError("Failed to map tmpfs file");
+            return;
+        }
+        const size_t size = src.size();
+        for (auto _ : state) {
+            persist_copy(next_dest(size), src.data(), size);
+            benchmark::ClobberMemory();
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+    }
+
+    int fd = -1;
+    char* mapping = nullptr;
+    size_t offset = 0;
+    std::vector<char> src;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(PersistBenchmark, MemcpyPersist)(benchmark::State& state) {
+    run(state, [](void* dest, const void* src, size_t n) { omm::memcpy_persist(dest, src, n); });
+}
+
+BENCHMARK_DEFINE_F(PersistBenchmark, MemcpyPersistClflushopt)(benchmark::State& state) {
+    if (!omm::detail::cpu_supports_clflushopt()) {
+        state.SkipWithError("CLFLUSHOPT not supported");
+        return;
+    }
+    run(state, [](void* dest, const void* src, size_t n) {
+        omm::memcpy_persist(dest, src, n, omm::persist_method::clflushopt);
+    });
+}
+
+// Baseline: regular copy, then flush every line
+BENCHMARK_DEFINE_F(PersistBenchmark, MemcpyThenPersist)(benchmark::State& state) {
+    run(state, [](void* dest, const void* src, size_t n) {
+        std::memcpy(dest, src, n);
+        omm::persist(dest, n);
+    });
+}
+
+// Baseline: regular copy, then msync of the covering pages
+BENCHMARK_DEFINE_F(PersistBenchmark, MemcpyMsync)(benchmark::State& state) {
+    run(state, [](void* dest, const void* src, size_t n) {
+        omm::memcpy_persist(dest, src, n, omm::persist_method::msync);
+    });
+}
+
+// === Benchmark Configuration ===
+
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(PersistBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->RangeMultiplier(8) \
+        ->Range(MIN_SIZE, MAX_SIZE) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(MemcpyPersist);
+CONFIGURE_BENCHMARK(MemcpyPersistClflushopt);
+CONFIGURE_BENCHMARK(MemcpyThenPersist);
+CONFIGURE_BENCHMARK(MemcpyMsync);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/memcpy.h"
+#include "omm/memcpy_throttled.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr size_t BACKGROUND_SIZE = 512 * MB;
+constexpr size_t FOREGROUND_SIZE = 256 * MB;
+constexpr size_t FOREGROUND_COPY = 256 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int FOREGROUND_CPU = 0;
+constexpr int BACKGROUND_CPU = 1;
+
+// Background rate argument meaning no background copy at all
+constexpr int64_t NO_BACKGROUND = -1;
+
+// === Benchmark Fixture ===
+
+// A background thread copies a large buffer in a loop at the rate given by range(0),
+// in MB/s (0 = unthrottled). The foreground thread measures the latency of small copies
+// from random offsets in a buffer that does not fit in cache.
+class ThrottledBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        foreground_src.assign(FOREGROUND_SIZE, 1);
+        foreground_dest.assign(FOREGROUND_COPY, 0);
+        background_bytes = 0;
+        stop = false;
+
+        const int64_t rate_mbps = state.range(0);
+        if (rate_mbps != NO_BACKGROUND) {
+            background = std::thread([this, rate_mbps] {
+                omm::benchmark::PinToCore(BACKGROUND_CPU);
+                std::vector<char> src(BACKGROUND_SIZE, 2);
+                std::vector<char> dest(BACKGROUND_SIZE, 0);
+                omm::copy_throttle throttle(static_cast<double>(rate_mbps) * MB);
+                // Copy in slices so the stop flag is observed promptly
+                constexpr size_t SLICE = 16 * MB;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (size_t offset = 0; offset < BACKGROUND_SIZE && !stop.load(std::memory_order_relaxed); offset += SLICE) {
+                        throttle.copy(dest.data() + offset, src.data() + offset, SLICE);
+                        background_bytes.fetch_add(SLICE, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+
+        omm::benchmark::PinToCore(FOREGROUND_CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {
+        stop = true;
+        if (background.joinable()) background.join();
+        foreground_src.clear();
+        foreground_dest.clear();
+    }
+
+protected:
+    std::vector<char> foreground_src;
+    std::vector<char> foreground_dest;
+    std::thread background;
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> background_bytes{0};
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(ThrottledBenchmark, ForegroundLatency)(benchmark::State& state) {
+    std::mt19937_64 gen{42};
+    std::uniform_int_distribution<size_t> dis(0, (FOREGROUND_SIZE - FOREGROUND_COPY) / 64);
+    std::vector<double> latencies;
+
+    const size_t start_bytes = background_bytes.load();
+    const auto start_time = std::chrono::steady_clock::now();
+
+    for (auto _ : state) {
+        const size_t offset = dis(gen) * 64;
+        const auto t0 = std::chrono::steady_clock::now();
+        std::memcpy(foreground_dest.data(), foreground_src.data() + offset, FOREGROUND_COPY);
+        benchmark::ClobberMemory();
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+    }
+
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time).count();
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_us"] = latencies[latencies.size() / 2];
+    state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+    state.counters["background_MBps"] = static_cast<double>(background_bytes.load() - start_bytes) / MB / elapsed;
+}
+
+// === Benchmark Configuration ===
+
+// Background rates in MB/s: none, then increasing throttle limits, then unthrottled
+BENCHMARK_REGISTER_F(ThrottledBenchmark, ForegroundLatency)
+        ->Name(omm::benchmark::GetColoredBenchmarkName("ForegroundLatency"))
+        ->ArgsProduct({{NO_BACKGROUND, 256, 1024, 4096, 0}})
+        ->ArgNames({"background_rate"})
+        ->Repetitions(REPETITIONS)
+        ->MinTime(2.0)
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime()
+        ->ReportAggregatesOnly(true);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
@@ -0,0 +1,133 @@
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include "benchmark_utils.h"
+#include "omm/persistent_arena.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU = 0;
+
+// === Benchmark Fixture ===
+
+struct record {
+    std::uint64_t key;
+    std::uint64_t value;
+};
+
+// Root of the stand-in for a service's in-memory index: a sorted record array
+struct index_root {
+    std::uint64_t count;
+    omm::offset_ptr<record> records;
+};
+
+// Compares restoring a sorted index of range(0) MB by reattaching a /dev/shm arena
+// against rebuilding it from the raw records.
+class ArenaBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        count = static_cast<size_t>(state.range(0)) * MB / sizeof(record);
+        path = "/dev/shm/omm_arena_bench_" + std::to_string(state.range(0));
+
+        // Build the arena once; later attaches reuse it
+        omm::persistent_arena arena(path, count * sizeof(record) + 2 * MB);
+        if (!arena.root<index_root>() || arena.root<index_root>()->count != count) {
+            auto* root = arena.construct<index_root>();
+            auto* records = static_cast<record*>(arena.allocate(count * sizeof(record), alignof(record)));
+            generate(records);
+            std::sort(records, records + count, [](const record& a, const record& b) { return a.key < b.key; });
+            root->count = count;
+            root->records = records;
+            arena.set_root(root);
+            arena.commit();
+        }
+
+        omm::benchmark::PinToCore(CPU);  // Pin to specified CPU core
+    }
+
+    void TearDown(const benchmark::State&) override {}
+
+protected:
+    void generate(record* records) const {
+        std::mt19937_64 gen{42};
+        for (size_t i = 0; i < count; ++i) {
+            records[i] = {gen(), i};
+        }
+    }
+
+    // Looks up one key to show the restored index is usable
+    static std::uint64_t lookup(const record* records, size_t n, std::uint64_t key) {
+        const record* found = std::lower_bound(records, records + n, key,
+                                               [](const record& r, std::uint64_t k) { return r.key < k; });
+        return found == records + n ? 0 : found->value;
+    }
+
+    size_t count = 0;
+    std::string path;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(ArenaBenchmark, Attach)(benchmark::State& state) {
+    const bool prefault = state.range(1) != 0;
+    for (auto _ : state) {
+        omm::persistent_arena arena(path, 0, {.prefault = prefault});
+        const auto* root = arena.root<index_root>();
+        benchmark::DoNotOptimize(lookup(root->records.get(), root->count, 12345));
+    }
+}
+
+// Baseline: regenerate and sort the records, as a service rebuilding its index would
+BENCHMARK_DEFINE_F(ArenaBenchmark, Rebuild)(benchmark::State& state) {
+    for (auto _ : state) {
+        std::vector<record> records(count);
+        generate(records.data());
+        std::sort(records.begin(), records.end(), [](const record& a, const record& b) { return a.key < b.key; });
+        benchmark::DoNotOptimize(lookup(records.data(), count, 12345));
+    }
+}
+
+// === Benchmark Configuration ===
+
+// Index sizes in MB
+BENCHMARK_REGISTER_F(ArenaBenchmark, Attach)
+        ->Name(omm::benchmark::GetColoredBenchmarkName("Attach"))
+        ->ArgsProduct({{16, 128, 1024}, {0, 1}})
+        ->ArgNames({"size_mb", "prefault"})
+        ->Repetitions(REPETITIONS)
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime()
+        ->ReportAggregatesOnly(true);
+
+BENCHMARK_REGISTER_F(ArenaBenchmark, Rebuild)
+        ->Name(omm::benchmark::GetColoredBenchmarkName("Rebuild"))
+        ->ArgsProduct({{16, 128, 1024}})
+        ->ArgNames({"size_mb"})
+        ->Repetitions(REPETITIONS)
+        ->Unit(benchmark::kMicrosecond)
+        ->UseRealTime()
+        ->ReportAggregatesOnly(true);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    // Remove the arena files created by the fixture
+    for (int size_mb : {16, 128, 1024}) {
+        unlink(("/dev/shm/omm_arena_bench_" + std::to_string(size_mb)).c_str());
+    }
+
+    return 0;
+}
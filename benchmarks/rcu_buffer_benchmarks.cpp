@@ -0,0 +1,189 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/rcu_buffer.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int WRITER_CPU = 0;
+constexpr size_t PATCH_SIZE = 4 * KB;  // Bytes changed by each update
+constexpr size_t READ_SIZE = 4 * KB;   // Bytes touched by each read
+
+// === Benchmark Fixture ===
+
+// Publication latency: each update patches PATCH_SIZE bytes of a range(0)-byte table
+class RcuPublishBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        size = static_cast<size_t>(state.range(0));
+        patch = std::vector<uint8_t>(PATCH_SIZE, 0x5A);
+    }
+
+protected:
+    size_t size = 0;
+    std::vector<uint8_t> patch;
+};
+
+// Reader throughput: the benchmark threads read range(0)-byte versions while one writer
+// thread publishes a new version every millisecond
+class RcuReadBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+
+        const size_t size = static_cast<size_t>(state.range(0));
+        buffer = std::make_unique<omm::rcu_buffer>(size);
+        std::memset(buffer->begin_update(), 1, size);
+        buffer->publish(size);
+        shared.assign(size, 1);
+        publishes = 0;
+        stop = false;
+
+        writer = std::thread([this, size] {
+            omm::benchmark::PinToCore(WRITER_CPU);
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto* spare = static_cast<uint8_t*>(buffer->begin_update());
+                buffer->copy_unchanged(PATCH_SIZE, size - PATCH_SIZE);
+                std::memset(spare, static_cast<int>(buffer->version()), PATCH_SIZE);
+                buffer->publish(size);
+
+                {
+                    std::unique_lock lock(shared_mutex);
+                    std::memset(shared.data(), static_cast<int>(buffer->version()), PATCH_SIZE);
+                }
+                publishes.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+        stop = true;
+        if (writer.joinable()) writer.join();
+        buffer.reset();
+    }
+
+protected:
+    void report(benchmark::State& state) {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(READ_SIZE));
+        if (state.thread_index() == 0) {
+            state.counters["publishes"] = benchmark::Counter(static_cast<double>(publishes.load()), benchmark::Counter::kIsRate);
+        }
+    }
+
+    std::unique_ptr<omm::rcu_buffer> buffer;
+    std::vector<uint8_t> shared;
+    std::shared_mutex shared_mutex;
+    std::atomic<size_t> publishes{0};
+    std::atomic<bool> stop{false};
+    std::thread writer;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(RcuPublishBenchmark, RcuPublish)(benchmark::State& state) {
+    omm::rcu_buffer buffer(size);
+    // Fault in both buffers before timing
+    for (int i = 0; i < 2; ++i) {
+        std::memset(buffer.begin_update(), 1, size);
+        buffer.publish(size);
+    }
+
+    for (auto _ : state) {
+        auto* spare = static_cast<uint8_t*>(buffer.begin_update());
+        buffer.copy_unchanged(PATCH_SIZE, size - PATCH_SIZE);
+        std::memcpy(spare, patch.data(), PATCH_SIZE);
+        benchmark::DoNotOptimize(buffer.publish(size));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
+
+// Baseline: patch a copy of the table and memcpy it over the shared one under an exclusive lock
+BENCHMARK_DEFINE_F(RcuPublishBenchmark, LockedMemcpy)(benchmark::State& state) {
+    std::vector<uint8_t> shared(size, 1);
+    std::vector<uint8_t> next(size, 1);
+    std::shared_mutex mutex;
+
+    for (auto _ : state) {
+        std::memcpy(next.data(), patch.data(), PATCH_SIZE);
+        std::unique_lock lock(mutex);
+        std::memcpy(shared.data(), next.data(), size);
+        benchmark::DoNotOptimize(shared.data());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+}
+
+BENCHMARK_DEFINE_F(RcuReadBenchmark, RcuRead)(benchmark::State& state) {
+    uint8_t out[READ_SIZE];
+    for (auto _ : state) {
+        auto guard = buffer->read();
+        std::memcpy(out, guard.data(), READ_SIZE);
+        benchmark::DoNotOptimize(out);
+    }
+    report(state);
+}
+
+// Baseline: readers share a reader-writer lock with the writer's in-place patch
+BENCHMARK_DEFINE_F(RcuReadBenchmark, SharedMutexRead)(benchmark::State& state) {
+    uint8_t out[READ_SIZE];
+    for (auto _ : state) {
+        std::shared_lock lock(shared_mutex);
+        std::memcpy(out, shared.data(), READ_SIZE);
+        benchmark::DoNotOptimize(out);
+    }
+    report(state);
+}
+
+// === Benchmark Configuration ===
+
+// Table sizes in bytes, from L2-resident to DRAM-sized
+#define CONFIGURE_PUBLISH_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(RcuPublishBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{256 * KB, 4 * MB, 64 * MB}}) \
+        ->ArgNames({"size"}) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+// Table sizes in bytes, read by 1 to 8 reader threads
+#define CONFIGURE_READ_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(RcuReadBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{4 * MB}}) \
+        ->ArgNames({"size"}) \
+        ->ThreadRange(1, 8) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_PUBLISH_BENCHMARK(RcuPublish);
+CONFIGURE_PUBLISH_BENCHMARK(LockedMemcpy);
+CONFIGURE_READ_BENCHMARK(RcuRead);
+CONFIGURE_READ_BENCHMARK(SharedMutexRead);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
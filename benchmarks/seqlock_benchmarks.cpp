@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/seqlock.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int WRITER_CPU = 0;
+
+// === Benchmark Fixture ===
+
+using SnapshotCopy = void (*)(void*, const void*, std::size_t);
+
+// One writer thread rewrites a shared buffer of range(0) bytes in a loop while the
+// benchmark threads read snapshots of it through a seqlock.
+class SeqlockBenchmark : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+
+        const size_t size = static_cast<size_t>(state.range(0));
+        shared.assign(size / sizeof(std::uint64_t), 0);
+        seq = 0;
+        writes = 0;
+        stop = false;
+
+        writer = std::thread([this] {
+            omm::benchmark::PinToCore(WRITER_CPU);
+            std::vector<std::uint64_t> value(shared.size());
+            for (std::uint64_t version = 1; !stop.load(std::memory_order_relaxed); ++version) {
+                value[0] = version;
+                omm::seqlock_write(shared.data(), value.data(), value.size() * sizeof(std::uint64_t), seq);
+                writes.fetch_add(1, std::memory_order_relaxed);
+                // Leave the readers time between writes, like a periodically updated table
+                for (int i = 0; i < 64; ++i) _mm_pause();
+            }
+        });
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index() != 0) return;
+        stop = true;
+        if (writer.joinable()) writer.join();
+    }
+
+protected:
+    // Reads snapshots with the given copy between the sequence checks
+    void run(benchmark::State& state, SnapshotCopy copy) {
+        const size_t size = shared.size() * sizeof(std::uint64_t);
+        std::vector<std::uint64_t> out(shared.size());
+        size_t retries = 0;
+
+        for (auto _ : state) {
+            for (;;) {
+                const std::uint64_t before = seq.load(std::memory_order_acquire);
+                if (before & 1) {
+                    ++retries;
+                    _mm_pause();
+                    continue;
+                }
+                copy(out.data(), shared.data(), size);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (seq.load(std::memory_order_relaxed) == before) break;
+                ++retries;
+            }
+            benchmark::DoNotOptimize(out.data());
+        }
+
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(size));
+        state.counters["retries"] = benchmark::Counter(static_cast<double>(retries), benchmark::Counter::kAvgIterations);
+        if (state.thread_index() == 0) {
+            state.counters["writes"] = benchmark::Counter(static_cast<double>(writes.load()), benchmark::Counter::kIsRate);
+        }
+    }
+
+    std::vector<std::uint64_t> shared;
+    std::atomic<std::uint64_t> seq{0};
+    std::atomic<size_t> writes{0};
+    std::atomic<bool> stop{false};
+    std::thread writer;
+};
+
+// === Benchmark Functions ===
+
+BENCHMARK_DEFINE_F(SeqlockBenchmark, SeqlockCopy)(benchmark::State& state) {
+    run(state, omm::detail::best_seqlock_read);
+}
+
+// Baseline: word-by-word relaxed atomic loads, the portable race-free copy
+BENCHMARK_DEFINE_F(SeqlockBenchmark, AtomicWordCopy)(benchmark::State& state) {
+    run(state, omm::detail::seqlock_read_generic);
+}
+
+// Baseline: std::memcpy, fast but formally a data race
+BENCHMARK_DEFINE_F(SeqlockBenchmark, Memcpy)(benchmark::State& state) {
+    run(state, [](void* dest, const void* src, std::size_t n) { std::memcpy(dest, src, n); });
+}
+
+// === Benchmark Configuration ===
+
+// Snapshot sizes in bytes, read by 1 to 8 reader threads
+#define CONFIGURE_BENCHMARK(name) \
+    BENCHMARK_REGISTER_F(SeqlockBenchmark, name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#name)) \
+        ->ArgsProduct({{256, 4 * KB, 64 * KB}}) \
+        ->ArgNames({"size"}) \
+        ->ThreadRange(1, 8) \
+        ->Repetitions(REPETITIONS) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(SeqlockCopy);
+CONFIGURE_BENCHMARK(AtomicWordCopy);
+CONFIGURE_BENCHMARK(Memcpy);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
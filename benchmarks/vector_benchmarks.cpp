@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <vector>
+#include "benchmark_utils.h"
+#include "omm/vector.h"
+
+// === Constants ===
+
+constexpr size_t KB = 1024;
+constexpr size_t MB = 1024 * KB;
+constexpr size_t GB = 1024 * MB;
+
+constexpr size_t MIN_ALLOCATION = 1 * KB;
+constexpr size_t MAX_ALLOCATION = 10 * GB;
+
+constexpr uint16_t REPETITIONS = 3;
+constexpr int CPU_NUM = 0;
+
+// 64-byte record, a typical trivially copyable payload
+struct Record {
+    std::uint64_t fields[8];
+};
+
+// === Benchmark Functions ===
+
+// Fills a vector by push_back until it holds state.range(0) bytes, starting from empty
+template <typename Vector>
+void PushBack(benchmark::State& state) {
+    using T = typename Vector::value_type;
+    const size_t count = static_cast<size_t>(state.range(0)) / sizeof(T);
+    omm::benchmark::PinToCore(CPU_NUM);  // Pin to specified CPU core
+
+    for (auto _ : state) {
+        Vector values;
+        for (size_t i = 0; i < count; ++i) {
+            values.push_back(T{{i}});
+        }
+        benchmark::DoNotOptimize(values.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(count * sizeof(T)));
+}
+
+void StandardVector(benchmark::State& state) { PushBack<std::vector<Record>>(state); }
+void OMM_Vector(benchmark::State& state) { PushBack<omm::vector<Record>>(state); }
+
+// === Benchmark Configuration ===
+
+std::vector<int64_t> BenchmarkRange() {
+    std::vector<int64_t> range;
+    for (int64_t size = MIN_ALLOCATION; size < int64_t(MAX_ALLOCATION); size *= 8) {
+        range.push_back(size);
+    }
+    range.push_back(int64_t(MAX_ALLOCATION));
+    return range;
+}
+
+#define CONFIGURE_BENCHMARK(func_name) \
+    BENCHMARK(func_name) \
+        ->Name(omm::benchmark::GetColoredBenchmarkName(#func_name)) \
+        ->ArgsProduct({BenchmarkRange()}) \
+        ->ArgNames({"bytes"}) \
+        ->Repetitions(REPETITIONS) \
+        ->Unit(benchmark::kMicrosecond) \
+        ->UseRealTime() \
+        ->ReportAggregatesOnly(true)
+
+CONFIGURE_BENCHMARK(StandardVector);
+CONFIGURE_BENCHMARK(OMM_Vector);
+
+// === Main Function ===
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+
+    omm::benchmark::FilteredReporter filtered_reporter({"mean", "stddev", "cv"});
+    benchmark::RunSpecifiedBenchmarks(&filtered_reporter);
+
+    return 0;
+}
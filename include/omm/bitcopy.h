@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include "omm/detail/cpu_features.h"
+#include "omm/memcpy.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/bitcopy_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/bitcopy_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Function pointer type for shifted byte copy implementations
+using BitcopyShiftedFunc = void (*)(uint8_t*, const uint8_t*, unsigned, std::size_t);
+
+// Portable funnel shift, a 64-bit word at a time
+inline void bitcopy_shifted_generic(uint8_t* __restrict dest, const uint8_t* __restrict src, unsigned shift, std::size_t size) noexcept {
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        __builtin_memcpy(&word, src + i, sizeof(word));
+        word = (word >> shift) | (std::uint64_t{src[i + sizeof(word)]} << (64 - shift));
+        __builtin_memcpy(dest + i, &word, sizeof(word));
+    }
+    for (; i < size; ++i) {
+        dest[i] = static_cast<uint8_t>((src[i] >> shift) | (src[i + 1] << (8 - shift)));
+    }
+}
+
+// Selects the optimal shifted copy based on available CPU features. The AVX-512 kernel
+// also needs VBMI2 for its concatenated shifts.
+inline BitcopyShiftedFunc initialize_best_bitcopy_shifted() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512vbmi2()) return bitcopy_shifted_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return bitcopy_shifted_avx2;
+    #endif
+    return bitcopy_shifted_generic;
+}
+
+static const BitcopyShiftedFunc best_bitcopy_shifted = initialize_best_bitcopy_shifted();
+
+// The count (at most 8) bits of src starting at bit shift (below 8), in the low bits
+inline unsigned read_bits(const uint8_t* src, unsigned shift, std::size_t count) noexcept {
+    unsigned bits = src[0] >> shift;
+    if (shift + count > 8) bits |= static_cast<unsigned>(src[1]) << (8 - shift);
+    return bits & ((1u << count) - 1);
+}
+
+// Replaces the count bits of *dest starting at bit shift with the low bits of bits
+inline void write_bits(uint8_t* dest, unsigned shift, unsigned bits, std::size_t count) noexcept {
+    const unsigned mask = ((1u << count) - 1) << shift;
+    *dest = static_cast<uint8_t>((*dest & ~mask) | ((bits << shift) & mask));
+}
+
+} // namespace detail
+
+/**
+ * @brief Copies nbits bits from bit src_bit of src to bit dest_bit of dest.
+ *
+ * Bit i of a buffer is bit i % 8 (least significant first) of byte i / 8, matching
+ * little-endian word loads. Destination bits outside the range are preserved. The
+ * ranges must not overlap.
+ *
+ * When both offsets are byte aligned this is omm::memcpy plus a masked last byte.
+ * Otherwise the first destination byte is completed on its own. The rest is written
+ * whole bytes at a time by funnel-shift kernels, which stream outputs of at least the L3
+ * size.
+ */
+__attribute__((hot, nonnull(1, 3)))
+inline void bitcopy(void* __restrict dest, std::size_t dest_bit, const void* __restrict src, std::size_t src_bit, std::size_t nbits) noexcept {
+    auto* dest_ptr = static_cast<uint8_t*>(dest) + dest_bit / 8;
+    const auto* src_ptr = static_cast<const uint8_t*>(src) + src_bit / 8;
+    const unsigned dest_shift = static_cast<unsigned>(dest_bit % 8);
+    unsigned src_shift = static_cast<unsigned>(src_bit % 8);
+    if (nbits == 0) return;
+
+    // Head: complete the first destination byte so the rest is byte aligned
+    if (dest_shift != 0) {
+        const std::size_t count = std::min<std::size_t>(8 - dest_shift, nbits);
+        detail::write_bits(dest_ptr, dest_shift, detail::read_bits(src_ptr, src_shift, count), count);
+        ++dest_ptr;
+        src_shift += static_cast<unsigned>(count);
+        src_ptr += src_shift / 8;
+        src_shift %= 8;
+        nbits -= count;
+    }
+
+    const std::size_t bytes = nbits / 8;
+    if (src_shift == 0) {
+        omm::memcpy(dest_ptr, src_ptr, bytes);
+    } else {
+        detail::best_bitcopy_shifted(dest_ptr, src_ptr, src_shift, bytes);
+    }
+
+    // Tail: the last partial destination byte
+    if (const std::size_t count = nbits % 8) {
+        detail::write_bits(dest_ptr + bytes, 0, detail::read_bits(src_ptr + bytes, src_shift, count), count);
+    }
+}
+
+} // namespace omm
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/compress_copy_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/compress_copy_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Element widths the compress kernels are built for
+template <typename T>
+inline constexpr bool is_compress_copy_supported_v =
+        (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8) && std::is_trivially_copyable_v<T>;
+
+// Function pointer type for compress_copy implementations
+template <typename T>
+using CompressCopyFunc = std::size_t (*)(T*, const T*, const std::uint8_t*, std::size_t);
+
+// Portable fallback: one element at a time
+template <typename T>
+inline std::size_t compress_copy_generic(T* __restrict dest, const T* __restrict src, const std::uint8_t* __restrict mask_bitmap,
+                                         std::size_t count) noexcept {
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (mask_bitmap[i / 8] >> (i % 8) & 1) dest[written++] = src[i];
+    }
+    return written;
+}
+
+// Selects the optimal kernel based on available CPU features. The AVX-512 kernel also
+// needs AVX-512BW, and VBMI and VBMI2 for 1 and 2-byte elements.
+template <typename T>
+inline CompressCopyFunc<T> initialize_best_compress_copy() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512bw() && (sizeof(T) >= 4 || (cpu_supports_avx512vbmi() && cpu_supports_avx512vbmi2()))) {
+        return compress_copy_avx512<T>;
+    }
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return compress_copy_avx2<T>;
+    #endif
+    return compress_copy_generic<T>;
+}
+
+template <typename T>
+inline const CompressCopyFunc<T> best_compress_copy = initialize_best_compress_copy<T>();
+
+} // namespace detail
+
+/**
+ * @brief Copies the elements of src whose mask bit is set to dest, in order.
+ *
+ * Bit i of mask_bitmap, least significant bit first within each byte, selects src[i].
+ * This is a stream compaction: a copy_if whose predicate has already been evaluated
+ * into a bitmap, e.g. by a vectorized comparison. dest needs room for the selected
+ * elements only; nothing past them is written. Elements are 1, 2, 4 or 8 bytes. Inputs
+ * of at least the L3 size are written with streaming stores. A dest that is not aligned
+ * to the element size, possible for types such as a struct of two floats, is copied one
+ * element at a time.
+ *
+ * dest must not overlap src.
+ *
+ * @return The number of elements written.
+ */
+template <typename T>
+__attribute__((always_inline, hot, nonnull(1, 2, 3)))
+inline std::size_t compress_copy(T* __restrict dest, const T* __restrict src, const void* __restrict mask_bitmap, std::size_t count) noexcept {
+    static_assert(detail::is_compress_copy_supported_v<T>, "compress_copy supports 1, 2, 4 or 8-byte elements");
+    // The kernels stage whole elements at the vector boundary below dest, which needs dest
+    // aligned to the element size; types aligned below their size may not be
+    if constexpr (alignof(T) < sizeof(T)) {
+        if (reinterpret_cast<std::uintptr_t>(dest) % sizeof(T) != 0) {
+            return detail::compress_copy_generic<T>(dest, src, static_cast<const std::uint8_t*>(mask_bitmap), count);
+        }
+    }
+    return detail::best_compress_copy<T>(dest, src, static_cast<const std::uint8_t*>(mask_bitmap), count);
+}
+
+} // namespace omm
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <sys/uio.h>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/concat_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/concat_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Function pointer type for concat implementations
+using ConcatFunc = std::size_t (*)(void*, const iovec*, std::size_t);
+
+// Portable fallback: one copy per slice
+inline std::size_t concat_generic(void* __restrict dest, const iovec* slices, std::size_t count) noexcept {
+    auto* dest_ptr = static_cast<uint8_t*>(dest);
+    for (std::size_t s = 0; s < count; ++s) {
+        std::memcpy(dest_ptr, slices[s].iov_base, slices[s].iov_len);
+        dest_ptr += slices[s].iov_len;
+    }
+    return static_cast<std::size_t>(dest_ptr - static_cast<uint8_t*>(dest));
+}
+
+// Selects the optimal concat implementation based on available CPU features
+inline ConcatFunc initialize_best_concat() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return concat_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return concat_avx2;
+    #endif
+    return concat_generic;
+}
+
+static const ConcatFunc best_concat = initialize_best_concat();
+
+} // namespace detail
+
+/**
+ * @brief Copies the slices back to back into dest and returns the total bytes written.
+ *
+ * Equivalent to one memcpy per slice at increasing offsets, but large outputs are
+ * streamed with the destination alignment carried across slice boundaries and a single
+ * fence at the end. dest must hold the sum of the slice lengths and must not overlap
+ * any slice.
+ */
+__attribute__((always_inline, hot, nonnull(1)))
+inline std::size_t concat(void* __restrict dest, std::span<const iovec> slices) noexcept {
+    return detail::best_concat(dest, slices.data(), slices.size());
+}
+
+} // namespace omm
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "omm/detail/cpu_features.h"
+#include "omm/float16.h"
+#include "omm/memcpy.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/convert_copy_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/convert_copy_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+template <typename T>
+inline constexpr bool is_convert_integer_v = std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T>
+inline constexpr bool is_half_float_v = std::is_same_v<T, float16> || std::is_same_v<T, bfloat16>;
+
+// Conversions convert_copy provides: float to and from float16 or bfloat16, and integer
+// widening or saturating narrowing within one signedness
+template <typename From, typename To>
+inline constexpr bool is_convert_copy_supported_v =
+        std::is_same_v<From, To> ||
+        (std::is_same_v<From, float> && is_half_float_v<To>) ||
+        (is_half_float_v<From> && std::is_same_v<To, float>) ||
+        (is_convert_integer_v<From> && is_convert_integer_v<To> && std::is_signed_v<From> == std::is_signed_v<To>);
+
+// Function pointer type for convert_copy implementations
+template <typename From, typename To>
+using ConvertCopyFunc = void (*)(To*, const From*, std::size_t);
+
+// One element, with the kernels' rounding and saturation
+template <typename From, typename To>
+constexpr To convert_element(From value) noexcept {
+    if constexpr (std::is_same_v<To, float16>) {
+        return to_float16(value);
+    } else if constexpr (std::is_same_v<To, bfloat16>) {
+        return to_bfloat16(value);
+    } else if constexpr (std::is_same_v<To, float>) {
+        return to_float(value);
+    } else if constexpr (sizeof(To) >= sizeof(From)) {
+        return static_cast<To>(value);
+    } else {
+        return static_cast<To>(std::clamp<From>(value, std::numeric_limits<To>::min(), std::numeric_limits<To>::max()));
+    }
+}
+
+// Portable fallback: one element at a time
+template <typename From, typename To>
+inline void convert_copy_generic(To* __restrict dest, const From* __restrict src, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        dest[i] = convert_element<From, To>(src[i]);
+    }
+}
+
+// Selects the optimal conversion for the pair based on available CPU features. The
+// AVX-512 kernels also need AVX-512BW, and the AVX2 float16 kernels need F16C.
+template <typename From, typename To>
+inline ConvertCopyFunc<From, To> initialize_best_convert_copy() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512bw()) return convert_copy_avx512<From, To>;
+    #endif
+    #ifdef __AVX2__
+    const bool needs_f16c = std::is_same_v<From, float16> || std::is_same_v<To, float16>;
+    if (cpu_supports_avx2() && (!needs_f16c || cpu_supports_f16c())) return convert_copy_avx2<From, To>;
+    #endif
+    return convert_copy_generic<From, To>;
+}
+
+template <typename From, typename To>
+inline const ConvertCopyFunc<From, To> best_convert_copy = initialize_best_convert_copy<From, To>();
+
+} // namespace detail
+
+/**
+ * @brief Copies count elements from src to dest, converting each from From to To.
+ *
+ * Conversions fuse into the copy, so converting costs one pass, not a memcpy plus a
+ * conversion pass:
+ * - float to float16 or bfloat16 rounds to nearest even, and back widens exactly.
+ * - Integers of one signedness widen by sign or zero extension and narrow with
+ *   saturation.
+ * - From == To is omm::memcpy.
+ *
+ * The ranges must not overlap.
+ */
+template <typename From, typename To>
+__attribute__((always_inline, hot, nonnull(1, 2)))
+inline void convert_copy(To* __restrict dest, const From* __restrict src, std::size_t count) noexcept {
+    static_assert(detail::is_convert_copy_supported_v<From, To>, "convert_copy does not support this pair of types");
+    if constexpr (std::is_same_v<From, To>) {
+        omm::memcpy(dest, src, count * sizeof(To));
+    } else {
+        detail::best_convert_copy<From, To>(dest, src, count);
+    }
+}
+
+} // namespace omm
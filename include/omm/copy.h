@@ -0,0 +1,106 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "omm/memcpy.h"
+
+namespace omm {
+
+namespace detail {
+
+// Selects the streaming kernel for destinations aligned to at least `alignment` bytes,
+// which can skip the alignment prologue. Falls back to the general kernel otherwise.
+inline MemcpyFunc initialize_best_memcpy_aligned(std::size_t alignment) {
+    #ifdef __AVX512F__
+    if (alignment >= 64 && cpu_supports_avx512f()) return memcpy_avx512_aligned;
+    #endif
+    #ifdef __AVX2__
+    if (alignment >= 32 && cpu_supports_avx2()) return memcpy_avx2_aligned;
+    #endif
+    return best_memcpy;
+}
+
+static const MemcpyFunc best_memcpy_aligned32 = initialize_best_memcpy_aligned(32);
+static const MemcpyFunc best_memcpy_aligned64 = initialize_best_memcpy_aligned(64);
+
+// Copies count objects, choosing the kernel from what alignof(T) guarantees about dest
+template <typename T>
+__attribute__((always_inline, hot))
+inline void copy_objects(T* __restrict dest, const T* __restrict src, std::size_t count) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "omm::copy requires a trivially copyable type");
+
+    T* aligned_dest = std::assume_aligned<alignof(T)>(dest);
+    const T* aligned_src = std::assume_aligned<alignof(T)>(src);
+    const std::size_t bytes = count * sizeof(T);
+
+    // Small copies stay inline, where the alignment lets the compiler use aligned moves
+    if (__builtin_expect(bytes < G_L3_CACHE_SIZE, 1)) {
+        __builtin_memcpy(aligned_dest, aligned_src, bytes);
+        return;
+    }
+
+    if constexpr (alignof(T) >= 64) {
+        best_memcpy_aligned64(aligned_dest, aligned_src, bytes);
+    } else if constexpr (alignof(T) >= 32) {
+        best_memcpy_aligned32(aligned_dest, aligned_src, bytes);
+    } else {
+        best_memcpy(aligned_dest, aligned_src, bytes);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Copies count objects from src to dest.
+ *
+ * Arrays of types with alignof(T) >= 32 or 64 use streaming kernels that skip the
+ * destination alignment prologue. Non-trivially-copyable types are rejected at
+ * compile time.
+ *
+ * @return Pointer one past the last object written.
+ */
+template <typename T>
+__attribute__((always_inline, hot))
+inline T* copy_n(const T* __restrict src, std::size_t count, T* __restrict dest) noexcept {
+    detail::copy_objects(dest, src, count);
+    return dest + count;
+}
+
+/**
+ * @brief Copies src into the front of dest.
+ *
+ * Copies min(src.size(), dest.size()) objects, so a dest shorter than src receives the
+ * front of src and nothing past it is written.
+ *
+ * @return Pointer one past the last object written.
+ */
+template <typename T>
+__attribute__((always_inline, hot))
+inline T* copy(std::span<const T> src, std::span<T> dest) noexcept {
+    const std::size_t count = std::min(src.size(), dest.size());
+    detail::copy_objects(dest.data(), src.data(), count);
+    return dest.data() + count;
+}
+
+/**
+ * @brief Range overload of copy for any pair of contiguous ranges with the same element type.
+ * @return Pointer one past the last object written.
+ */
+template <std::ranges::contiguous_range In, std::ranges::contiguous_range Out>
+    requires std::ranges::sized_range<In> &&
+             std::same_as<std::ranges::range_value_t<In>, std::ranges::range_value_t<Out>> &&
+             (!std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<Out>>>)
+__attribute__((always_inline, hot))
+inline auto copy(In&& src, Out&& dest) noexcept {
+    using T = std::ranges::range_value_t<In>;
+    return omm::copy(std::span<const T>(std::ranges::data(src), std::ranges::size(src)),
+                     std::span<T>(std::ranges::data(dest), std::ranges::size(dest)));
+}
+
+} // namespace omm
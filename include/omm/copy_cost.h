@@ -0,0 +1,306 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+#include <immintrin.h>
+
+#include "omm/memcpy.h"
+
+namespace omm {
+
+// Levels of the memory hierarchy a copy's working set can fit in
+enum class memory_tier : std::size_t { l1, l2, l3, dram };
+
+inline constexpr std::size_t MEMORY_TIERS = 4;
+
+// The copy kernel a caller will run
+enum class copy_kernel {
+    automatic,  // omm::memcpy: regular stores below the L3 size, streaming stores from it on
+    temporal,   // Regular stores through the cache at every size, as omm::memcpy in L2-sized pieces
+    streaming,  // Non-temporal stores at every size, as the streaming kernels
+};
+
+// What the caller knows about a copy; the defaults describe a copy of recently used data
+// through omm::memcpy
+struct copy_hints {
+    copy_kernel kernel = copy_kernel::automatic;
+    // The source has not been touched recently and is read from DRAM whatever its size
+    bool cold_source = false;
+};
+
+/**
+ * @brief Per-host measurements that copy estimates are built from.
+ *
+ * Capacities come from CacheSizeManager; the rest is measured by calibrate_copy_cost().
+ * Each tier is measured at one working set, source plus destination, and estimates for
+ * working sets in between are interpolated. Calibration data can be stored and passed
+ * back to estimate_copy_ns() to skip measuring.
+ */
+struct copy_calibration {
+    // Bytes each tier holds; the DRAM entry is unbounded
+    std::array<std::size_t, MEMORY_TIERS> capacity{};
+    // Source plus destination bytes each tier was measured at
+    std::array<std::size_t, MEMORY_TIERS> working_set{};
+    // Dependent load latency in ns, from a pointer chase over each cache working set, and
+    // over four times the L3 size for DRAM
+    std::array<double, MEMORY_TIERS> latency_ns{};
+    // Bytes per ns one thread copies with regular stores, through omm::memcpy in pieces
+    // small enough that it never streams
+    std::array<double, MEMORY_TIERS> bandwidth{};
+    // Bytes per ns one thread copies with the streaming kernels omm::memcpy runs from the
+    // L3 size on
+    std::array<double, MEMORY_TIERS> stream_bandwidth{};
+    // Bytes per ns all hardware threads copy together between DRAM-sized buffers
+    double dram_peak_bandwidth = 0;
+    // Threads that run at once; splitting a copy further only adds start costs
+    unsigned hardware_threads = 1;
+    // ns to start and join one helper thread
+    double thread_start_ns = 0;
+};
+
+namespace detail {
+
+// Time spent in each bandwidth sample, and samples taken per measurement
+inline constexpr auto COPY_COST_SAMPLE_TIME = std::chrono::milliseconds(2);
+inline constexpr int COPY_COST_SAMPLES = 3;
+
+// Largest copy source and pointer chase used to measure DRAM
+inline constexpr std::size_t COPY_COST_MAX_DRAM_BYTES = 256 * 1024 * 1024;
+
+// Hops per latency measurement
+inline constexpr std::size_t COPY_COST_CHASE_HOPS = 1 << 18;
+
+// Helper threads the DRAM peak is measured with, including the caller
+inline constexpr unsigned COPY_COST_MAX_THREADS = 16;
+
+struct aligned_bytes_deleter {
+    void operator()(std::uint8_t* p) const noexcept { ::operator delete(p, std::align_val_t{64}); }
+};
+
+using aligned_bytes = std::unique_ptr<std::uint8_t[], aligned_bytes_deleter>;
+
+// A 64-byte aligned buffer with every page faulted in
+inline aligned_bytes make_touched_buffer(std::size_t n) {
+    aligned_bytes buffer(static_cast<std::uint8_t*>(::operator new(n, std::align_val_t{64})));
+    __builtin_memset(buffer.get(), 1, n);
+    return buffer;
+}
+
+// Best time of a few samples, each repeating fn for at least the sample time
+template <typename Fn>
+inline double best_time_ns(Fn&& fn, int samples = COPY_COST_SAMPLES) {
+    double best = 0;
+    for (int s = 0; s < samples; ++s) {
+        std::size_t reps = 0;
+        const auto start = std::chrono::steady_clock::now();
+        auto now = start;
+        do {
+            fn();
+            ++reps;
+            now = std::chrono::steady_clock::now();
+        } while (now - start < COPY_COST_SAMPLE_TIME);
+        const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - start).count()) / static_cast<double>(reps);
+        if (s == 0 || ns < best) best = ns;
+    }
+    return best;
+}
+
+// Average ns per hop of a random cyclic pointer chase over bytes bytes, one hop per line
+inline double measure_latency_ns(std::size_t bytes) {
+    struct alignas(64) line {
+        std::size_t next;
+    };
+    const std::size_t lines = std::max<std::size_t>(bytes / sizeof(line), 2);
+    std::vector<std::size_t> order(lines);
+    std::iota(order.begin(), order.end(), std::size_t{0});
+    std::shuffle(order.begin(), order.end(), std::mt19937_64(42));
+    std::vector<line> chain(lines);
+    for (std::size_t i = 0; i < lines; ++i) chain[order[i]].next = order[(i + 1) % lines];
+
+    std::size_t p = order[0];
+    for (std::size_t hop = 0; hop < std::min(lines, COPY_COST_CHASE_HOPS); ++hop) p = chain[p].next;
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t hop = 0; hop < COPY_COST_CHASE_HOPS; ++hop) p = chain[p].next;
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    // Keep the chase from being optimized away
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    volatile std::size_t sink = p;
+    (void)sink;
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(COPY_COST_CHASE_HOPS);
+}
+
+// Copies with regular stores at any size: omm::memcpy stores through the cache below the
+// L3 size, and pieces of the L2 size also stay under the libc non-temporal threshold
+inline void copy_temporal(void* dest, const void* src, std::size_t n) noexcept {
+    const std::size_t piece = G_L2_CACHE_SIZE;
+    auto* d = static_cast<std::uint8_t*>(dest);
+    const auto* s = static_cast<const std::uint8_t*>(src);
+    for (std::size_t offset = 0; offset < n; offset += piece) {
+        omm::memcpy(d + offset, s + offset, std::min(piece, n - offset));
+    }
+}
+
+inline void copy_streaming(void* dest, const void* src, std::size_t n) noexcept {
+    best_memcpy_stream(dest, src, n);
+    // Ensure all non-temporal (streaming) stores are visible
+    _mm_sfence();
+}
+
+// Splits a streaming copy of n bytes across threads, started before the clock and released together
+inline double measure_parallel_ns(std::uint8_t* dest, const std::uint8_t* src, std::size_t n, unsigned threads) {
+    const std::size_t share = (n / threads) & ~std::size_t{63};
+    std::atomic<bool> go{false};
+    std::atomic<unsigned> done{0};
+    std::vector<std::thread> helpers;
+    for (unsigned t = 1; t < threads; ++t) {
+        helpers.emplace_back([&, t] {
+            while (!go.load(std::memory_order_acquire)) _mm_pause();
+            copy_streaming(dest + t * share, src + t * share, t + 1 == threads ? n - t * share : share);
+            done.fetch_add(1, std::memory_order_release);
+        });
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    copy_streaming(dest, src, threads == 1 ? n : share);
+    while (done.load(std::memory_order_acquire) != threads - 1) _mm_pause();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    for (auto& helper : helpers) helper.join();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
+
+} // namespace detail
+
+/**
+ * @brief Measures this host's copy costs.
+ *
+ * For each cache tier, a pointer chase and copies with regular and with streaming stores
+ * run over a quarter of the L1, L2 and L3 sizes from CacheSizeManager. Copies go through
+ * OMM's own paths: regular stores are omm::memcpy in L2-sized pieces, and streaming
+ * copies are omm::memcpy itself from the L3 size on and its streaming kernel below. The DRAM point is
+ * measured well past the L3, so it reflects misses to memory: its copies move twice the
+ * L3 size (a working set of four times the L3), and its latency is a chase over four
+ * times the L3 size, each at most 256MB. On hosts whose L3 exceeds 64MB the cap leaves
+ * part of the DRAM working set in the L3, and the DRAM point reads optimistic. The DRAM
+ * streaming copy is also split across up to 16 hardware threads for the peak bandwidth.
+ *
+ * Takes on the order of a second and allocates up to 512MB for the copies; store the
+ * result rather than calibrating per process where that matters.
+ */
+inline copy_calibration calibrate_copy_cost() {
+    copy_calibration result;
+    result.capacity = {G_L1_CACHE_SIZE, G_L2_CACHE_SIZE, G_L3_CACHE_SIZE, SIZE_MAX};
+    const std::size_t l3 = G_L3_CACHE_SIZE;
+    const std::size_t dram_bytes = std::min(2 * l3, detail::COPY_COST_MAX_DRAM_BYTES);
+    result.working_set = {result.capacity[0] / 4, result.capacity[1] / 4, result.capacity[2] / 4, 2 * dram_bytes};
+
+    for (std::size_t tier = 0; tier + 1 < MEMORY_TIERS; ++tier) {
+        result.latency_ns[tier] = detail::measure_latency_ns(result.working_set[tier]);
+    }
+    result.latency_ns[3] = detail::measure_latency_ns(std::min(4 * l3, detail::COPY_COST_MAX_DRAM_BYTES));
+
+    auto src = detail::make_touched_buffer(dram_bytes);
+    auto dest = detail::make_touched_buffer(dram_bytes);
+    for (std::size_t tier = 0; tier < MEMORY_TIERS; ++tier) {
+        const std::size_t n = result.working_set[tier] / 2;
+        const double temporal_ns = detail::best_time_ns([&] { detail::copy_temporal(dest.get(), src.get(), n); });
+        const double stream_ns = detail::best_time_ns([&] {
+            if (n >= l3) {
+                omm::memcpy(dest.get(), src.get(), n);
+            } else {
+                detail::copy_streaming(dest.get(), src.get(), n);
+            }
+        });
+        result.bandwidth[tier] = static_cast<double>(n) / temporal_ns;
+        result.stream_bandwidth[tier] = static_cast<double>(n) / stream_ns;
+    }
+
+    result.hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    const unsigned threads = std::min(result.hardware_threads, detail::COPY_COST_MAX_THREADS);
+    double peak_ns = detail::measure_parallel_ns(dest.get(), src.get(), dram_bytes, threads);
+    peak_ns = std::min(peak_ns, detail::measure_parallel_ns(dest.get(), src.get(), dram_bytes, threads));
+    result.dram_peak_bandwidth = std::max(static_cast<double>(dram_bytes) / peak_ns, result.stream_bandwidth[3]);
+
+    result.thread_start_ns = detail::best_time_ns([] { std::thread([] {}).join(); });
+    return result;
+}
+
+namespace detail {
+
+// Value of a per-tier measurement at a working set, interpolated linearly in log2 of the
+// working set between the two nearest tiers and held constant beyond the first and last
+template <typename Value>
+inline double interpolate_tiers(double working, const std::array<std::size_t, MEMORY_TIERS>& working_set, Value value) noexcept {
+    if (working <= static_cast<double>(working_set[0])) return value(0);
+    for (std::size_t tier = 1; tier < MEMORY_TIERS; ++tier) {
+        const double upper = static_cast<double>(working_set[tier]);
+        if (working < upper) {
+            const double lower = static_cast<double>(working_set[tier - 1]);
+            const double t = std::log2(working / lower) / std::log2(upper / lower);
+            return value(tier - 1) + t * (value(tier) - value(tier - 1));
+        }
+    }
+    return value(MEMORY_TIERS - 1);
+}
+
+// This process's calibration, measured on first use
+inline const copy_calibration& host_copy_calibration() {
+    static const copy_calibration calibration = calibrate_copy_cost();
+    return calibration;
+}
+
+} // namespace detail
+
+/**
+ * @brief Estimates the time of copying n bytes, in ns, from the given calibration.
+ *
+ * The copy's working set, source plus destination, places it among the tiers' measured
+ * working sets, or at DRAM for a cold source. The estimate is the latency plus n times
+ * the ns per byte of the kernel, both interpolated between the two nearest tiers on a
+ * log scale. With threads > 1 the copy is split evenly and each helper thread adds its
+ * start cost; the bandwidth scales with the threads the host runs at once, up to the
+ * DRAM peak for copies that stream or reach DRAM.
+ */
+inline double estimate_copy_ns(std::size_t n, const copy_hints& hints, unsigned threads, const copy_calibration& calibration) noexcept {
+    if (n == 0) return 0;
+    threads = std::max(threads, 1u);
+    const std::size_t l3 = calibration.capacity[static_cast<std::size_t>(memory_tier::l3)];
+
+    const double working = hints.cold_source ? static_cast<double>(calibration.working_set[MEMORY_TIERS - 1]) : 2.0 * static_cast<double>(n);
+    const bool streaming = hints.kernel == copy_kernel::streaming || (hints.kernel == copy_kernel::automatic && n >= l3);
+    const bool reaches_dram = streaming || hints.cold_source || 2 * n > l3;
+
+    const auto& bandwidth = streaming ? calibration.stream_bandwidth : calibration.bandwidth;
+    const double per_thread = 1.0 / detail::interpolate_tiers(working, calibration.working_set, [&](std::size_t tier) { return 1.0 / bandwidth[tier]; });
+    const double latency = detail::interpolate_tiers(working, calibration.working_set, [&](std::size_t tier) { return calibration.latency_ns[tier]; });
+
+    double total_bandwidth = per_thread * std::min(threads, std::max(calibration.hardware_threads, 1u));
+    if (reaches_dram) total_bandwidth = std::min(total_bandwidth, std::max(calibration.dram_peak_bandwidth, per_thread));
+
+    return latency + static_cast<double>(n) / total_bandwidth + calibration.thread_start_ns * (threads - 1);
+}
+
+/**
+ * @brief Estimates the time of copying n bytes, in ns, on this host.
+ *
+ * Lets a scheduler weigh copying against sharing by reference, and a local copy against
+ * splitting it across threads. The first call calibrates the process; see
+ * calibrate_copy_cost().
+ *
+ * @param threads Threads the copy is split across, including the caller.
+ */
+inline double estimate_copy_ns(std::size_t n, const copy_hints& hints = {}, unsigned threads = 1) {
+    return estimate_copy_ns(n, hints, threads, detail::host_copy_calibration());
+}
+
+} // namespace omm
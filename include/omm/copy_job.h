@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#include "omm/memcpy.h"
+#include "omm/detail/tsc.h"
+
+namespace omm {
+
+/**
+ * @brief Resumable large copy that advances in bounded slices.
+ *
+ * A copy_job holds all of its state, so a cooperative scheduler or a coroutine can run
+ * a multi-gigabyte copy a slice at a time and yield in between:
+ *
+ * @code
+ * omm::copy_job job(dest, src, n);
+ * while (!job.step(std::chrono::microseconds(200))) {
+ *     co_await scheduler.yield();
+ * }
+ * @endcode
+ *
+ * Each slice streams whole granules with the OMM kernels and ends with an sfence, so
+ * everything reported as copied is visible to other cores even if the job resumes on a
+ * different thread. Granule boundaries are kept on 64-byte destination boundaries, so
+ * only the first slice runs an alignment prologue.
+ */
+class copy_job {
+public:
+    static constexpr std::size_t DEFAULT_GRANULE = 64 * 1024;
+
+    copy_job(void* dest, const void* src, std::size_t n, std::size_t granule = DEFAULT_GRANULE) noexcept
+            : dest_(static_cast<uint8_t*>(dest)),
+              src_(static_cast<const uint8_t*>(src)),
+              size_(n),
+              granule_(std::max<std::size_t>(granule, ALIGNMENT)) {}
+
+    /**
+     * @brief Copies exactly max_bytes more bytes, or the rest of the copy if fewer remain.
+     *
+     * The bytes are copied in granules, and the last one is cut short at max_bytes.
+     * @return true if the copy is complete.
+     */
+    bool step(std::size_t max_bytes) noexcept {
+        const std::size_t limit = copied_ + std::min(max_bytes, size_ - copied_);
+        while (copied_ < limit) {
+            copy_granule(limit);
+        }
+        _mm_sfence();
+        return done();
+    }
+
+    /**
+     * @brief Copies granules until the next one would overrun the time budget.
+     *
+     * At least one granule is copied per call so the job always progresses; a negative
+     * budget counts as zero. The granule time is estimated from earlier granules, so a
+     * slice overruns its budget by at most the error of that estimate.
+     *
+     * @return true if the copy is complete.
+     */
+    bool step(std::chrono::nanoseconds budget) noexcept {
+        const std::uint64_t start = detail::read_tsc();
+        const std::uint64_t deadline = start + detail::ns_to_tsc(static_cast<std::uint64_t>(std::max<std::int64_t>(budget.count(), 0)));
+        std::uint64_t now = start;
+
+        do {
+            const std::uint64_t granule_start = now;
+            copy_granule(size_);
+            now = detail::read_tsc();
+            granule_ticks_ = granule_ticks_ == 0 ? now - granule_start
+                                                 : (7 * granule_ticks_ + (now - granule_start)) / 8;
+        } while (copied_ < size_ && now + granule_ticks_ <= deadline);
+
+        _mm_sfence();
+        return done();
+    }
+
+    bool done() const noexcept { return copied_ == size_; }
+    std::size_t copied() const noexcept { return copied_; }
+    std::size_t size() const noexcept { return size_; }
+    double progress() const noexcept { return size_ == 0 ? 1.0 : static_cast<double>(copied_) / static_cast<double>(size_); }
+
+private:
+    static constexpr std::size_t ALIGNMENT = 64;
+
+    // Copies the next granule, ending on a 64-byte destination boundary or at limit
+    void copy_granule(std::size_t limit) noexcept {
+        const auto dest_end = reinterpret_cast<std::uintptr_t>(dest_ + copied_ + granule_) & ~(ALIGNMENT - 1);
+        std::size_t end = dest_end - reinterpret_cast<std::uintptr_t>(dest_);
+        if (end <= copied_ || end > limit) end = limit;
+
+        detail::best_memcpy_stream(dest_ + copied_, src_ + copied_, end - copied_);
+        copied_ = end;
+    }
+
+    uint8_t* dest_;
+    const uint8_t* src_;
+    std::size_t size_;
+    std::size_t granule_;
+    std::size_t copied_ = 0;
+    std::uint64_t granule_ticks_ = 0;
+};
+
+} // namespace omm
@@ -70,6 +70,112 @@ inline bool cpu_supports_avx2() {
     #endif
 }
 
+/**
+ * @brief Checks if the CPU supports AVX-512BW (byte and word) instructions.
+ *
+ * Kernels using AVX-512BW are compiled with a target pragma on top of AVX-512F, so only
+ * the runtime check applies.
+ * @return true if AVX-512BW is supported, false otherwise.
+ */
+inline bool cpu_supports_avx512bw() {
+    #if defined(__GNUC__) || defined(__clang__)
+        bool supported = __builtin_cpu_supports("avx512bw");
+        DEBUG_PRINT("AVX-512BW runtime check: " << (supported ? "supported" : "not supported"));
+        return supported;
+    #else
+        DEBUG_PRINT("No runtime check available for AVX-512BW");
+        return false;
+    #endif
+}
+
+/**
+ * @brief Checks if the CPU supports AVX-512 VBMI (byte permutes) instructions.
+ *
+ * Like AVX-512BW, VBMI kernels are compiled with a target pragma, so only the runtime
+ * check applies.
+ * @return true if AVX-512 VBMI is supported, false otherwise.
+ */
+inline bool cpu_supports_avx512vbmi() {
+    #if defined(__GNUC__) || defined(__clang__)
+        bool supported = __builtin_cpu_supports("avx512vbmi");
+        DEBUG_PRINT("AVX-512 VBMI runtime check: " << (supported ? "supported" : "not supported"));
+        return supported;
+    #else
+        DEBUG_PRINT("No runtime check available for AVX-512 VBMI");
+        return false;
+    #endif
+}
+
+/**
+ * @brief Checks if the CPU supports AVX-512 VBMI2 (concatenated shifts, byte and word
+ *        compress/expand) instructions.
+ *
+ * Like AVX-512BW, VBMI2 kernels are compiled with a target pragma, so only the runtime
+ * check applies.
+ * @return true if AVX-512 VBMI2 is supported, false otherwise.
+ */
+inline bool cpu_supports_avx512vbmi2() {
+    #if defined(__GNUC__) || defined(__clang__)
+        bool supported = __builtin_cpu_supports("avx512vbmi2");
+        DEBUG_PRINT("AVX-512 VBMI2 runtime check: " << (supported ? "supported" : "not supported"));
+        return supported;
+    #else
+        DEBUG_PRINT("No runtime check available for AVX-512 VBMI2");
+        return false;
+    #endif
+}
+
+/**
+ * @brief Checks if the CPU supports F16C (float16 conversion) instructions.
+ *
+ * F16C kernels are compiled with a target pragma on top of AVX2, so only the runtime
+ * check applies.
+ * @return true if F16C is supported, false otherwise.
+ */
+inline bool cpu_supports_f16c() {
+    #if defined(__GNUC__) || defined(__clang__)
+        bool supported = __builtin_cpu_supports("f16c");
+        DEBUG_PRINT("F16C runtime check: " << (supported ? "supported" : "not supported"));
+        return supported;
+    #else
+        DEBUG_PRINT("No runtime check available for F16C");
+        return false;
+    #endif
+}
+
+/**
+ * @brief Checks if the CPU supports the CLWB (cache line write back) instruction.
+ *
+ * Unlike the vector extensions, code using CLWB is compiled with a target attribute,
+ * so only the runtime check applies.
+ * @return true if CLWB is supported, false otherwise.
+ */
+inline bool cpu_supports_clwb() {
+    #if defined(__GNUC__) || defined(__clang__)
+        bool supported = __builtin_cpu_supports("clwb");
+        DEBUG_PRINT("CLWB runtime check: " << (supported ? "supported" : "not supported"));
+        return supported;
+    #else
+        DEBUG_PRINT("No runtime check available for CLWB");
+        return false;
+    #endif
+}
+
+/**
+ * @brief Checks if the CPU supports the CLFLUSHOPT instruction.
+ * @return true if CLFLUSHOPT is supported, false otherwise.
+ */
+inline bool cpu_supports_clflushopt() {
+    #if defined(__GNUC__) || defined(__clang__)
+        bool supported = __builtin_cpu_supports("clflushopt");
+        DEBUG_PRINT("CLFLUSHOPT runtime check: " << (supported ? "supported" : "not supported"));
+        return supported;
+    #else
+        DEBUG_PRINT("No runtime check available for CLFLUSHOPT");
+        return false;
+    #endif
+}
+
 /**
  * @brief Stores information about a CPU cache level.
  */
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+
+namespace omm {
+
+// Longest pattern period handled by the vector fill kernels
+#ifndef OMM_FILL_MAX_PERIOD
+#define OMM_FILL_MAX_PERIOD 4096
+#endif
+
+/**
+ * @brief Fills size bytes at dest with a repeating pattern of period bytes.
+ *
+ * The pattern is expanded into a template of period + 32 bytes, so a full vector can be
+ * read from any phase within the period. Each vector advances the phase by
+ * 32 % period. When the period divides 32 (fill16/32/64/128) the step is
+ * zero and the whole loop stores a single broadcast register. Large fills align the
+ * destination first and use streaming stores.
+ *
+ * Requires 0 < period <= OMM_FILL_MAX_PERIOD.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1, 3)))
+inline void fill_pattern_avx2(void* __restrict dest, std::size_t size, const void* __restrict pattern,
+                                std::size_t period) noexcept {
+    // AVX2 uses 256-bit (32-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 8;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+
+    // Expand the pattern so ALIGNMENT bytes can be read starting at any phase
+    alignas(ALIGNMENT) uint8_t tmpl[OMM_FILL_MAX_PERIOD + ALIGNMENT];
+    for (std::size_t filled = 0; filled < period + ALIGNMENT; filled += period) {
+        const std::size_t chunk = period + ALIGNMENT - filled < period ? period + ALIGNMENT - filled : period;
+        __builtin_memcpy(tmpl + filled, pattern, chunk);
+    }
+
+    auto* __restrict dest_ptr = static_cast<uint8_t* __restrict>(dest);
+    const bool streaming = size >= G_L3_CACHE_SIZE;
+    std::size_t phase = 0;
+
+    // Align destination to ALIGNMENT boundary for optimal streaming stores
+    if (streaming) {
+        std::size_t initial_bytes = (ALIGNMENT - (reinterpret_cast<std::uintptr_t>(dest_ptr) & (ALIGNMENT - 1))) & (ALIGNMENT - 1);
+        if (initial_bytes > 0) {
+            __builtin_memcpy(dest_ptr, tmpl, initial_bytes);
+            dest_ptr += initial_bytes;
+            size -= initial_bytes;
+            phase = initial_bytes % period;
+        }
+    }
+
+    const std::size_t step = ALIGNMENT % period;
+    const std::size_t vector_size = size & ~(BLOCK_SIZE - 1);
+    auto* __restrict dest_vec = reinterpret_cast<__m256i* __restrict>(dest_ptr);
+
+    auto store = [&](__m256i* ptr, __m256i value) {
+        if (streaming) {
+            _mm256_stream_si256(ptr, value);
+        } else {
+            _mm256_storeu_si256(ptr, value);
+        }
+    };
+
+    if (step == 0) {
+        // Period divides the vector width: one broadcast register covers every store
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tmpl + phase));
+        for (std::size_t i = 0; i < vector_size; i += BLOCK_SIZE) {
+            #pragma unroll(UNROLL_FACTOR)
+            for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                store(dest_vec++, value);
+            }
+        }
+        for (std::size_t i = vector_size; i + ALIGNMENT <= size; i += ALIGNMENT) {
+            store(dest_vec++, value);
+        }
+    } else {
+        // Arbitrary period: walk the template one phase step per vector
+        for (std::size_t i = 0; i + ALIGNMENT <= size; i += ALIGNMENT) {
+            store(dest_vec++, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tmpl + phase)));
+            phase += step;
+            if (phase >= period) phase -= period;
+        }
+    }
+
+    // Handle remaining bytes (< ALIGNMENT) from the template
+    const std::size_t remaining = size & (ALIGNMENT - 1);
+    if (remaining > 0) {
+        __builtin_memcpy(dest_vec, tmpl + phase, remaining);
+    }
+
+    // Ensure all non-temporal (streaming) stores are visible
+    if (streaming) _mm_sfence();
+}
+
+} // namespace omm
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+
+namespace omm {
+
+/**
+ * @brief Writes size bytes at dest, byte i holding source bits [8i + shift, 8i + shift + 8).
+ *
+ * Each 64-bit lane is a funnel shift of two overlapping loads, eight bytes apart:
+ * (w[j] >> shift) | (w[j + 1] << (64 - shift)). Reads size + 1 source bytes; shift must
+ * be in [1, 7]. Outputs of at least the L3 size are streamed.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void bitcopy_shifted_avx2(uint8_t* __restrict dest, const uint8_t* __restrict src, unsigned shift, std::size_t size) noexcept {
+    // AVX2 uses 256-bit (32-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 4;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    // Prefetch two blocks ahead - adjust based on target hardware characteristics
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE;
+    // The second load of a vector reaches this many bytes past it
+    static constexpr std::size_t OVERREAD = 8;
+
+    const __m128i right = _mm_cvtsi32_si128(static_cast<int>(shift));
+    const __m128i left = _mm_cvtsi32_si128(static_cast<int>(64 - shift));
+    auto funnel = [&](std::size_t i) {
+        const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + OVERREAD));
+        return _mm256_or_si256(_mm256_srl_epi64(low, right), _mm256_sll_epi64(high, left));
+    };
+
+    std::size_t i = 0;
+    if (__builtin_expect(size >= G_L3_CACHE_SIZE, 0)) {
+        // Bytes up to the next line boundary use regular stores
+        const std::size_t initial_bytes = (G_CACHE_LINE_SIZE - (reinterpret_cast<std::uintptr_t>(dest) & (G_CACHE_LINE_SIZE - 1))) & (G_CACHE_LINE_SIZE - 1);
+        for (; i < initial_bytes; ++i) {
+            dest[i] = static_cast<uint8_t>((src[i] >> shift) | (src[i + 1] << (8 - shift)));
+        }
+        for (; i + BLOCK_SIZE + OVERREAD <= size; i += BLOCK_SIZE) {
+            // Prefetch data using NTA (Non-Temporal Access) hint to bypass cache for large transfers
+            for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += G_CACHE_LINE_SIZE) {
+                _mm_prefetch(reinterpret_cast<const char*>(src + i + p), _MM_HINT_NTA);
+            }
+            #pragma unroll(UNROLL_FACTOR)
+            for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + i + p * ALIGNMENT), funnel(i + p * ALIGNMENT));
+            }
+        }
+        // Ensure all non-temporal (streaming) stores are visible
+        _mm_sfence();
+    }
+
+    for (; i + BLOCK_SIZE + OVERREAD <= size; i += BLOCK_SIZE) {
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + p * ALIGNMENT), funnel(i + p * ALIGNMENT));
+        }
+    }
+    for (; i + ALIGNMENT + OVERREAD <= size; i += ALIGNMENT) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), funnel(i));
+    }
+
+    // Tail: whole words, each needing only one byte past it, then single bytes
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        __builtin_memcpy(&word, src + i, sizeof(word));
+        word = (word >> shift) | (std::uint64_t{src[i + sizeof(word)]} << (64 - shift));
+        __builtin_memcpy(dest + i, &word, sizeof(word));
+    }
+    for (; i < size; ++i) {
+        dest[i] = static_cast<uint8_t>((src[i] >> shift) | (src[i + 1] << (8 - shift)));
+    }
+}
+
+} // namespace omm
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+// The concatenated shifts need AVX-512 VBMI2 and the masked byte loads AVX-512BW, which
+// the build does not enable with AVX-512F; this kernel is compiled for them and
+// dispatched on a runtime check
+#pragma GCC push_options
+#pragma GCC target("avx512bw,avx512vbmi2")
+
+namespace omm {
+
+/**
+ * @brief Writes size bytes at dest, byte i holding source bits [8i + shift, 8i + shift + 8).
+ *
+ * Each 64-bit lane is one vpshrdvq of two overlapping loads, eight bytes apart. The tail
+ * uses masked loads and stores, so no scalar loop is needed. Reads size + 1 source
+ * bytes; shift must be in [1, 7]. Outputs of at least the L3 size are streamed.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void bitcopy_shifted_avx512(uint8_t* __restrict dest, const uint8_t* __restrict src, unsigned shift, std::size_t size) noexcept {
+    // AVX-512 uses 512-bit (64-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr std::size_t UNROLL_FACTOR = 4;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    // Prefetch two blocks ahead - adjust based on target hardware characteristics
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE;
+    // The second load of a vector reaches this many bytes past it
+    static constexpr std::size_t OVERREAD = 8;
+
+    const __m512i count = _mm512_set1_epi64(shift);
+    auto funnel = [&](std::size_t i) {
+        return _mm512_shrdv_epi64(_mm512_loadu_si512(src + i), _mm512_loadu_si512(src + i + OVERREAD), count);
+    };
+
+    std::size_t i = 0;
+    if (__builtin_expect(size >= G_L3_CACHE_SIZE, 0)) {
+        // Bytes up to the next line boundary use a masked regular store
+        const std::size_t initial_bytes = (ALIGNMENT - (reinterpret_cast<std::uintptr_t>(dest) & (ALIGNMENT - 1))) & (ALIGNMENT - 1);
+        if (initial_bytes) {
+            _mm512_mask_storeu_epi8(dest, ~std::uint64_t{0} >> (ALIGNMENT - initial_bytes), funnel(0));
+            i = initial_bytes;
+        }
+        for (; i + BLOCK_SIZE + OVERREAD <= size; i += BLOCK_SIZE) {
+            // Prefetch data using NTA (Non-Temporal Access) hint to bypass cache for large transfers
+            for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += G_CACHE_LINE_SIZE) {
+                _mm_prefetch(reinterpret_cast<const char*>(src + i + p), _MM_HINT_NTA);
+            }
+            #pragma unroll(UNROLL_FACTOR)
+            for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                _mm512_stream_si512(reinterpret_cast<__m512i*>(dest + i + p * ALIGNMENT), funnel(i + p * ALIGNMENT));
+            }
+        }
+        // Ensure all non-temporal (streaming) stores are visible
+        _mm_sfence();
+    }
+
+    for (; i + BLOCK_SIZE + OVERREAD <= size; i += BLOCK_SIZE) {
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            _mm512_storeu_si512(dest + i + p * ALIGNMENT, funnel(i + p * ALIGNMENT));
+        }
+    }
+    for (; i + ALIGNMENT + OVERREAD <= size; i += ALIGNMENT) {
+        _mm512_storeu_si512(dest + i, funnel(i));
+    }
+
+    // Tail: at most two masked vectors. Both loads stop at source byte size, the last one
+    // the output needs; lanes past it only feed output bytes that are not stored.
+    while (i < size) {
+        const std::size_t length = size - i < ALIGNMENT ? size - i : ALIGNMENT;
+        const std::size_t low_length = length < ALIGNMENT ? length + 1 : ALIGNMENT;
+        const __m512i low = _mm512_maskz_loadu_epi8(~std::uint64_t{0} >> (ALIGNMENT - low_length), src + i);
+        __m512i high = _mm512_setzero_si512();
+        if (i + OVERREAD <= size) {
+            const std::size_t high_length = size + 1 - i - OVERREAD < ALIGNMENT ? size + 1 - i - OVERREAD : ALIGNMENT;
+            high = _mm512_maskz_loadu_epi8(~std::uint64_t{0} >> (ALIGNMENT - high_length), src + i + OVERREAD);
+        }
+        _mm512_mask_storeu_epi8(dest + i, ~std::uint64_t{0} >> (ALIGNMENT - length), _mm512_shrdv_epi64(low, high, count));
+        i += length;
+    }
+}
+
+} // namespace omm
+
+#pragma GCC pop_options
@@ -0,0 +1,246 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Entry m lists the positions of the set bits of the 8-bit mask m, in order. Trailing
+// entries are zero; the lanes they fill are overwritten or never stored.
+inline constexpr auto COMPRESS_INDICES_AVX2 = [] {
+    std::array<std::array<std::uint8_t, 8>, 256> table{};
+    for (std::size_t m = 0; m < 256; ++m) {
+        std::size_t n = 0;
+        for (std::size_t b = 0; b < 8; ++b) {
+            if (m >> b & 1) table[m][n++] = static_cast<std::uint8_t>(b);
+        }
+    }
+    return table;
+}();
+
+__attribute__((always_inline))
+inline __m128i compress_indices_avx2(unsigned mask) noexcept {
+    return _mm_loadl_epi64(reinterpret_cast<const __m128i*>(COMPRESS_INDICES_AVX2[mask].data()));
+}
+
+// Byte indices of the two bytes of each listed position, for positions of 2-byte units
+__attribute__((always_inline))
+inline __m128i widen_indices_avx2(__m128i indices) noexcept {
+    const __m128i low = _mm_add_epi8(indices, indices);
+    return _mm_unpacklo_epi8(low, _mm_add_epi8(low, _mm_set1_epi8(1)));
+}
+
+// The staging vector: bytes of a 128-bit vector for 1 and 2-byte elements, which vpshufb
+// can rotate, or dwords of a 256-bit vector for 4 and 8-byte elements, which vpermd can
+template <bool Wide>
+struct CompressStageAVX2;
+
+template <>
+struct CompressStageAVX2<false> {
+    using Vector = __m128i;
+    static constexpr std::size_t UNIT = 1;
+    static constexpr std::size_t LANES = 16;
+
+    // Lanes below fill of staged, then the lanes of packed from lane fill on, wrapping
+    // around; returns the merged vector and the rotated one
+    __attribute__((always_inline))
+    static void place(Vector staged, Vector packed, std::size_t fill, Vector& merged, Vector& rotated) noexcept {
+        const __m128i iota = _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+        const __m128i lanes = _mm_set1_epi8(static_cast<char>(fill));
+        rotated = _mm_shuffle_epi8(packed, _mm_and_si128(_mm_sub_epi8(iota, lanes), _mm_set1_epi8(15)));
+        merged = _mm_blendv_epi8(rotated, staged, _mm_cmpgt_epi8(lanes, iota));
+    }
+
+    template <bool Stream>
+    __attribute__((always_inline))
+    static void store(void* dest, Vector v) noexcept {
+        if constexpr (Stream) _mm_stream_si128(static_cast<__m128i*>(dest), v);
+        else _mm_store_si128(static_cast<__m128i*>(dest), v);
+    }
+};
+
+template <>
+struct CompressStageAVX2<true> {
+    using Vector = __m256i;
+    static constexpr std::size_t UNIT = 4;
+    static constexpr std::size_t LANES = 8;
+
+    __attribute__((always_inline))
+    static void place(Vector staged, Vector packed, std::size_t fill, Vector& merged, Vector& rotated) noexcept {
+        const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        const __m256i lanes = _mm256_set1_epi32(static_cast<int>(fill));
+        rotated = _mm256_permutevar8x32_epi32(packed, _mm256_sub_epi32(iota, lanes));
+        merged = _mm256_blendv_epi8(rotated, staged, _mm256_cmpgt_epi32(lanes, iota));
+    }
+
+    template <bool Stream>
+    __attribute__((always_inline))
+    static void store(void* dest, Vector v) noexcept {
+        if constexpr (Stream) _mm256_stream_si256(static_cast<__m256i*>(dest), v);
+        else _mm256_store_si256(static_cast<__m256i*>(dest), v);
+    }
+};
+
+/**
+ * Compresses src into dest through one staging vector anchored at the vector boundary at
+ * or below dest. Each chunk of 8 elements is packed by the table-driven shuffle, rotated
+ * up by the staging fill and blended in; once the staging vector is full it is written
+ * with one aligned store, and the rotated chunk already holds the elements that
+ * overflowed it. The partial vectors at either end are written with memcpy.
+ */
+template <typename T, bool Stream>
+__attribute__((always_inline))
+inline std::size_t compress_copy_staged_avx2(T* __restrict dest, const T* __restrict src, const std::uint8_t* __restrict mask_bitmap,
+                                             std::size_t count) noexcept {
+    using Stage = CompressStageAVX2<(sizeof(T) >= 4)>;
+    using Vector = typename Stage::Vector;
+    static constexpr std::size_t VECTOR = sizeof(Vector);
+    static constexpr std::size_t CHUNK = 8;
+    // Prefetch four cache lines ahead
+    static constexpr std::size_t PREFETCH_DISTANCE = 4 * 64 / sizeof(T);
+
+    const std::size_t head = reinterpret_cast<std::uintptr_t>(dest) % VECTOR;
+    std::uint8_t* out = reinterpret_cast<std::uint8_t*>(reinterpret_cast<std::uintptr_t>(dest) - head);
+    Vector staged = Vector{};
+    // Staged lanes, and the bytes of the next vector written that precede dest
+    std::size_t fill = head / Stage::UNIT;
+    std::size_t skip = head;
+    std::size_t written = 0;
+
+    const auto store_bytes = [&](Vector v, std::size_t end) __attribute__((always_inline)) {
+        alignas(VECTOR) std::uint8_t bytes[VECTOR];
+        Stage::template store<false>(bytes, v);
+        std::memcpy(out + skip, bytes + skip, end - skip);
+    };
+    // Appends the first n lanes of packed
+    const auto append = [&](Vector packed, std::size_t n) __attribute__((always_inline)) {
+        Vector merged, rotated;
+        Stage::place(staged, packed, fill, merged, rotated);
+        fill += n;
+        if (fill >= Stage::LANES) {
+            if (__builtin_expect(skip == 0, 1)) {
+                Stage::template store<Stream>(out, merged);
+            } else {
+                store_bytes(merged, VECTOR);
+                skip = 0;
+            }
+            out += VECTOR;
+            fill -= Stage::LANES;
+            staged = rotated;
+        } else {
+            staged = merged;
+        }
+    };
+    const auto compress_chunk = [&](const T* chunk, unsigned mask) __attribute__((always_inline)) {
+        const auto kept = static_cast<std::size_t>(__builtin_popcount(mask));
+        written += kept;
+        if constexpr (sizeof(T) == 1) {
+            const __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(chunk));
+            append(_mm_shuffle_epi8(v, compress_indices_avx2(mask)), kept);
+        } else if constexpr (sizeof(T) == 2) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(chunk));
+            append(_mm_shuffle_epi8(v, widen_indices_avx2(compress_indices_avx2(mask))), 2 * kept);
+        } else if constexpr (sizeof(T) == 4) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+            append(_mm256_permutevar8x32_epi32(v, _mm256_cvtepu8_epi32(compress_indices_avx2(mask))), kept);
+        } else {
+            // Two vectors of four elements, each moved as dword pairs
+            const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk));
+            const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(chunk) + 1);
+            const __m256i low_index = _mm256_cvtepu8_epi32(widen_indices_avx2(compress_indices_avx2(mask & 0xF)));
+            const __m256i high_index = _mm256_cvtepu8_epi32(widen_indices_avx2(compress_indices_avx2(mask >> 4)));
+            append(_mm256_permutevar8x32_epi32(low, low_index), 2 * static_cast<std::size_t>(__builtin_popcount(mask & 0xF)));
+            append(_mm256_permutevar8x32_epi32(high, high_index), 2 * static_cast<std::size_t>(__builtin_popcount(mask >> 4)));
+        }
+    };
+
+    std::size_t i = 0;
+    for (; i + CHUNK <= count; i += CHUNK) {
+        if constexpr (Stream) _mm_prefetch(reinterpret_cast<const char*>(src + i + PREFETCH_DISTANCE), _MM_HINT_NTA);
+        compress_chunk(src + i, mask_bitmap[i / 8]);
+    }
+    // The tail goes through a zero-padded chunk so no load passes the end of src
+    if (i < count) {
+        alignas(32) T tail[CHUNK] = {};
+        std::memcpy(tail, src + i, (count - i) * sizeof(T));
+        compress_chunk(tail, mask_bitmap[i / 8] & ((1u << (count - i)) - 1));
+    }
+    if (fill * Stage::UNIT > skip) store_bytes(staged, fill * Stage::UNIT);
+
+    if constexpr (Stream) {
+        // Ensure all non-temporal (streaming) stores are visible
+        _mm_sfence();
+    }
+    return written;
+}
+
+} // namespace detail
+
+/**
+ * @brief Copies the elements of src whose bit in mask_bitmap is set to dest, in order.
+ *
+ * Each 8-bit mask byte indexes a table of the positions it keeps, which drives a vpshufb
+ * for 1 and 2-byte elements or a vpermd for 4 and 8-byte elements. Packed chunks are
+ * staged in a register so dest is written with whole aligned vectors, streamed for
+ * inputs of at least the L3 size.
+ *
+ * dest must be aligned to sizeof(T), which types aligned below their size do not ensure;
+ * omm::compress_copy sends other destinations to the generic kernel.
+ *
+ * @return The number of elements written.
+ */
+template <typename T>
+__attribute__((hot, nonnull(1, 2, 3)))
+inline std::size_t compress_copy_avx2(T* __restrict dest, const T* __restrict src, const std::uint8_t* __restrict mask_bitmap,
+                                      std::size_t count) noexcept {
+    if (__builtin_expect(count * sizeof(T) >= G_L3_CACHE_SIZE, 0)) {
+        return detail::compress_copy_staged_avx2<T, true>(dest, src, mask_bitmap, count);
+    }
+    return detail::compress_copy_staged_avx2<T, false>(dest, src, mask_bitmap, count);
+}
+
+} // namespace omm
@@ -0,0 +1,225 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+// vpcompressb and vpcompressw need AVX-512 VBMI2, and rotating bytes needs VBMI; the build
+// enables neither, so these kernels are compiled for them and dispatched on runtime checks
+#pragma GCC push_options
+#pragma GCC target("avx512bw,avx512vbmi,avx512vbmi2")
+
+namespace omm {
+
+namespace detail {
+
+// Elements per 512-bit vector
+template <typename T>
+inline constexpr std::size_t COMPRESS_LANES_AVX512 = 64 / sizeof(T);
+
+// Element indices 0 to lanes - 1, at the element width
+template <std::size_t Size>
+inline constexpr auto COMPRESS_IOTA_AVX512 = [] {
+    std::array<std::uint8_t, 64> bytes{};
+    for (std::size_t e = 0; e < 64 / Size; ++e) bytes[e * Size] = static_cast<std::uint8_t>(e);
+    return bytes;
+}();
+
+// Bits [i, i + lanes) of bitmap, where i is a multiple of 8
+__attribute__((always_inline))
+inline std::uint64_t compress_mask_bits_avx512(const std::uint8_t* bitmap, std::size_t i, std::size_t lanes) noexcept {
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, bitmap + i / 8, (lanes + 7) / 8);
+    return lanes >= 64 ? bits : bits & ((std::uint64_t{1} << lanes) - 1);
+}
+
+template <std::size_t Size>
+__attribute__((always_inline))
+inline __m512i maskz_load_avx512(std::uint64_t mask, const void* src) noexcept {
+    if constexpr (Size == 1) return _mm512_maskz_loadu_epi8(mask, src);
+    else if constexpr (Size == 2) return _mm512_maskz_loadu_epi16(static_cast<__mmask32>(mask), src);
+    else if constexpr (Size == 4) return _mm512_maskz_loadu_epi32(static_cast<__mmask16>(mask), src);
+    else return _mm512_maskz_loadu_epi64(static_cast<__mmask8>(mask), src);
+}
+
+template <std::size_t Size>
+__attribute__((always_inline))
+inline void mask_store_avx512(void* dest, std::uint64_t mask, __m512i v) noexcept {
+    if constexpr (Size == 1) _mm512_mask_storeu_epi8(dest, mask, v);
+    else if constexpr (Size == 2) _mm512_mask_storeu_epi16(dest, static_cast<__mmask32>(mask), v);
+    else if constexpr (Size == 4) _mm512_mask_storeu_epi32(dest, static_cast<__mmask16>(mask), v);
+    else _mm512_mask_storeu_epi64(dest, static_cast<__mmask8>(mask), v);
+}
+
+// The elements of v selected by mask, packed into the low lanes
+template <std::size_t Size>
+__attribute__((always_inline))
+inline __m512i compress_avx512(std::uint64_t mask, __m512i v) noexcept {
+    if constexpr (Size == 1) return _mm512_maskz_compress_epi8(mask, v);
+    else if constexpr (Size == 2) return _mm512_maskz_compress_epi16(static_cast<__mmask32>(mask), v);
+    else if constexpr (Size == 4) return _mm512_maskz_compress_epi32(static_cast<__mmask16>(mask), v);
+    else return _mm512_maskz_compress_epi64(static_cast<__mmask8>(mask), v);
+}
+
+// Lane j of v moved to lane (j + shift) mod lanes. Zero-masked permutes, as the unmasked
+// ones trip -Wmaybe-uninitialized in GCC's headers
+template <std::size_t Size>
+__attribute__((always_inline))
+inline __m512i rotate_up_avx512(__m512i v, std::size_t shift) noexcept {
+    const __m512i iota = _mm512_loadu_si512(COMPRESS_IOTA_AVX512<Size>.data());
+    if constexpr (Size == 1) {
+        return _mm512_maskz_permutexvar_epi8(~__mmask64{0}, _mm512_sub_epi8(iota, _mm512_set1_epi8(static_cast<char>(shift))), v);
+    } else if constexpr (Size == 2) {
+        return _mm512_maskz_permutexvar_epi16(~__mmask32{0}, _mm512_sub_epi16(iota, _mm512_set1_epi16(static_cast<short>(shift))), v);
+    } else if constexpr (Size == 4) {
+        return _mm512_maskz_permutexvar_epi32(static_cast<__mmask16>(~0u), _mm512_sub_epi32(iota, _mm512_set1_epi32(static_cast<int>(shift))), v);
+    } else {
+        return _mm512_maskz_permutexvar_epi64(static_cast<__mmask8>(~0u), _mm512_sub_epi64(iota, _mm512_set1_epi64(static_cast<long long>(shift))), v);
+    }
+}
+
+// Lanes of b where mask is set, of a elsewhere
+template <std::size_t Size>
+__attribute__((always_inline))
+inline __m512i blend_avx512(std::uint64_t mask, __m512i a, __m512i b) noexcept {
+    if constexpr (Size == 1) return _mm512_mask_blend_epi8(mask, a, b);
+    else if constexpr (Size == 2) return _mm512_mask_blend_epi16(static_cast<__mmask32>(mask), a, b);
+    else if constexpr (Size == 4) return _mm512_mask_blend_epi32(static_cast<__mmask16>(mask), a, b);
+    else return _mm512_mask_blend_epi64(static_cast<__mmask8>(mask), a, b);
+}
+
+/**
+ * Compresses src into dest through one staging vector anchored at the 64-byte boundary at
+ * or below dest. Each chunk's vpcompress result is rotated up by the staging fill and
+ * blended in; once the staging vector is full it is written with one aligned store, and
+ * the rotated chunk already holds the elements that overflowed it. Lanes before dest in
+ * the first vector and past the output in the last one are masked off.
+ */
+template <typename T, bool Stream>
+__attribute__((always_inline))
+inline std::size_t compress_copy_staged_avx512(T* __restrict dest, const T* __restrict src, const std::uint8_t* __restrict mask_bitmap,
+                                               std::size_t count) noexcept {
+    static constexpr std::size_t LANES = COMPRESS_LANES_AVX512<T>;
+    static constexpr std::size_t SIZE = sizeof(T);
+    static constexpr std::uint64_t ALL_LANES = ~std::uint64_t{0} >> (64 - LANES);
+    // Prefetch four cache lines ahead
+    static constexpr std::size_t PREFETCH_DISTANCE = 4 * 64 / sizeof(T);
+
+    const std::size_t head = reinterpret_cast<std::uintptr_t>(dest) % 64 / SIZE;
+    T* out = reinterpret_cast<T*>(reinterpret_cast<std::uintptr_t>(dest) - head * SIZE);
+    __m512i staged = _mm512_setzero_si512();
+    std::size_t fill = head;
+    // Lanes of the next staging vector written that belong to dest
+    std::uint64_t keep = (ALL_LANES << head) & ALL_LANES;
+    std::size_t written = 0;
+
+    auto append = [&](std::uint64_t mask, __m512i v) __attribute__((always_inline)) {
+        const std::size_t n = static_cast<std::size_t>(__builtin_popcountll(mask));
+        const __m512i rotated = rotate_up_avx512<SIZE>(compress_avx512<SIZE>(mask, v), fill);
+        const __m512i merged = blend_avx512<SIZE>((ALL_LANES << fill) & ALL_LANES, staged, rotated);
+        written += n;
+        fill += n;
+        if (fill >= LANES) {
+            if (__builtin_expect(keep == ALL_LANES, 1)) {
+                if constexpr (Stream) _mm512_stream_si512(reinterpret_cast<__m512i*>(out), merged);
+                else _mm512_store_si512(out, merged);
+            } else {
+                mask_store_avx512<SIZE>(out, keep, merged);
+                keep = ALL_LANES;
+            }
+            out += LANES;
+            fill -= LANES;
+            staged = rotated;
+        } else {
+            staged = merged;
+        }
+    };
+
+    std::size_t i = 0;
+    for (; i + LANES <= count; i += LANES) {
+        if constexpr (Stream) _mm_prefetch(reinterpret_cast<const char*>(src + i + PREFETCH_DISTANCE), _MM_HINT_NTA);
+        const std::uint64_t mask = compress_mask_bits_avx512(mask_bitmap, i, LANES);
+        append(mask, _mm512_loadu_si512(src + i));
+    }
+    if (i < count) {
+        const std::uint64_t mask = compress_mask_bits_avx512(mask_bitmap, i, count - i);
+        if (mask) append(mask, maskz_load_avx512<SIZE>(ALL_LANES >> (LANES - (count - i)), src + i));
+    }
+    if (fill) mask_store_avx512<SIZE>(out, keep & ((std::uint64_t{1} << fill) - 1), staged);
+
+    if constexpr (Stream) {
+        // Ensure all non-temporal (streaming) stores are visible
+        _mm_sfence();
+    }
+    return written;
+}
+
+} // namespace detail
+
+/**
+ * @brief Copies the elements of src whose bit in mask_bitmap is set to dest, in order.
+ *
+ * Each vector of elements is packed with vpcompressb, vpcompressw, vpcompressd or
+ * vpcompressq and staged in a register, so dest is only written with whole aligned
+ * vectors plus one masked store at either end. Inputs of at least the L3 size write
+ * those vectors with streaming stores.
+ *
+ * dest must be aligned to sizeof(T), which types aligned below their size do not ensure;
+ * omm::compress_copy sends other destinations to the generic kernel.
+ *
+ * @return The number of elements written.
+ */
+template <typename T>
+__attribute__((hot, nonnull(1, 2, 3)))
+inline std::size_t compress_copy_avx512(T* __restrict dest, const T* __restrict src, const std::uint8_t* __restrict mask_bitmap,
+                                        std::size_t count) noexcept {
+    if (__builtin_expect(count * sizeof(T) >= G_L3_CACHE_SIZE, 0)) {
+        return detail::compress_copy_staged_avx512<T, true>(dest, src, mask_bitmap, count);
+    }
+    return detail::compress_copy_staged_avx512<T, false>(dest, src, mask_bitmap, count);
+}
+
+} // namespace omm
+
+#pragma GCC pop_options
@@ -0,0 +1,133 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <sys/uio.h>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+
+namespace omm {
+
+/**
+ * @brief Copies count slices back to back into dest and returns the bytes written.
+ *
+ * Below the L3 size the slices are copied with the builtin memcpy. Above it, each slice
+ * of at least one block streams the whole cache lines it covers, with the line alignment
+ * taken from the running destination offset rather than realigned per call. Partial lines
+ * at slice boundaries use regular stores, so a streaming store never shares a line with
+ * another slice, and a single sfence covers the whole copy.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1)))
+inline std::size_t concat_avx2(void* __restrict dest, const iovec* slices, std::size_t count) noexcept {
+    // AVX2 uses 256-bit (32-byte) vectors, two per cache line
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t LINE_SIZE = 64;
+    static constexpr std::size_t UNROLL_FACTOR = 8;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    // Prefetch two blocks ahead - adjust based on target hardware characteristics
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE;
+
+    auto* __restrict dest_ptr = static_cast<uint8_t*>(dest);
+
+    // Output size up to the streaming threshold; slices past it need not be summed
+    std::size_t total = 0;
+    for (std::size_t s = 0; s < count && total < G_L3_CACHE_SIZE; ++s) {
+        total += slices[s].iov_len;
+    }
+
+    // Fast path for small sizes: the output stays cache resident
+    if (__builtin_expect(total < G_L3_CACHE_SIZE, 1)) {
+        for (std::size_t s = 0; s < count; ++s) {
+            __builtin_memcpy(dest_ptr, slices[s].iov_base, slices[s].iov_len);
+            dest_ptr += slices[s].iov_len;
+        }
+        return total;
+    }
+
+    for (std::size_t s = 0; s < count; ++s) {
+        const auto* __restrict src_ptr = static_cast<const uint8_t*>(slices[s].iov_base);
+        std::size_t size = slices[s].iov_len;
+
+        // Bytes up to the next line boundary are written with regular stores, as are
+        // whole slices too short to be worth streaming
+        std::size_t initial_bytes = (LINE_SIZE - (reinterpret_cast<std::uintptr_t>(dest_ptr) & (LINE_SIZE - 1))) & (LINE_SIZE - 1);
+        if (initial_bytes > size || size < BLOCK_SIZE) initial_bytes = size;
+        __builtin_memcpy(dest_ptr, src_ptr, initial_bytes);
+        dest_ptr += initial_bytes;
+        src_ptr += initial_bytes;
+        size -= initial_bytes;
+        if (size == 0) continue;
+
+        // Stream whole lines of the slice straight to the aligned destination
+        const std::size_t vector_size = size & ~(BLOCK_SIZE - 1);
+        for (std::size_t i = 0; i < vector_size; i += BLOCK_SIZE) {
+            // Prefetch data using NTA (Non-Temporal Access) hint to bypass cache for large transfers
+            for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += G_CACHE_LINE_SIZE) {
+                _mm_prefetch(src_ptr + i + p, _MM_HINT_NTA);
+            }
+            #pragma unroll(UNROLL_FACTOR)
+            for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest_ptr + i + p * ALIGNMENT),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src_ptr + i + p * ALIGNMENT)));
+            }
+        }
+        std::size_t offset = vector_size;
+        for (; offset + LINE_SIZE <= size; offset += LINE_SIZE) {
+            #pragma unroll(LINE_SIZE / ALIGNMENT)
+            for (std::size_t p = 0; p < LINE_SIZE; p += ALIGNMENT) {
+                _mm256_stream_si256(reinterpret_cast<__m256i*>(dest_ptr + offset + p),
+                                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src_ptr + offset + p)));
+            }
+        }
+
+        // The remainder ends mid-line; the next slice continues from there
+        __builtin_memcpy(dest_ptr + offset, src_ptr + offset, size - offset);
+        dest_ptr += size;
+    }
+
+    // Ensure all non-temporal (streaming) stores are visible
+    _mm_sfence();
+
+    return static_cast<std::size_t>(dest_ptr - static_cast<uint8_t*>(dest));
+}
+
+} // namespace omm
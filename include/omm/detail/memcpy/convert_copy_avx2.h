@@ -0,0 +1,284 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <type_traits>
+
+#include "omm/float16.h"
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+// The float16 conversions need F16C, which the build does not enable with AVX2; these
+// kernels are compiled for it and the float16 ones dispatched on a runtime check
+#pragma GCC push_options
+#pragma GCC target("f16c")
+
+namespace omm {
+
+namespace detail {
+
+// Elements per vector step: one 256-bit vector of the wider type
+template <typename From, typename To>
+inline constexpr std::size_t CONVERT_STEP_AVX2 = 32 / (sizeof(From) > sizeof(To) ? sizeof(From) : sizeof(To));
+
+// Loads Bytes (32, 16, 8 or 4) bytes into the narrowest vector that holds them
+template <std::size_t Bytes>
+__attribute__((always_inline))
+inline auto load_chunk_avx2(const void* src) noexcept {
+    if constexpr (Bytes == 32) {
+        return _mm256_loadu_si256(static_cast<const __m256i*>(src));
+    } else if constexpr (Bytes == 16) {
+        return _mm_loadu_si128(static_cast<const __m128i*>(src));
+    } else if constexpr (Bytes == 8) {
+        return _mm_loadl_epi64(static_cast<const __m128i*>(src));
+    } else {
+        int bits;
+        __builtin_memcpy(&bits, src, sizeof(bits));
+        return _mm_cvtsi32_si128(bits);
+    }
+}
+
+// Stores the low Bytes bytes of v; Stream stores need dest aligned to Bytes
+template <std::size_t Bytes, bool Stream, typename Vector>
+__attribute__((always_inline))
+inline void store_chunk_avx2(void* dest, Vector v) noexcept {
+    if constexpr (Bytes == 32) {
+        if constexpr (Stream) _mm256_stream_si256(static_cast<__m256i*>(dest), v);
+        else _mm256_storeu_si256(static_cast<__m256i*>(dest), v);
+    } else if constexpr (Bytes == 16) {
+        if constexpr (Stream) _mm_stream_si128(static_cast<__m128i*>(dest), v);
+        else _mm_storeu_si128(static_cast<__m128i*>(dest), v);
+    } else if constexpr (Bytes == 8) {
+        if constexpr (Stream) _mm_stream_si64(static_cast<long long*>(dest), _mm_cvtsi128_si64(v));
+        else _mm_storel_epi64(static_cast<__m128i*>(dest), v);
+    } else {
+        const int bits = _mm_cvtsi128_si32(v);
+        if constexpr (Stream) _mm_stream_si32(static_cast<int*>(dest), bits);
+        else __builtin_memcpy(dest, &bits, sizeof(bits));
+    }
+}
+
+// Clamps 64-bit lanes to [low, high]; unsigned lanes are compared with their sign bits
+// flipped, as AVX2 has only a signed 64-bit compare
+template <bool Signed>
+__attribute__((always_inline))
+inline __m256i clamp_epi64_avx2(__m256i v, std::int64_t low, std::int64_t high) noexcept {
+    const __m256i flip = _mm256_set1_epi64x(Signed ? 0 : INT64_MIN);
+    const __m256i key = _mm256_xor_si256(v, flip);
+    const __m256i high_key = _mm256_set1_epi64x(high ^ (Signed ? 0 : INT64_MIN));
+    v = _mm256_blendv_epi8(v, _mm256_set1_epi64x(high), _mm256_cmpgt_epi64(key, high_key));
+    if constexpr (Signed) {
+        v = _mm256_blendv_epi8(v, _mm256_set1_epi64x(low), _mm256_cmpgt_epi64(_mm256_set1_epi64x(low), key));
+    }
+    return v;
+}
+
+// Gathers the low doubleword of each 64-bit lane into the low 128 bits
+__attribute__((always_inline))
+inline __m128i pack_low_dwords_avx2(__m256i v) noexcept {
+    return _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6)));
+}
+
+// Converts one step of CONVERT_STEP_AVX2 elements at src, returning the converted
+// elements in the narrowest vector that holds them
+template <typename From, typename To>
+__attribute__((always_inline))
+inline auto convert_chunk_avx2(const From* src) noexcept {
+    static constexpr std::size_t STEP = CONVERT_STEP_AVX2<From, To>;
+
+    if constexpr (std::is_same_v<From, float> && std::is_same_v<To, float16>) {
+        return _mm256_cvtps_ph(_mm256_loadu_ps(src), _MM_FROUND_TO_NEAREST_INT);
+    } else if constexpr (std::is_same_v<From, float16> && std::is_same_v<To, float>) {
+        return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    } else if constexpr (std::is_same_v<From, float> && std::is_same_v<To, bfloat16>) {
+        // Round to nearest even on the bit pattern; NaNs keep their top bits, quieted
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        const __m256i rounded = _mm256_add_epi32(x, _mm256_add_epi32(_mm256_set1_epi32(0x7FFF),
+                                                                     _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1))));
+        const __m256i nan = _mm256_cmpgt_epi32(_mm256_and_si256(x, _mm256_set1_epi32(0x7FFFFFFF)), _mm256_set1_epi32(0x7F800000));
+        const __m256i result = _mm256_blendv_epi8(rounded, _mm256_or_si256(x, _mm256_set1_epi32(0x00400000)), nan);
+        // Upper halves of each doubleword, then the two lanes' halves together
+        const __m256i halves = _mm256_shuffle_epi8(result, _mm256_setr_epi8(2, 3, 6, 7, 10, 11, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                                           2, 3, 6, 7, 10, 11, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+        return _mm256_castsi256_si128(_mm256_permute4x64_epi64(halves, 0x08));
+    } else if constexpr (std::is_same_v<From, bfloat16> && std::is_same_v<To, float>) {
+        return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src))), 16));
+    } else if constexpr (sizeof(From) < sizeof(To)) {
+        // Widening: sign or zero extension of a partial vector
+        const __m128i v = load_chunk_avx2<STEP * sizeof(From)>(src);
+        if constexpr (std::is_signed_v<From>) {
+            if constexpr (sizeof(From) == 1 && sizeof(To) == 2) return _mm256_cvtepi8_epi16(v);
+            else if constexpr (sizeof(From) == 1 && sizeof(To) == 4) return _mm256_cvtepi8_epi32(v);
+            else if constexpr (sizeof(From) == 1) return _mm256_cvtepi8_epi64(v);
+            else if constexpr (sizeof(From) == 2 && sizeof(To) == 4) return _mm256_cvtepi16_epi32(v);
+            else if constexpr (sizeof(From) == 2) return _mm256_cvtepi16_epi64(v);
+            else return _mm256_cvtepi32_epi64(v);
+        } else {
+            if constexpr (sizeof(From) == 1 && sizeof(To) == 2) return _mm256_cvtepu8_epi16(v);
+            else if constexpr (sizeof(From) == 1 && sizeof(To) == 4) return _mm256_cvtepu8_epi32(v);
+            else if constexpr (sizeof(From) == 1) return _mm256_cvtepu8_epi64(v);
+            else if constexpr (sizeof(From) == 2 && sizeof(To) == 4) return _mm256_cvtepu16_epi32(v);
+            else if constexpr (sizeof(From) == 2) return _mm256_cvtepu16_epi64(v);
+            else return _mm256_cvtepu32_epi64(v);
+        }
+    } else {
+        // Narrowing: AVX2 has no saturating vpmov, so 16- and 32-bit lanes use the
+        // saturating packs and 64-bit lanes are clamped first
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        if constexpr (sizeof(From) == 8) {
+            static constexpr bool SIGNED = std::is_signed_v<From>;
+            static constexpr std::int64_t LOW = SIGNED ? -(std::int64_t{1} << (8 * sizeof(To) - 1)) : 0;
+            static constexpr std::int64_t HIGH = SIGNED ? (std::int64_t{1} << (8 * sizeof(To) - 1)) - 1
+                                                        : static_cast<std::int64_t>((std::uint64_t{1} << (8 * sizeof(To))) - 1);
+            const __m128i dwords = pack_low_dwords_avx2(clamp_epi64_avx2<SIGNED>(v, LOW, HIGH));
+            // Lanes are in range, so the packs below only narrow
+            if constexpr (sizeof(To) == 4) return dwords;
+            else if constexpr (sizeof(To) == 2) return SIGNED ? _mm_packs_epi32(dwords, dwords) : _mm_packus_epi32(dwords, dwords);
+            else if constexpr (SIGNED) return _mm_packs_epi16(_mm_packs_epi32(dwords, dwords), dwords);
+            else return _mm_packus_epi16(_mm_packus_epi32(dwords, dwords), dwords);
+        } else if constexpr (std::is_signed_v<From>) {
+            const __m128i low = _mm256_castsi256_si128(v);
+            const __m128i high = _mm256_extracti128_si256(v, 1);
+            if constexpr (sizeof(From) == 2) return _mm_packs_epi16(low, high);
+            else if constexpr (sizeof(To) == 2) return _mm_packs_epi32(low, high);
+            else {
+                const __m128i words = _mm_packs_epi32(low, high);
+                return _mm_packs_epi16(words, words);
+            }
+        } else {
+            // Unsigned: clamp with an unsigned min, after which the signed-input packs are exact
+            if constexpr (sizeof(From) == 2) v = _mm256_min_epu16(v, _mm256_set1_epi16(0xFF));
+            else v = _mm256_min_epu32(v, _mm256_set1_epi32(sizeof(To) == 2 ? 0xFFFF : 0xFF));
+            const __m128i low = _mm256_castsi256_si128(v);
+            const __m128i high = _mm256_extracti128_si256(v, 1);
+            if constexpr (sizeof(From) == 2) return _mm_packus_epi16(low, high);
+            else if constexpr (sizeof(To) == 2) return _mm_packus_epi32(low, high);
+            else {
+                const __m128i words = _mm_packus_epi32(low, high);
+                return _mm_packus_epi16(words, words);
+            }
+        }
+    }
+}
+
+// Converts one step of elements at src and stores the result at dest
+template <typename From, typename To, bool Stream>
+__attribute__((always_inline))
+inline void convert_step_avx2(To* dest, const From* src) noexcept {
+    static constexpr std::size_t STORE_SIZE = CONVERT_STEP_AVX2<From, To> * sizeof(To);
+    const auto v = convert_chunk_avx2<From, To>(src);
+    if constexpr (std::is_same_v<To, float>) {
+        if constexpr (Stream) _mm256_stream_ps(reinterpret_cast<float*>(dest), v);
+        else _mm256_storeu_ps(reinterpret_cast<float*>(dest), v);
+    } else {
+        store_chunk_avx2<STORE_SIZE, Stream>(dest, v);
+    }
+}
+
+// Converts fewer than one step of elements through a zero-padded buffer, so partial
+// steps round and saturate exactly like full ones
+template <typename From, typename To>
+__attribute__((always_inline))
+inline void convert_partial_avx2(To* dest, const From* src, std::size_t count) noexcept {
+    static constexpr std::size_t STEP = CONVERT_STEP_AVX2<From, To>;
+    if (count == 0) return;
+    From in[STEP] = {};
+    To out[STEP];
+    __builtin_memcpy(in, src, count * sizeof(From));
+    convert_step_avx2<From, To, false>(out, in);
+    __builtin_memcpy(dest, out, count * sizeof(To));
+}
+
+} // namespace detail
+
+/**
+ * @brief Converts count elements from src into dest in one pass.
+ *
+ * Structured like memcpy_avx2: each step converts one 256-bit vector of the wider type,
+ * unrolled four times. Outputs of at least the L3 size are aligned, prefetched and
+ * streamed. Partial steps at either end go through a padded buffer.
+ */
+template <typename From, typename To>
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void convert_copy_avx2(To* __restrict dest, const From* __restrict src, std::size_t count) noexcept {
+    static constexpr std::size_t STEP = detail::CONVERT_STEP_AVX2<From, To>;
+    static constexpr std::size_t STORE_SIZE = STEP * sizeof(To);
+    static constexpr std::size_t UNROLL_FACTOR = 4;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = STEP * UNROLL_FACTOR;
+    // Prefetch two blocks ahead - adjust based on target hardware characteristics
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE * sizeof(From);
+
+    std::size_t i = 0;
+    if (__builtin_expect(count * sizeof(To) >= G_L3_CACHE_SIZE && reinterpret_cast<std::uintptr_t>(dest) % sizeof(To) == 0, 0)) {
+        // Align the destination to the store size for the streaming stores
+        const std::size_t misalignment = reinterpret_cast<std::uintptr_t>(dest) & (STORE_SIZE - 1);
+        i = misalignment ? (STORE_SIZE - misalignment) / sizeof(To) : 0;
+        detail::convert_partial_avx2(dest, src, i);
+
+        for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE) {
+            // Prefetch data using NTA (Non-Temporal Access) hint to bypass cache for large transfers
+            for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += G_CACHE_LINE_SIZE) {
+                _mm_prefetch(reinterpret_cast<const char*>(src + i) + p, _MM_HINT_NTA);
+            }
+            #pragma unroll(UNROLL_FACTOR)
+            for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                detail::convert_step_avx2<From, To, true>(dest + i + p * STEP, src + i + p * STEP);
+            }
+        }
+        // Ensure all non-temporal (streaming) stores are visible
+        _mm_sfence();
+    }
+
+    for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE) {
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            detail::convert_step_avx2<From, To, false>(dest + i + p * STEP, src + i + p * STEP);
+        }
+    }
+    for (; i + STEP <= count; i += STEP) {
+        detail::convert_step_avx2<From, To, false>(dest + i, src + i);
+    }
+    detail::convert_partial_avx2(dest + i, src + i, count - i);
+}
+
+} // namespace omm
+
+#pragma GCC pop_options
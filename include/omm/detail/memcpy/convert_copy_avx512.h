@@ -0,0 +1,240 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <type_traits>
+
+#include "omm/float16.h"
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+// The 8-bit <-> 16-bit conversions need AVX-512BW, which the build does not enable with
+// AVX-512F; these kernels are compiled for it and dispatched on a runtime check
+#pragma GCC push_options
+#pragma GCC target("avx512bw")
+
+namespace omm {
+
+namespace detail {
+
+// Elements per vector step: one 512-bit vector of the wider type
+template <typename From, typename To>
+inline constexpr std::size_t CONVERT_STEP_AVX512 = 64 / (sizeof(From) > sizeof(To) ? sizeof(From) : sizeof(To));
+
+// Loads Bytes (64, 32, 16 or 8) bytes into the narrowest vector that holds them. A
+// Masked load reads only the bytes set in mask, zeroes the rest and cannot fault on them.
+template <std::size_t Bytes, bool Masked = false>
+__attribute__((always_inline))
+inline auto load_chunk_avx512(const void* src, std::uint64_t mask = 0) noexcept {
+    if constexpr (Bytes == 64) {
+        if constexpr (Masked) return _mm512_maskz_loadu_epi8(mask, src);
+        else return _mm512_loadu_si512(src);
+    } else if constexpr (Bytes == 32) {
+        if constexpr (Masked) return _mm256_maskz_loadu_epi8(static_cast<__mmask32>(mask), src);
+        else return _mm256_loadu_si256(static_cast<const __m256i*>(src));
+    } else {
+        if constexpr (Masked) return _mm_maskz_loadu_epi8(static_cast<__mmask16>(mask), src);
+        else if constexpr (Bytes == 16) return _mm_loadu_si128(static_cast<const __m128i*>(src));
+        else return _mm_loadl_epi64(static_cast<const __m128i*>(src));
+    }
+}
+
+// Stores the low Bytes bytes of v; Stream stores need dest aligned to Bytes
+template <std::size_t Bytes, bool Stream, typename Vector>
+__attribute__((always_inline))
+inline void store_chunk_avx512(void* dest, Vector v) noexcept {
+    if constexpr (Bytes == 64) {
+        if constexpr (Stream) _mm512_stream_si512(static_cast<__m512i*>(dest), v);
+        else _mm512_storeu_si512(dest, v);
+    } else if constexpr (Bytes == 32) {
+        if constexpr (Stream) _mm256_stream_si256(static_cast<__m256i*>(dest), v);
+        else _mm256_storeu_si256(static_cast<__m256i*>(dest), v);
+    } else if constexpr (Bytes == 16) {
+        if constexpr (Stream) _mm_stream_si128(static_cast<__m128i*>(dest), v);
+        else _mm_storeu_si128(static_cast<__m128i*>(dest), v);
+    } else {
+        if constexpr (Stream) _mm_stream_si64(static_cast<long long*>(dest), _mm_cvtsi128_si64(v));
+        else _mm_storel_epi64(static_cast<__m128i*>(dest), v);
+    }
+}
+
+// Stores the bytes of v, a vector from a Bytes-sized chunk, that are set in mask
+template <std::size_t Bytes, typename Vector>
+__attribute__((always_inline))
+inline void store_chunk_masked_avx512(void* dest, Vector v, std::uint64_t mask) noexcept {
+    if constexpr (Bytes == 64) _mm512_mask_storeu_epi8(dest, mask, v);
+    else if constexpr (Bytes == 32) _mm256_mask_storeu_epi8(dest, static_cast<__mmask32>(mask), v);
+    else _mm_mask_storeu_epi8(dest, static_cast<__mmask16>(mask), v);
+}
+
+// Converts one step of CONVERT_STEP_AVX512 elements, loaded into v by load_chunk_avx512,
+// returning them in the narrowest integer vector that holds them
+template <typename From, typename To, typename Vector>
+__attribute__((always_inline))
+inline auto convert_chunk_avx512(Vector v) noexcept {
+    // Zero-masked conversions and shifts, as the unmasked ones trip -Wmaybe-uninitialized
+    // in GCC's headers; the mask converts to the __mmask type of each intrinsic
+    static constexpr std::uint64_t ALL_LANES = ~std::uint64_t{0} >> (64 - CONVERT_STEP_AVX512<From, To>);
+    if constexpr (std::is_same_v<From, float> && std::is_same_v<To, float16>) {
+        return _mm512_maskz_cvtps_ph(ALL_LANES, _mm512_castsi512_ps(v), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    } else if constexpr (std::is_same_v<From, float16> && std::is_same_v<To, float>) {
+        return _mm512_castps_si512(_mm512_maskz_cvtph_ps(ALL_LANES, v));
+    } else if constexpr (std::is_same_v<From, float> && std::is_same_v<To, bfloat16>) {
+        // Round to nearest even on the bit pattern; NaNs keep their top bits, quieted
+        const __m512i rounded = _mm512_add_epi32(v, _mm512_add_epi32(_mm512_set1_epi32(0x7FFF),
+                                                                     _mm512_and_si512(_mm512_maskz_srli_epi32(ALL_LANES, v, 16), _mm512_set1_epi32(1))));
+        const __mmask16 nan = _mm512_cmpgt_epi32_mask(_mm512_and_si512(v, _mm512_set1_epi32(0x7FFFFFFF)), _mm512_set1_epi32(0x7F800000));
+        const __m512i result = _mm512_mask_or_epi32(rounded, nan, v, _mm512_set1_epi32(0x00400000));
+        return _mm512_maskz_cvtepi32_epi16(ALL_LANES, _mm512_maskz_srli_epi32(ALL_LANES, result, 16));
+    } else if constexpr (std::is_same_v<From, bfloat16> && std::is_same_v<To, float>) {
+        return _mm512_maskz_slli_epi32(ALL_LANES, _mm512_maskz_cvtepu16_epi32(ALL_LANES, v), 16);
+    } else if constexpr (sizeof(From) < sizeof(To)) {
+        // Widening: sign or zero extension of a partial vector
+        if constexpr (std::is_signed_v<From>) {
+            if constexpr (sizeof(From) == 1 && sizeof(To) == 2) return _mm512_maskz_cvtepi8_epi16(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 1 && sizeof(To) == 4) return _mm512_maskz_cvtepi8_epi32(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 1) return _mm512_maskz_cvtepi8_epi64(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 2 && sizeof(To) == 4) return _mm512_maskz_cvtepi16_epi32(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 2) return _mm512_maskz_cvtepi16_epi64(ALL_LANES, v);
+            else return _mm512_maskz_cvtepi32_epi64(ALL_LANES, v);
+        } else {
+            if constexpr (sizeof(From) == 1 && sizeof(To) == 2) return _mm512_maskz_cvtepu8_epi16(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 1 && sizeof(To) == 4) return _mm512_maskz_cvtepu8_epi32(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 1) return _mm512_maskz_cvtepu8_epi64(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 2 && sizeof(To) == 4) return _mm512_maskz_cvtepu16_epi32(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 2) return _mm512_maskz_cvtepu16_epi64(ALL_LANES, v);
+            else return _mm512_maskz_cvtepu32_epi64(ALL_LANES, v);
+        }
+    } else {
+        // Narrowing: vpmov with signed or unsigned saturation
+        if constexpr (std::is_signed_v<From>) {
+            if constexpr (sizeof(From) == 2) return _mm512_maskz_cvtsepi16_epi8(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 4 && sizeof(To) == 1) return _mm512_maskz_cvtsepi32_epi8(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 4) return _mm512_maskz_cvtsepi32_epi16(ALL_LANES, v);
+            else if constexpr (sizeof(To) == 1) return _mm512_maskz_cvtsepi64_epi8(ALL_LANES, v);
+            else if constexpr (sizeof(To) == 2) return _mm512_maskz_cvtsepi64_epi16(ALL_LANES, v);
+            else return _mm512_maskz_cvtsepi64_epi32(ALL_LANES, v);
+        } else {
+            if constexpr (sizeof(From) == 2) return _mm512_maskz_cvtusepi16_epi8(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 4 && sizeof(To) == 1) return _mm512_maskz_cvtusepi32_epi8(ALL_LANES, v);
+            else if constexpr (sizeof(From) == 4) return _mm512_maskz_cvtusepi32_epi16(ALL_LANES, v);
+            else if constexpr (sizeof(To) == 1) return _mm512_maskz_cvtusepi64_epi8(ALL_LANES, v);
+            else if constexpr (sizeof(To) == 2) return _mm512_maskz_cvtusepi64_epi16(ALL_LANES, v);
+            else return _mm512_maskz_cvtusepi64_epi32(ALL_LANES, v);
+        }
+    }
+}
+
+// Converts one step of elements at src and stores the result at dest
+template <typename From, typename To, bool Stream>
+__attribute__((always_inline))
+inline void convert_step_avx512(To* dest, const From* src) noexcept {
+    static constexpr std::size_t STEP = CONVERT_STEP_AVX512<From, To>;
+    store_chunk_avx512<STEP * sizeof(To), Stream>(dest, convert_chunk_avx512<From, To>(load_chunk_avx512<STEP * sizeof(From)>(src)));
+}
+
+// Converts fewer than one step of elements with masked loads and stores, so partial
+// steps round and saturate exactly like full ones
+template <typename From, typename To>
+__attribute__((always_inline))
+inline void convert_partial_avx512(To* dest, const From* src, std::size_t count) noexcept {
+    static constexpr std::size_t STEP = CONVERT_STEP_AVX512<From, To>;
+    if (count == 0) return;
+    const std::uint64_t src_mask = ~std::uint64_t{0} >> (64 - count * sizeof(From));
+    const std::uint64_t dest_mask = ~std::uint64_t{0} >> (64 - count * sizeof(To));
+    store_chunk_masked_avx512<STEP * sizeof(To)>(dest, convert_chunk_avx512<From, To>(load_chunk_avx512<STEP * sizeof(From), true>(src, src_mask)), dest_mask);
+}
+
+} // namespace detail
+
+/**
+ * @brief Converts count elements from src into dest in one pass.
+ *
+ * Structured like memcpy_avx512: each step converts one 512-bit vector of the wider type,
+ * unrolled four times. Outputs of at least the L3 size are aligned, prefetched and
+ * streamed. Partial steps at either end use masked loads and stores.
+ */
+template <typename From, typename To>
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void convert_copy_avx512(To* __restrict dest, const From* __restrict src, std::size_t count) noexcept {
+    static constexpr std::size_t STEP = detail::CONVERT_STEP_AVX512<From, To>;
+    static constexpr std::size_t STORE_SIZE = STEP * sizeof(To);
+    static constexpr std::size_t UNROLL_FACTOR = 4;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = STEP * UNROLL_FACTOR;
+    // Prefetch two blocks ahead - adjust based on target hardware characteristics
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE * sizeof(From);
+
+    std::size_t i = 0;
+    if (__builtin_expect(count * sizeof(To) >= G_L3_CACHE_SIZE && reinterpret_cast<std::uintptr_t>(dest) % sizeof(To) == 0, 0)) {
+        // Align the destination to the store size for the streaming stores
+        const std::size_t misalignment = reinterpret_cast<std::uintptr_t>(dest) & (STORE_SIZE - 1);
+        i = misalignment ? (STORE_SIZE - misalignment) / sizeof(To) : 0;
+        detail::convert_partial_avx512(dest, src, i);
+
+        for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE) {
+            // Prefetch data using NTA (Non-Temporal Access) hint to bypass cache for large transfers
+            for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += G_CACHE_LINE_SIZE) {
+                _mm_prefetch(reinterpret_cast<const char*>(src + i) + p, _MM_HINT_NTA);
+            }
+            #pragma unroll(UNROLL_FACTOR)
+            for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                detail::convert_step_avx512<From, To, true>(dest + i + p * STEP, src + i + p * STEP);
+            }
+        }
+        // Ensure all non-temporal (streaming) stores are visible
+        _mm_sfence();
+    }
+
+    for (; i + BLOCK_SIZE <= count; i += BLOCK_SIZE) {
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            detail::convert_step_avx512<From, To, false>(dest + i + p * STEP, src + i + p * STEP);
+        }
+    }
+    for (; i + STEP <= count; i += STEP) {
+        detail::convert_step_avx512<From, To, false>(dest + i, src + i);
+    }
+    detail::convert_partial_avx512(dest + i, src + i, count - i);
+}
+
+} // namespace omm
+
+#pragma GCC pop_options
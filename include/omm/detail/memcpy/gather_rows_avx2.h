@@ -0,0 +1,178 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#include "omm/detail/memcpy/memcpy_fixed.h"
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+// Scatter prefetches rows for ownership with prefetchw. CPUs without PRFCHW decode it as
+// a NOP, so it needs no runtime check.
+#pragma GCC push_options
+#pragma GCC target("prfchw")
+
+namespace omm {
+
+namespace detail {
+
+// Rows ahead of the copy whose lines are prefetched through the index stream, enough to
+// keep a DRAM latency's worth of misses in flight
+inline constexpr std::size_t GATHER_PREFETCH_ROWS_AVX2 = 16;
+
+// Prefetches every line of a Width-byte row, including the line a misaligned row spills into
+template <std::size_t Width, bool Write>
+__attribute__((always_inline))
+inline void prefetch_row_avx2(const uint8_t* row) noexcept {
+    for (std::size_t offset = 0; offset < Width; offset += G_CACHE_LINE_SIZE) {
+        __builtin_prefetch(row + offset, Write, 3);
+    }
+    if constexpr (Width > 8) __builtin_prefetch(row + Width - 1, Write, 3);
+}
+
+// Copies one Width-byte row; Stream stores need dest aligned to the smaller of Width and 32
+template <std::size_t Width, bool Stream>
+__attribute__((always_inline))
+inline void copy_row_avx2(uint8_t* dest, const uint8_t* src) noexcept {
+    if constexpr (!Stream) {
+        memcpy_fixed<Width>(dest, src);
+    } else if constexpr (Width == 8) {
+        long long row;
+        __builtin_memcpy(&row, src, sizeof(row));
+        _mm_stream_si64(reinterpret_cast<long long*>(dest), row);
+    } else if constexpr (Width == 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(dest), _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+    } else {
+        for (std::size_t offset = 0; offset < Width; offset += 32) {
+            _mm256_stream_si256(reinterpret_cast<__m256i*>(dest + offset), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + offset)));
+        }
+    }
+}
+
+// Gathers rows [i, count), prefetching the row GATHER_PREFETCH_ROWS_AVX2 ahead of each copy
+template <std::size_t Width, bool Stream, typename Index>
+__attribute__((always_inline))
+inline void gather_rows_loop_avx2(uint8_t* dest, const uint8_t* table, const Index* indices, std::size_t i, std::size_t count) noexcept {
+    for (; i + GATHER_PREFETCH_ROWS_AVX2 < count; ++i) {
+        prefetch_row_avx2<Width, false>(table + static_cast<std::size_t>(indices[i + GATHER_PREFETCH_ROWS_AVX2]) * Width);
+        copy_row_avx2<Width, Stream>(dest + i * Width, table + static_cast<std::size_t>(indices[i]) * Width);
+    }
+    for (; i < count; ++i) {
+        copy_row_avx2<Width, Stream>(dest + i * Width, table + static_cast<std::size_t>(indices[i]) * Width);
+    }
+}
+
+// Scatters rows [0, count); streamed rows skip the prefetch, as they need no read for ownership
+template <std::size_t Width, bool Stream, typename Index>
+__attribute__((always_inline))
+inline void scatter_rows_loop_avx2(uint8_t* table, const uint8_t* src, const Index* indices, std::size_t count) noexcept {
+    std::size_t i = 0;
+    if constexpr (!Stream) {
+        for (; i + GATHER_PREFETCH_ROWS_AVX2 < count; ++i) {
+            prefetch_row_avx2<Width, true>(table + static_cast<std::size_t>(indices[i + GATHER_PREFETCH_ROWS_AVX2]) * Width);
+            copy_row_avx2<Width, false>(table + static_cast<std::size_t>(indices[i]) * Width, src + i * Width);
+        }
+    }
+    for (; i < count; ++i) {
+        copy_row_avx2<Width, Stream>(table + static_cast<std::size_t>(indices[i]) * Width, src + i * Width);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Copies row indices[i] of table to row i of dest, for count Width-byte rows.
+ *
+ * Each row is copied with straight-line moves while the row GATHER_PREFETCH_ROWS_AVX2 ahead
+ * in the index stream is prefetched, so many misses are in flight at once. Outputs of
+ * at least the L3 size are streamed from the first row aligned to the store width.
+ */
+template <std::size_t Width, typename Index>
+__attribute__((hot, nonnull(1, 2)))
+inline void gather_rows_avx2(void* __restrict dest, const void* __restrict table, const Index* __restrict indices, std::size_t count) noexcept {
+    static constexpr std::size_t STORE_SIZE = Width < 32 ? Width : 32;
+    auto* dest_ptr = static_cast<uint8_t*>(dest);
+    const auto* table_ptr = static_cast<const uint8_t*>(table);
+
+    std::size_t i = 0;
+    if (__builtin_expect(count * Width >= G_L3_CACHE_SIZE, 0)) {
+        // Rows before the first aligned one, if dest reaches alignment at all, are copied normally
+        for (; i < STORE_SIZE / Width && reinterpret_cast<std::uintptr_t>(dest_ptr + i * Width) % STORE_SIZE != 0; ++i) {
+            detail::copy_row_avx2<Width, false>(dest_ptr + i * Width, table_ptr + static_cast<std::size_t>(indices[i]) * Width);
+        }
+        if (reinterpret_cast<std::uintptr_t>(dest_ptr + i * Width) % STORE_SIZE == 0) {
+            detail::gather_rows_loop_avx2<Width, true>(dest_ptr, table_ptr, indices, i, count);
+            // Ensure all non-temporal (streaming) stores are visible
+            _mm_sfence();
+            return;
+        }
+    }
+    detail::gather_rows_loop_avx2<Width, false>(dest_ptr, table_ptr, indices, i, count);
+}
+
+/**
+ * @brief Copies row i of src to row indices[i] of table, for count Width-byte rows.
+ *
+ * Rows are written in order, so a repeated index keeps its last row. Target rows are
+ * prefetched for ownership through the index stream. Rows of whole cache lines are
+ * streamed instead when the output is at least the L3 size and the table is line
+ * aligned.
+ */
+template <std::size_t Width, typename Index>
+__attribute__((hot, nonnull(1, 2)))
+inline void scatter_rows_avx2(void* __restrict table, const void* __restrict src, const Index* __restrict indices, std::size_t count) noexcept {
+    auto* table_ptr = static_cast<uint8_t*>(table);
+    const auto* src_ptr = static_cast<const uint8_t*>(src);
+
+    if constexpr (Width % 64 == 0) {
+        if (__builtin_expect(count * Width >= G_L3_CACHE_SIZE && reinterpret_cast<std::uintptr_t>(table) % 64 == 0, 0)) {
+            detail::scatter_rows_loop_avx2<Width, true>(table_ptr, src_ptr, indices, count);
+            // Ensure all non-temporal (streaming) stores are visible
+            _mm_sfence();
+            return;
+        }
+    }
+    detail::scatter_rows_loop_avx2<Width, false>(table_ptr, src_ptr, indices, count);
+}
+
+} // namespace omm
+
+#pragma GCC pop_options
@@ -0,0 +1,275 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <utility>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Frames per block: one 256-bit vector of each plane
+template <typename T>
+inline constexpr std::size_t INTERLEAVE_BLOCK_AVX2 = 32 / sizeof(T);
+
+// A vpshufb mask, the same in both 128-bit lanes. Both directions treat a block as two
+// regions, one per lane: 16 bytes of each plane and the 16 * Channels interleaved bytes
+// they form, so one in-lane shuffle serves both regions.
+using ShuffleMaskAVX2 = std::array<std::int8_t, 32>;
+
+// Selects the bytes of plane c (out of its 16 in a region) that belong in chunk k of the
+// region's interleaved bytes
+template <std::size_t Channels, std::size_t Width>
+consteval ShuffleMaskAVX2 interleave_mask_avx2(std::size_t k, std::size_t c) {
+    ShuffleMaskAVX2 mask{};
+    for (std::size_t i = 0; i < 16; ++i) {
+        const std::size_t position = 16 * k + i;
+        const std::size_t element = position / Width;
+        const bool selected = element % Channels == c;
+        mask[i] = mask[i + 16] = selected ? static_cast<std::int8_t>(element / Channels * Width + position % Width) : -128;
+    }
+    return mask;
+}
+
+// Selects the bytes of chunk k of a region's interleaved bytes that belong to plane c
+template <std::size_t Channels, std::size_t Width>
+consteval ShuffleMaskAVX2 deinterleave_mask_avx2(std::size_t c, std::size_t k) {
+    ShuffleMaskAVX2 mask{};
+    for (std::size_t i = 0; i < 16; ++i) {
+        const std::size_t position = (i / Width * Channels + c) * Width + i % Width;
+        mask[i] = mask[i + 16] = position / 16 == k ? static_cast<std::int8_t>(position % 16) : -128;
+    }
+    return mask;
+}
+
+// ORs the bytes of v that Mask selects into acc; masks selecting nothing compile away
+template <ShuffleMaskAVX2 Mask>
+__attribute__((always_inline))
+inline __m256i or_shuffle_avx2(__m256i acc, __m256i v) noexcept {
+    constexpr bool SELECTS_ANY = [] {
+        for (std::int8_t index : Mask) {
+            if (index >= 0) return true;
+        }
+        return false;
+    }();
+    if constexpr (!SELECTS_ANY) return acc;
+    else return _mm256_or_si256(acc, _mm256_shuffle_epi8(v, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Mask.data()))));
+}
+
+template <bool Stream>
+__attribute__((always_inline))
+inline void store_avx2(void* dest, __m256i v) noexcept {
+    if constexpr (Stream) _mm256_stream_si256(static_cast<__m256i*>(dest), v);
+    else _mm256_storeu_si256(static_cast<__m256i*>(dest), v);
+}
+
+// Chunk K of both regions' interleaved bytes, one per lane
+template <std::size_t Channels, std::size_t Width, std::size_t K, std::size_t... C>
+__attribute__((always_inline))
+inline __m256i interleave_chunk_avx2(const __m256i* planes, std::index_sequence<C...>) noexcept {
+    __m256i chunk = _mm256_setzero_si256();
+    ((chunk = or_shuffle_avx2<interleave_mask_avx2<Channels, Width>(K, C)>(chunk, planes[C])), ...);
+    return chunk;
+}
+
+// Interleaves one block of frames from planes at frame i into dest
+template <std::size_t Channels, typename T, bool Stream, std::size_t... K>
+__attribute__((always_inline))
+inline void interleave_block_avx2(T* dest, const T* const* planes, std::size_t i, std::index_sequence<K...> channels) noexcept {
+    const __m256i in[] = {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(planes[K] + i))...};
+    const __m256i chunks[] = {interleave_chunk_avx2<Channels, sizeof(T), K>(in, channels)...};
+    // Output vector K holds interleaved chunks 2K and 2K + 1 of the block, where chunk q
+    // is lane q / Channels of chunks[q % Channels]
+    (store_avx2<Stream>(reinterpret_cast<char*>(dest) + 32 * K,
+                        _mm256_permute2x128_si256(chunks[2 * K % Channels], chunks[(2 * K + 1) % Channels],
+                                                  2 * K / Channels | (2 + (2 * K + 1) / Channels) << 4)), ...);
+}
+
+// Plane C's 32 bytes of the block, from both regions' chunks
+template <std::size_t Channels, std::size_t Width, std::size_t C, std::size_t... K>
+__attribute__((always_inline))
+inline __m256i deinterleave_plane_avx2(const __m256i* chunks, std::index_sequence<K...>) noexcept {
+    __m256i plane = _mm256_setzero_si256();
+    ((plane = or_shuffle_avx2<deinterleave_mask_avx2<Channels, Width>(C, K)>(plane, chunks[K])), ...);
+    return plane;
+}
+
+// Deinterleaves one block of frames from src into planes at frame i
+template <std::size_t Channels, typename T, bool Stream, std::size_t... K>
+__attribute__((always_inline))
+inline void deinterleave_block_avx2(T* const* planes, std::size_t i, const T* src, std::index_sequence<K...> channels) noexcept {
+    const __m256i in[] = {_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src) + K)...};
+    // Chunk K of both regions: block chunks K and Channels + K, regrouped into one vector
+    const __m256i chunks[] = {_mm256_permute2x128_si256(in[K / 2], in[(Channels + K) / 2],
+                                                        K % 2 | (2 + (Channels + K) % 2) << 4)...};
+    (store_avx2<Stream>(planes[K] + i, deinterleave_plane_avx2<Channels, sizeof(T), K>(chunks, channels)), ...);
+}
+
+// Interleaves fewer than one block of frames through padded buffers
+template <std::size_t Channels, typename T>
+__attribute__((always_inline))
+inline void interleave_partial_avx2(T* dest, const T* const* planes, std::size_t i, std::size_t count) noexcept {
+    static constexpr std::size_t BLOCK = INTERLEAVE_BLOCK_AVX2<T>;
+    if (count == 0) return;
+    T in[Channels][BLOCK] = {};
+    const T* in_planes[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) {
+        __builtin_memcpy(in[c], planes[c] + i, count * sizeof(T));
+        in_planes[c] = in[c];
+    }
+    T out[Channels * BLOCK];
+    interleave_block_avx2<Channels, T, false>(out, in_planes, 0, std::make_index_sequence<Channels>{});
+    __builtin_memcpy(dest, out, count * Channels * sizeof(T));
+}
+
+// Deinterleaves fewer than one block of frames through padded buffers
+template <std::size_t Channels, typename T>
+__attribute__((always_inline))
+inline void deinterleave_partial_avx2(T* const* planes, std::size_t i, const T* src, std::size_t count) noexcept {
+    static constexpr std::size_t BLOCK = INTERLEAVE_BLOCK_AVX2<T>;
+    if (count == 0) return;
+    T in[Channels * BLOCK] = {};
+    __builtin_memcpy(in, src, count * Channels * sizeof(T));
+    T out[Channels][BLOCK];
+    T* out_planes[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) out_planes[c] = out[c];
+    deinterleave_block_avx2<Channels, T, false>(out_planes, 0, in, std::make_index_sequence<Channels>{});
+    for (std::size_t c = 0; c < Channels; ++c) {
+        __builtin_memcpy(planes[c] + i, out[c], count * sizeof(T));
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Interleaves frames frames from Channels planes into dest.
+ *
+ * Each block of frames loads one vector per plane and forms Channels output vectors
+ * with in-lane vpshufb masks fixed at compile time, then a lane permute each. Outputs of
+ * at least the L3 size are streamed once dest reaches a 32-byte aligned frame. The last
+ * partial block goes through padded buffers.
+ */
+template <std::size_t Channels, typename T>
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void interleave_avx2(T* __restrict dest, const T* const* planes, std::size_t frames) noexcept {
+    static constexpr std::size_t BLOCK = detail::INTERLEAVE_BLOCK_AVX2<T>;
+    static constexpr auto CHANNELS = std::make_index_sequence<Channels>{};
+    // Prefetch four cache lines ahead on every plane
+    static constexpr std::size_t PREFETCH_DISTANCE = 4 * G_CACHE_LINE_SIZE / sizeof(T);
+
+    // Local copy, so stores through dest cannot force the plane pointers to be reloaded
+    const T* sources[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) sources[c] = planes[c];
+
+    std::size_t i = 0;
+    if (__builtin_expect(frames * Channels * sizeof(T) >= G_L3_CACHE_SIZE, 0)) {
+        // Frame sizes sharing a factor with 32 reach an aligned frame only from some offsets
+        std::size_t prologue = 0;
+        while (prologue < BLOCK && reinterpret_cast<std::uintptr_t>(dest + prologue * Channels) % 32 != 0) ++prologue;
+        if (prologue < BLOCK) {
+            detail::interleave_partial_avx2<Channels>(dest, sources, 0, prologue);
+            for (i = prologue; i + BLOCK <= frames; i += BLOCK) {
+                for (std::size_t c = 0; c < Channels; ++c) {
+                    _mm_prefetch(reinterpret_cast<const char*>(sources[c] + i + PREFETCH_DISTANCE), _MM_HINT_NTA);
+                }
+                detail::interleave_block_avx2<Channels, T, true>(dest + i * Channels, sources, i, CHANNELS);
+            }
+            // Ensure all non-temporal (streaming) stores are visible
+            _mm_sfence();
+        }
+    }
+
+    for (; i + BLOCK <= frames; i += BLOCK) {
+        detail::interleave_block_avx2<Channels, T, false>(dest + i * Channels, sources, i, CHANNELS);
+    }
+    detail::interleave_partial_avx2<Channels>(dest + i * Channels, sources, i, frames - i);
+}
+
+/**
+ * @brief Deinterleaves frames frames from src into Channels planes.
+ *
+ * The inverse of interleave_avx2: each block regroups Channels input vectors by lane
+ * and gathers every plane's vector with compile-time vpshufb masks. Outputs of at least
+ * the L3 size are streamed when all planes reach 32-byte alignment at the same frame.
+ */
+template <std::size_t Channels, typename T>
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void deinterleave_avx2(T* const* planes, const T* __restrict src, std::size_t frames) noexcept {
+    static constexpr std::size_t BLOCK = detail::INTERLEAVE_BLOCK_AVX2<T>;
+    static constexpr auto CHANNELS = std::make_index_sequence<Channels>{};
+    // Prefetch four cache lines ahead
+    static constexpr std::size_t PREFETCH_DISTANCE = 4 * G_CACHE_LINE_SIZE / sizeof(T);
+
+    T* targets[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) targets[c] = planes[c];
+
+    std::size_t i = 0;
+    if (__builtin_expect(frames * Channels * sizeof(T) >= G_L3_CACHE_SIZE, 0)) {
+        const auto misalignment = [&](std::size_t frame) {
+            std::uintptr_t bits = 0;
+            for (std::size_t c = 0; c < Channels; ++c) bits |= reinterpret_cast<std::uintptr_t>(targets[c] + frame) % 32;
+            return bits;
+        };
+        std::size_t prologue = 0;
+        while (prologue < BLOCK && misalignment(prologue) != 0) ++prologue;
+        if (prologue < BLOCK) {
+            detail::deinterleave_partial_avx2<Channels>(targets, 0, src, prologue);
+            for (i = prologue; i + BLOCK <= frames; i += BLOCK) {
+                for (std::size_t p = 0; p < Channels * sizeof(T) * BLOCK; p += G_CACHE_LINE_SIZE) {
+                    _mm_prefetch(reinterpret_cast<const char*>(src + (i + PREFETCH_DISTANCE) * Channels) + p, _MM_HINT_NTA);
+                }
+                detail::deinterleave_block_avx2<Channels, T, true>(targets, i, src + i * Channels, CHANNELS);
+            }
+            // Ensure all non-temporal (streaming) stores are visible
+            _mm_sfence();
+        }
+    }
+
+    for (; i + BLOCK <= frames; i += BLOCK) {
+        detail::deinterleave_block_avx2<Channels, T, false>(targets, i, src + i * Channels, CHANNELS);
+    }
+    detail::deinterleave_partial_avx2<Channels>(targets, i, src + i * Channels, frames - i);
+}
+
+} // namespace omm
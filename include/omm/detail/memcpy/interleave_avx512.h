@@ -0,0 +1,280 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <type_traits>
+#include <utility>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+// The byte and word permutes need AVX-512 VBMI and BW, which the build does not enable
+// with AVX-512F; these kernels are compiled for them and dispatched on runtime checks
+#pragma GCC push_options
+#pragma GCC target("avx512bw,avx512vbmi")
+
+namespace omm {
+
+namespace detail {
+
+// Frames per block: one 512-bit vector of each plane
+template <typename T>
+inline constexpr std::size_t INTERLEAVE_BLOCK_AVX512 = 64 / sizeof(T);
+
+// One merge-masked vpermb, vpermw or vpermd: element e of the result, when bit e of mask
+// is set, is element index[e] of the permuted vector
+template <typename T>
+struct PermuteStepAVX512 {
+    using Index = std::conditional_t<sizeof(T) == 1, std::uint8_t, std::conditional_t<sizeof(T) == 2, std::uint16_t, std::uint32_t>>;
+
+    std::array<Index, INTERLEAVE_BLOCK_AVX512<T>> index{};
+    std::uint64_t mask = 0;
+};
+
+// Places the elements of plane c that belong in output vector j of a block
+template <std::size_t Channels, typename T>
+consteval PermuteStepAVX512<T> interleave_step_avx512(std::size_t j, std::size_t c) {
+    PermuteStepAVX512<T> step;
+    for (std::size_t e = 0; e < INTERLEAVE_BLOCK_AVX512<T>; ++e) {
+        const std::size_t element = j * INTERLEAVE_BLOCK_AVX512<T> + e;
+        if (element % Channels == c) {
+            step.index[e] = static_cast<typename PermuteStepAVX512<T>::Index>(element / Channels);
+            step.mask |= std::uint64_t{1} << e;
+        }
+    }
+    return step;
+}
+
+// Places the elements of input vector k of a block that belong to plane c
+template <std::size_t Channels, typename T>
+consteval PermuteStepAVX512<T> deinterleave_step_avx512(std::size_t c, std::size_t k) {
+    PermuteStepAVX512<T> step;
+    for (std::size_t e = 0; e < INTERLEAVE_BLOCK_AVX512<T>; ++e) {
+        const std::size_t element = e * Channels + c;
+        if (element / INTERLEAVE_BLOCK_AVX512<T> == k) {
+            step.index[e] = static_cast<typename PermuteStepAVX512<T>::Index>(element % INTERLEAVE_BLOCK_AVX512<T>);
+            step.mask |= std::uint64_t{1} << e;
+        }
+    }
+    return step;
+}
+
+// Merges the elements of v that Step selects into acc; steps selecting nothing compile away
+template <typename T, PermuteStepAVX512<T> Step>
+__attribute__((always_inline))
+inline __m512i merge_permute_avx512(__m512i acc, __m512i v) noexcept {
+    if constexpr (Step.mask == 0) {
+        return acc;
+    } else {
+        const __m512i index = _mm512_loadu_si512(Step.index.data());
+        if constexpr (sizeof(T) == 1) return _mm512_mask_permutexvar_epi8(acc, Step.mask, index, v);
+        else if constexpr (sizeof(T) == 2) return _mm512_mask_permutexvar_epi16(acc, static_cast<__mmask32>(Step.mask), index, v);
+        else return _mm512_mask_permutexvar_epi32(acc, static_cast<__mmask16>(Step.mask), index, v);
+    }
+}
+
+// Mask of the first bytes bytes of a vector, none when bytes is not positive
+__attribute__((always_inline))
+inline __mmask64 byte_mask_avx512(std::ptrdiff_t bytes) noexcept {
+    if (bytes <= 0) return 0;
+    return bytes >= 64 ? ~__mmask64{0} : (__mmask64{1} << bytes) - 1;
+}
+
+template <bool Stream>
+__attribute__((always_inline))
+inline void store_avx512(void* dest, __m512i v) noexcept {
+    if constexpr (Stream) _mm512_stream_si512(static_cast<__m512i*>(dest), v);
+    else _mm512_storeu_si512(dest, v);
+}
+
+// Output vector J of a block, from the block's plane vectors
+template <std::size_t Channels, typename T, std::size_t J, std::size_t... C>
+__attribute__((always_inline))
+inline __m512i interleave_vector_avx512(const __m512i* planes, std::index_sequence<C...>) noexcept {
+    __m512i out = _mm512_setzero_si512();
+    ((out = merge_permute_avx512<T, interleave_step_avx512<Channels, T>(J, C)>(out, planes[C])), ...);
+    return out;
+}
+
+// Plane C's vector of a block, from the block's input vectors
+template <std::size_t Channels, typename T, std::size_t C, std::size_t... K>
+__attribute__((always_inline))
+inline __m512i deinterleave_vector_avx512(const __m512i* in, std::index_sequence<K...>) noexcept {
+    __m512i plane = _mm512_setzero_si512();
+    ((plane = merge_permute_avx512<T, deinterleave_step_avx512<Channels, T>(C, K)>(plane, in[K])), ...);
+    return plane;
+}
+
+// Interleaves one block of frames from planes at frame i into dest
+template <std::size_t Channels, typename T, bool Stream, std::size_t... K>
+__attribute__((always_inline))
+inline void interleave_block_avx512(T* dest, const T* const* planes, std::size_t i, std::index_sequence<K...> channels) noexcept {
+    const __m512i in[] = {_mm512_loadu_si512(planes[K] + i)...};
+    (store_avx512<Stream>(reinterpret_cast<char*>(dest) + 64 * K, interleave_vector_avx512<Channels, T, K>(in, channels)), ...);
+}
+
+// Interleaves fewer than one block of frames with masked loads and stores
+template <std::size_t Channels, typename T, std::size_t... K>
+__attribute__((always_inline))
+inline void interleave_partial_avx512(T* dest, const T* const* planes, std::size_t i, std::size_t count, std::index_sequence<K...> channels) noexcept {
+    if (count == 0) return;
+    const __mmask64 load_mask = byte_mask_avx512(static_cast<std::ptrdiff_t>(count * sizeof(T)));
+    const __m512i in[] = {_mm512_maskz_loadu_epi8(load_mask, planes[K] + i)...};
+    const auto bytes = static_cast<std::ptrdiff_t>(count * Channels * sizeof(T));
+    (_mm512_mask_storeu_epi8(reinterpret_cast<char*>(dest) + 64 * K, byte_mask_avx512(bytes - 64 * static_cast<std::ptrdiff_t>(K)),
+                             interleave_vector_avx512<Channels, T, K>(in, channels)), ...);
+}
+
+// Deinterleaves one block of frames from src into planes at frame i
+template <std::size_t Channels, typename T, bool Stream, std::size_t... K>
+__attribute__((always_inline))
+inline void deinterleave_block_avx512(T* const* planes, std::size_t i, const T* src, std::index_sequence<K...> channels) noexcept {
+    const __m512i in[] = {_mm512_loadu_si512(reinterpret_cast<const char*>(src) + 64 * K)...};
+    (store_avx512<Stream>(planes[K] + i, deinterleave_vector_avx512<Channels, T, K>(in, channels)), ...);
+}
+
+// Deinterleaves fewer than one block of frames with masked loads and stores
+template <std::size_t Channels, typename T, std::size_t... K>
+__attribute__((always_inline))
+inline void deinterleave_partial_avx512(T* const* planes, std::size_t i, const T* src, std::size_t count, std::index_sequence<K...> channels) noexcept {
+    if (count == 0) return;
+    const auto bytes = static_cast<std::ptrdiff_t>(count * Channels * sizeof(T));
+    const __m512i in[] = {_mm512_maskz_loadu_epi8(byte_mask_avx512(bytes - 64 * static_cast<std::ptrdiff_t>(K)),
+                                                  reinterpret_cast<const char*>(src) + 64 * K)...};
+    const __mmask64 store_mask = byte_mask_avx512(static_cast<std::ptrdiff_t>(count * sizeof(T)));
+    (_mm512_mask_storeu_epi8(planes[K] + i, store_mask, deinterleave_vector_avx512<Channels, T, K>(in, channels)), ...);
+}
+
+} // namespace detail
+
+/**
+ * @brief Interleaves frames frames from Channels planes into dest.
+ *
+ * Each block of frames loads one vector per plane, and each of the Channels output
+ * vectors merges its elements from every plane with compile-time vpermb, vpermw or
+ * vpermd steps. Outputs of at least the L3 size are streamed once dest reaches a 64-byte
+ * aligned frame. Partial blocks use masked loads and stores.
+ */
+template <std::size_t Channels, typename T>
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void interleave_avx512(T* __restrict dest, const T* const* planes, std::size_t frames) noexcept {
+    static constexpr std::size_t BLOCK = detail::INTERLEAVE_BLOCK_AVX512<T>;
+    static constexpr auto CHANNELS = std::make_index_sequence<Channels>{};
+    // Prefetch four cache lines ahead on every plane
+    static constexpr std::size_t PREFETCH_DISTANCE = 4 * G_CACHE_LINE_SIZE / sizeof(T);
+
+    // Local copy, so stores through dest cannot force the plane pointers to be reloaded
+    const T* sources[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) sources[c] = planes[c];
+
+    std::size_t i = 0;
+    if (__builtin_expect(frames * Channels * sizeof(T) >= G_L3_CACHE_SIZE, 0)) {
+        // Frame sizes sharing a factor with 64 reach an aligned frame only from some offsets
+        std::size_t prologue = 0;
+        while (prologue < BLOCK && reinterpret_cast<std::uintptr_t>(dest + prologue * Channels) % 64 != 0) ++prologue;
+        if (prologue < BLOCK) {
+            detail::interleave_partial_avx512<Channels>(dest, sources, 0, prologue, CHANNELS);
+            for (i = prologue; i + BLOCK <= frames; i += BLOCK) {
+                for (std::size_t c = 0; c < Channels; ++c) {
+                    _mm_prefetch(reinterpret_cast<const char*>(sources[c] + i + PREFETCH_DISTANCE), _MM_HINT_NTA);
+                }
+                detail::interleave_block_avx512<Channels, T, true>(dest + i * Channels, sources, i, CHANNELS);
+            }
+            // Ensure all non-temporal (streaming) stores are visible
+            _mm_sfence();
+        }
+    }
+
+    for (; i + BLOCK <= frames; i += BLOCK) {
+        detail::interleave_block_avx512<Channels, T, false>(dest + i * Channels, sources, i, CHANNELS);
+    }
+    detail::interleave_partial_avx512<Channels>(dest + i * Channels, sources, i, frames - i, CHANNELS);
+}
+
+/**
+ * @brief Deinterleaves frames frames from src into Channels planes.
+ *
+ * The inverse of interleave_avx512: each plane's vector merges its elements from the
+ * block's Channels input vectors. Outputs of at least the L3 size are streamed when all
+ * planes reach 64-byte alignment at the same frame.
+ */
+template <std::size_t Channels, typename T>
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void deinterleave_avx512(T* const* planes, const T* __restrict src, std::size_t frames) noexcept {
+    static constexpr std::size_t BLOCK = detail::INTERLEAVE_BLOCK_AVX512<T>;
+    static constexpr auto CHANNELS = std::make_index_sequence<Channels>{};
+    // Prefetch four cache lines ahead
+    static constexpr std::size_t PREFETCH_DISTANCE = 4 * G_CACHE_LINE_SIZE / sizeof(T);
+
+    T* targets[Channels];
+    for (std::size_t c = 0; c < Channels; ++c) targets[c] = planes[c];
+
+    std::size_t i = 0;
+    if (__builtin_expect(frames * Channels * sizeof(T) >= G_L3_CACHE_SIZE, 0)) {
+        const auto misalignment = [&](std::size_t frame) {
+            std::uintptr_t bits = 0;
+            for (std::size_t c = 0; c < Channels; ++c) bits |= reinterpret_cast<std::uintptr_t>(targets[c] + frame) % 64;
+            return bits;
+        };
+        std::size_t prologue = 0;
+        while (prologue < BLOCK && misalignment(prologue) != 0) ++prologue;
+        if (prologue < BLOCK) {
+            detail::deinterleave_partial_avx512<Channels>(targets, 0, src, prologue, CHANNELS);
+            for (i = prologue; i + BLOCK <= frames; i += BLOCK) {
+                for (std::size_t c = 0; c < Channels; ++c) {
+                    _mm_prefetch(reinterpret_cast<const char*>(src + (i + PREFETCH_DISTANCE) * Channels) + c * G_CACHE_LINE_SIZE, _MM_HINT_NTA);
+                }
+                detail::deinterleave_block_avx512<Channels, T, true>(targets, i, src + i * Channels, CHANNELS);
+            }
+            // Ensure all non-temporal (streaming) stores are visible
+            _mm_sfence();
+        }
+    }
+
+    for (; i + BLOCK <= frames; i += BLOCK) {
+        detail::deinterleave_block_avx512<Channels, T, false>(targets, i, src + i * Channels, CHANNELS);
+    }
+    detail::deinterleave_partial_avx512<Channels>(targets, i, src + i * Channels, frames - i, CHANNELS);
+}
+
+} // namespace omm
+
+#pragma GCC pop_options
@@ -45,13 +45,11 @@
 
 namespace omm {
 
+// Streaming body of memcpy_avx2, without the small-size fast path or the trailing sfence.
+// Callers that split a large copy into cache-sized chunks use it directly and issue
+// the fence themselves once the last chunk is written.
 __attribute__((always_inline, hot, artificial, returns_nonnull, nonnull(1, 2)))
-inline void* memcpy_avx2(void* __restrict dest, const void* __restrict src, std::size_t size) noexcept {
-    // Fast path for small sizes: leverage compiler's built-in optimization
-    if (__builtin_expect(size < G_L3_CACHE_SIZE, 1)) {
-        return __builtin_memcpy(dest, src, size);
-    }
-
+inline void* memcpy_avx2_stream(void* __restrict dest, const void* __restrict src, std::size_t size) noexcept {
     // AVX2 uses 256-bit (32-byte) vectors
     static constexpr std::size_t ALIGNMENT = 32;
     static constexpr std::size_t UNROLL_FACTOR = 8;  // Unrolling factor, use default or adjust based on profiling
@@ -65,6 +63,7 @@ inline void* memcpy_avx2(void* __restrict dest, const void* __restrict src, std:
 
     // Align destination to ALIGNMENT boundary for optimal streaming stores
     std::size_t initial_bytes = (ALIGNMENT - (reinterpret_cast<std::uintptr_t>(dest_ptr) & (ALIGNMENT - 1))) & (ALIGNMENT - 1);
+    if (initial_bytes > size) initial_bytes = size;
     if (initial_bytes > 0) {
         __builtin_memcpy(dest_ptr, src_ptr, initial_bytes);
         dest_ptr += initial_bytes;
@@ -98,6 +97,67 @@ inline void* memcpy_avx2(void* __restrict dest, const void* __restrict src, std:
         __builtin_memcpy(dest_vec, src_vec, remaining);
     }
 
+    return dest;
+}
+
+__attribute__((always_inline, hot, artificial, returns_nonnull, nonnull(1, 2)))
+inline void* memcpy_avx2(void* __restrict dest, const void* __restrict src, std::size_t size) noexcept {
+    // Fast path for small sizes: leverage compiler's built-in optimization
+    if (__builtin_expect(size < G_L3_CACHE_SIZE, 1)) {
+        return __builtin_memcpy(dest, src, size);
+    }
+
+    memcpy_avx2_stream(dest, src, size);
+
+    // Ensure all non-temporal (streaming) stores are visible
+    _mm_sfence();
+
+    return dest;
+}
+
+// Variant of memcpy_avx2 for destinations known to be 32-byte aligned, as with arrays of
+// over-aligned types. Skips the alignment prologue, and streams whole trailing vectors so
+// sizes that are a multiple of 32 bytes need no byte tail at all.
+__attribute__((always_inline, hot, artificial, returns_nonnull, nonnull(1, 2)))
+inline void* memcpy_avx2_aligned(void* __restrict dest, const void* __restrict src, std::size_t size) noexcept {
+    // AVX2 uses 256-bit (32-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 8;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE;
+
+    auto* __restrict dest_ptr = static_cast<uint8_t*>(__builtin_assume_aligned(dest, ALIGNMENT));
+    const auto* __restrict src_ptr = static_cast<const uint8_t* __restrict>(src);
+
+    // Fast path for small sizes: the compiler can use aligned stores for the destination
+    if (__builtin_expect(size < G_L3_CACHE_SIZE, 1)) {
+        return __builtin_memcpy(dest_ptr, src_ptr, size);
+    }
+
+    auto* __restrict dest_vec = reinterpret_cast<__m256i* __restrict>(dest_ptr);
+    const auto* __restrict src_vec = reinterpret_cast<const __m256i* __restrict>(src_ptr);
+    const std::size_t vector_size = size & ~(BLOCK_SIZE - 1);
+
+    for (std::size_t i = 0; i < vector_size; i += BLOCK_SIZE) {
+        for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += G_CACHE_LINE_SIZE) {
+            _mm_prefetch(src_ptr + p, _MM_HINT_NTA);
+        }
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            _mm256_stream_si256(dest_vec++, _mm256_loadu_si256(src_vec++));
+        }
+        src_ptr += BLOCK_SIZE;
+    }
+
+    // Stream the remaining whole vectors, then any bytes left over
+    std::size_t remaining = size - vector_size;
+    for (; remaining >= ALIGNMENT; remaining -= ALIGNMENT) {
+        _mm256_stream_si256(dest_vec++, _mm256_loadu_si256(src_vec++));
+    }
+    if (remaining > 0) {
+        __builtin_memcpy(dest_vec, src_vec, remaining);
+    }
+
     // Ensure all non-temporal (streaming) stores are visible
     _mm_sfence();
 
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace omm {
+
+/**
+ * @brief Copies only the 64-byte lines of src that differ from dest.
+ *
+ * Each line is compared as two 256-bit halves and stored only if either half changed.
+ * Unchanged lines are never written, so they stay clean in the cache and cost no
+ * write-back. Regular stores are used on purpose: the compare has already pulled the
+ * destination line into the cache, and a streaming store would evict it.
+ *
+ * Bit i of dirty_bitmap is set if line i changed; the bitmap must hold (n + 63) / 64
+ * bits rounded up to whole words, and may be nullptr.
+ *
+ * @return Number of lines that changed.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline std::size_t memcpy_delta_avx2(void* __restrict dest, const void* __restrict src, std::size_t size,
+                                       std::uint64_t* __restrict dirty_bitmap) noexcept {
+    // Two AVX2 vectors cover one cache line
+    static constexpr std::size_t LINE_SIZE = 64;
+    static constexpr std::size_t LINES_PER_WORD = 64;
+    static constexpr std::size_t PREFETCH_DISTANCE = 8 * LINE_SIZE;
+
+    auto* __restrict dest_ptr = static_cast<uint8_t* __restrict>(dest);
+    const auto* __restrict src_ptr = static_cast<const uint8_t* __restrict>(src);
+
+    const std::size_t lines = size / LINE_SIZE;
+    std::size_t changed = 0;
+
+    for (std::size_t word = 0; word * LINES_PER_WORD < lines; ++word) {
+        const std::size_t first = word * LINES_PER_WORD;
+        const std::size_t last = first + LINES_PER_WORD < lines ? first + LINES_PER_WORD : lines;
+        std::uint64_t bits = 0;
+
+        for (std::size_t line = first; line < last; ++line) {
+            const std::size_t offset = line * LINE_SIZE;
+            _mm_prefetch(src_ptr + offset + PREFETCH_DISTANCE, _MM_HINT_T0);
+            _mm_prefetch(dest_ptr + offset + PREFETCH_DISTANCE, _MM_HINT_T0);
+
+            const auto* src_vec = reinterpret_cast<const __m256i*>(src_ptr + offset);
+            auto* dest_vec = reinterpret_cast<__m256i*>(dest_ptr + offset);
+            const __m256i s0 = _mm256_loadu_si256(src_vec);
+            const __m256i s1 = _mm256_loadu_si256(src_vec + 1);
+            const __m256i diff = _mm256_or_si256(_mm256_xor_si256(s0, _mm256_loadu_si256(dest_vec)),
+                                                 _mm256_xor_si256(s1, _mm256_loadu_si256(dest_vec + 1)));
+            if (!_mm256_testz_si256(diff, diff)) {
+                _mm256_storeu_si256(dest_vec, s0);
+                _mm256_storeu_si256(dest_vec + 1, s1);
+                bits |= std::uint64_t{1} << (line - first);
+            }
+        }
+
+        changed += static_cast<std::size_t>(__builtin_popcountll(bits));
+        if (dirty_bitmap) dirty_bitmap[word] = bits;
+    }
+
+    // Handle the trailing partial line (< LINE_SIZE) with standard compare and copy
+    const std::size_t remaining = size - lines * LINE_SIZE;
+    if (remaining > 0) {
+        const std::size_t offset = lines * LINE_SIZE;
+        const std::size_t word = lines / LINES_PER_WORD;
+        if (dirty_bitmap && lines % LINES_PER_WORD == 0) dirty_bitmap[word] = 0;
+        if (__builtin_memcmp(dest_ptr + offset, src_ptr + offset, remaining) != 0) {
+            __builtin_memcpy(dest_ptr + offset, src_ptr + offset, remaining);
+            if (dirty_bitmap) dirty_bitmap[word] |= std::uint64_t{1} << (lines % LINES_PER_WORD);
+            ++changed;
+        }
+    }
+
+    return changed;
+}
+
+} // namespace omm
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+#ifdef OMM_FULL_LIBRARY
+#include "omm/detail/cpu_features.h"
+#else
+#pragma push_macro("G_L3_CACHE_SIZE")
+#pragma push_macro("G_CACHE_LINE_SIZE")
+#undef G_L3_CACHE_SIZE
+#undef G_CACHE_LINE_SIZE
+
+// IMPORTANT: Definitions below are only for standalone mode.
+// When using the full library, these are ignored and values are auto-detected
+// by cpu_features.h instead.
+
+// L3 cache size: Typically varies between processors. Set to 32MB as a common value.
+#define G_L3_CACHE_SIZE (32 * 1024 * 1024)  // 32MB
+
+// Cache line size: Smallest data transfer unit between CPU cache and main memory. Typical for modern x86.
+#define G_CACHE_LINE_SIZE 64  // Aligning to this can improve performance by reducing cache misses
+
+#endif
+
+
+namespace omm {
+
+/**
+ * @brief Copies size bytes from src to each of count destinations in one pass over src.
+ *
+ * Each source block is loaded into registers once and then streamed to every
+ * destination, so the source is read from memory a single time regardless of count.
+ * The alignment prologue is computed for dests[0]; destinations sharing its alignment
+ * get streaming stores, the others fall back to unaligned regular stores.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(3)))
+inline void memcpy_fanout_avx2(void* const* dests, std::size_t count, const void* __restrict src, std::size_t size) noexcept {
+    if (count == 0) return;
+
+    // Fast path for small sizes: the source stays cache resident between copies
+    if (__builtin_expect(size < G_L3_CACHE_SIZE, 1)) {
+        for (std::size_t d = 0; d < count; ++d) {
+            __builtin_memcpy(dests[d], src, size);
+        }
+        return;
+    }
+
+    // AVX2 uses 256-bit (32-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 8;  // Vectors held in registers per block
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    // Prefetch two blocks ahead - adjust based on target hardware characteristics
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE;
+
+    const auto* __restrict src_ptr = static_cast<const uint8_t* __restrict>(src);
+
+    // Align the first destination to ALIGNMENT boundary for optimal streaming stores
+    const auto first_dest = reinterpret_cast<std::uintptr_t>(dests[0]);
+    const std::size_t initial_bytes = (ALIGNMENT - (first_dest & (ALIGNMENT - 1))) & (ALIGNMENT - 1);
+    if (initial_bytes > 0) {
+        for (std::size_t d = 0; d < count; ++d) {
+            __builtin_memcpy(dests[d], src_ptr, initial_bytes);
+        }
+    }
+
+    const std::size_t body_size = size - initial_bytes;
+    // Compute size that's a multiple of BLOCK_SIZE for vectorized processing
+    const std::size_t vector_size = body_size & ~(BLOCK_SIZE - 1);
+    const uint8_t* block_src = src_ptr + initial_bytes;
+
+    for (std::size_t i = 0; i < vector_size; i += BLOCK_SIZE) {
+        // Prefetch data using NTA (Non-Temporal Access) hint to bypass cache for large transfers
+        for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += G_CACHE_LINE_SIZE) {
+            _mm_prefetch(block_src + i + p, _MM_HINT_NTA);
+        }
+
+        // Load the block once into registers
+        __m256i block[UNROLL_FACTOR];
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            block[p] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block_src + i + p * ALIGNMENT));
+        }
+
+        // Stream the registers to every destination
+        for (std::size_t d = 0; d < count; ++d) {
+            auto* dest_ptr = static_cast<uint8_t*>(dests[d]) + initial_bytes + i;
+            if ((reinterpret_cast<std::uintptr_t>(dest_ptr) & (ALIGNMENT - 1)) == 0) {
+                #pragma unroll(UNROLL_FACTOR)
+                for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                    _mm256_stream_si256(reinterpret_cast<__m256i*>(dest_ptr + p * ALIGNMENT), block[p]);
+                }
+            } else {
+                #pragma unroll(UNROLL_FACTOR)
+                for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest_ptr + p * ALIGNMENT), block[p]);
+                }
+            }
+        }
+    }
+
+    // Handle remaining bytes (< BLOCK_SIZE) with standard memcpy
+    const std::size_t remaining = body_size - vector_size;
+    if (remaining > 0) {
+        const std::size_t offset = initial_bytes + vector_size;
+        for (std::size_t d = 0; d < count; ++d) {
+            __builtin_memcpy(static_cast<uint8_t*>(dests[d]) + offset, src_ptr + offset, remaining);
+        }
+    }
+
+    // Ensure all non-temporal (streaming) stores are visible
+    _mm_sfence();
+}
+
+} // namespace omm
@@ -0,0 +1,124 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <utility>
+
+namespace omm {
+
+// Widest vector register available to this translation unit at compile time
+#if defined(__AVX512F__)
+inline constexpr std::size_t FIXED_VECTOR_WIDTH = 64;
+#elif defined(__AVX2__)
+inline constexpr std::size_t FIXED_VECTOR_WIDTH = 32;
+#else
+inline constexpr std::size_t FIXED_VECTOR_WIDTH = 16;
+#endif
+
+// Fixed sizes up to this many vectors are emitted as straight-line moves
+inline constexpr std::size_t FIXED_INLINE_VECTORS = 16;
+
+namespace detail {
+
+// Copies exactly W bytes at offset with a single load and store
+template <std::size_t W>
+__attribute__((always_inline, artificial))
+inline void fixed_move(uint8_t* __restrict dest, const uint8_t* __restrict src, std::size_t offset) noexcept {
+    if constexpr (W == 64) {
+        #ifdef __AVX512F__
+        _mm512_storeu_si512(dest + offset, _mm512_loadu_si512(src + offset));
+        #endif
+    } else if constexpr (W == 32) {
+        #ifdef __AVX2__
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + offset),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + offset)));
+        #endif
+    } else if constexpr (W == 16) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + offset),
+                         _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + offset)));
+    } else {
+        // Scalar widths compile to a single mov
+        __builtin_memcpy(dest + offset, src + offset, W);
+    }
+}
+
+// Largest supported vector width that fits in N bytes
+template <std::size_t N>
+inline constexpr std::size_t fixed_vector_width = N >= 64 && FIXED_VECTOR_WIDTH >= 64 ? 64
+                                                : N >= 32 && FIXED_VECTOR_WIDTH >= 32 ? 32
+                                                : 16;
+
+template <std::size_t W, std::size_t... I>
+__attribute__((always_inline, artificial))
+inline void fixed_move_vectors(uint8_t* __restrict dest, const uint8_t* __restrict src,
+                               std::index_sequence<I...>) noexcept {
+    (fixed_move<W>(dest, src, I * W), ...);
+}
+
+} // namespace detail
+
+/**
+ * @brief Copies a compile-time number of bytes with branch-free straight-line moves.
+ *
+ * Sizes that are not a multiple of the move width finish with a second move that
+ * overlaps the previous one, so no size needs a scalar tail. Sizes beyond
+ * FIXED_INLINE_VECTORS vectors use a loop with a constant trip count.
+ */
+template <std::size_t N>
+__attribute__((always_inline, hot, artificial))
+inline void memcpy_fixed(void* __restrict dest, const void* __restrict src) noexcept {
+    auto* __restrict dest_ptr = static_cast<uint8_t* __restrict>(dest);
+    const auto* __restrict src_ptr = static_cast<const uint8_t* __restrict>(src);
+
+    if constexpr (N == 0) {
+        return;
+    } else if constexpr (N == 1 || N == 2 || N == 4 || N == 8) {
+        detail::fixed_move<N>(dest_ptr, src_ptr, 0);
+    } else if constexpr (N < 4) {
+        detail::fixed_move<2>(dest_ptr, src_ptr, 0);
+        detail::fixed_move<2>(dest_ptr, src_ptr, N - 2);
+    } else if constexpr (N < 8) {
+        detail::fixed_move<4>(dest_ptr, src_ptr, 0);
+        detail::fixed_move<4>(dest_ptr, src_ptr, N - 4);
+    } else if constexpr (N < 16) {
+        detail::fixed_move<8>(dest_ptr, src_ptr, 0);
+        detail::fixed_move<8>(dest_ptr, src_ptr, N - 8);
+    } else {
+        static constexpr std::size_t W = detail::fixed_vector_width<N>;
+        static constexpr std::size_t VECTORS = N / W;
+
+        if constexpr (VECTORS <= FIXED_INLINE_VECTORS) {
+            detail::fixed_move_vectors<W>(dest_ptr, src_ptr, std::make_index_sequence<VECTORS>{});
+        } else {
+            for (std::size_t offset = 0; offset < VECTORS * W; offset += W) {
+                detail::fixed_move<W>(dest_ptr, src_ptr, offset);
+            }
+        }
+        // Overlapping last vector covers the remainder
+        if constexpr (N % W != 0) {
+            detail::fixed_move<W>(dest_ptr, src_ptr, N - W);
+        }
+    }
+}
+
+} // namespace omm
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace omm {
+
+/**
+ * @brief Copies size bytes for durable writes, streaming every whole destination line.
+ *
+ * Streaming stores leave nothing in the cache to write back, so only the partial lines
+ * at either end are written with regular stores; those are handed to flush_lines. The
+ * caller issues the sfence that orders both the streaming stores and the flushes.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1, 2, 4)))
+inline void memcpy_persist_avx512(void* __restrict dest, const void* __restrict src, std::size_t size,
+                                  void (*flush_lines)(const void*, std::size_t)) noexcept {
+    // AVX-512 uses 512-bit (64-byte) vectors, one per cache line
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr std::size_t LINE_SIZE = 64;
+    static constexpr std::size_t UNROLL_FACTOR = 8;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    // Prefetch two blocks ahead - adjust based on target hardware characteristics
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE;
+
+    auto* __restrict dest_ptr = static_cast<uint8_t*>(dest);
+    const auto* __restrict src_ptr = static_cast<const uint8_t*>(src);
+
+    // Partial line up to the first line boundary
+    std::size_t initial_bytes = (LINE_SIZE - (reinterpret_cast<std::uintptr_t>(dest_ptr) & (LINE_SIZE - 1))) & (LINE_SIZE - 1);
+    if (initial_bytes > size) initial_bytes = size;
+    if (initial_bytes > 0) {
+        __builtin_memcpy(dest_ptr, src_ptr, initial_bytes);
+        flush_lines(dest_ptr, initial_bytes);
+        dest_ptr += initial_bytes;
+        src_ptr += initial_bytes;
+        size -= initial_bytes;
+    }
+
+    const std::size_t vector_size = size & ~(BLOCK_SIZE - 1);
+    for (std::size_t i = 0; i < vector_size; i += BLOCK_SIZE) {
+        // Prefetch data using NTA (Non-Temporal Access) hint to bypass cache for large transfers
+        for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += LINE_SIZE) {
+            _mm_prefetch(src_ptr + i + p, _MM_HINT_NTA);
+        }
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            _mm512_stream_si512(reinterpret_cast<__m512i*>(dest_ptr + i + p * ALIGNMENT),
+                                _mm512_loadu_si512(src_ptr + i + p * ALIGNMENT));
+        }
+    }
+    std::size_t offset = vector_size;
+    for (; offset + LINE_SIZE <= size; offset += LINE_SIZE) {
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(dest_ptr + offset), _mm512_loadu_si512(src_ptr + offset));
+    }
+
+    // Partial line after the last line boundary
+    if (offset < size) {
+        __builtin_memcpy(dest_ptr + offset, src_ptr + offset, size - offset);
+        flush_lines(dest_ptr + offset, size - offset);
+    }
+}
+
+} // namespace omm
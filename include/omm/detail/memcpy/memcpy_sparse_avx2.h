@@ -0,0 +1,94 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace omm {
+
+/**
+ * @brief Copies one page unless the source page is entirely zero.
+ *
+ * Source blocks are OR-reduced until the first non-zero block is found; from there
+ * the remainder of the page is streamed to the destination. The blocks passed over
+ * are known to be zero, so if zero_prefix is set they are written from a zero
+ * register rather than re-read. Nothing is stored for an all-zero page.
+ *
+ * Requires dest aligned to 32 bytes and page_size a multiple of 256. The caller is
+ * responsible for the trailing sfence.
+ *
+ * @return true if the source page was all zero.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline bool memcpy_sparse_page_avx2(void* __restrict dest, const void* __restrict src,
+                                      std::size_t page_size, bool zero_prefix) noexcept {
+    // AVX2 uses 256-bit (32-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 8;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    static constexpr std::size_t PREFETCH_DISTANCE = 2 * BLOCK_SIZE;
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    auto* __restrict dest_vec = reinterpret_cast<__m256i* __restrict>(dest);
+    const auto* __restrict src_ptr = static_cast<const uint8_t* __restrict>(src);
+    const auto* __restrict src_vec = reinterpret_cast<const __m256i* __restrict>(src);
+
+    // Scan for the first block holding a non-zero byte
+    std::size_t offset = 0;
+    for (; offset < page_size; offset += BLOCK_SIZE) {
+        for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += CACHE_LINE) {
+            _mm_prefetch(src_ptr + offset + p, _MM_HINT_NTA);
+        }
+        const __m256i* block = src_vec + offset / ALIGNMENT;
+        __m256i acc = _mm256_loadu_si256(block);
+        #pragma unroll(UNROLL_FACTOR - 1)
+        for (std::size_t p = 1; p < UNROLL_FACTOR; ++p) {
+            acc = _mm256_or_si256(acc, _mm256_loadu_si256(block + p));
+        }
+        if (!_mm256_testz_si256(acc, acc)) break;
+    }
+    if (offset == page_size) return true;
+
+    // The scanned prefix is zero; materialize it without touching the source again
+    if (zero_prefix) {
+        const __m256i zero = _mm256_setzero_si256();
+        for (std::size_t i = 0; i < offset / ALIGNMENT; ++i) {
+            _mm256_stream_si256(dest_vec + i, zero);
+        }
+    }
+
+    // Stream the rest of the page, starting with the block that failed the zero test
+    for (; offset < page_size; offset += BLOCK_SIZE) {
+        for (std::size_t p = 0; p < PREFETCH_DISTANCE; p += CACHE_LINE) {
+            _mm_prefetch(src_ptr + offset + p, _MM_HINT_NTA);
+        }
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            const std::size_t v = offset / ALIGNMENT + p;
+            _mm256_stream_si256(dest_vec + v, _mm256_loadu_si256(src_vec + v));
+        }
+    }
+
+    return false;
+}
+
+} // namespace omm
@@ -0,0 +1,103 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "omm/detail/memory/huge_pages.h"
+
+namespace omm::detail {
+
+/**
+ * @brief Fixed-size blocks carved from huge page mappings.
+ *
+ * Chunks of HUGE_PAGE_SIZE are mapped on demand and split into blocks, so many small
+ * buffers share a few huge pages and their TLB entries. Freed blocks go on a free list
+ * for reuse; chunks are only unmapped when the pool is destroyed. A mutex guards the
+ * free list, which is only touched once per block rather than per byte.
+ */
+class block_pool {
+public:
+    // block_size must be a power of two that divides HUGE_PAGE_SIZE
+    explicit block_pool(std::size_t block_size) noexcept : block_size_(block_size) {}
+
+    block_pool(const block_pool&) = delete;
+    block_pool& operator=(const block_pool&) = delete;
+
+    ~block_pool() {
+        for (const chunk& c : chunks_) {
+            if (c.mapped) {
+                unmap_huge_pages(c.base, HUGE_PAGE_SIZE);
+            } else {
+                ::operator delete(c.base, std::align_val_t{HUGE_PAGE_SIZE});
+            }
+        }
+    }
+
+    /**
+     * @brief Returns a block of block_size() bytes, aligned to the block size.
+     * @throws std::bad_alloc if a new chunk cannot be allocated.
+     */
+    void* allocate() {
+        std::lock_guard lock(mutex_);
+        if (free_.empty()) add_chunk();
+        void* block = free_.back();
+        free_.pop_back();
+        return block;
+    }
+
+    void deallocate(void* block) noexcept {
+        std::lock_guard lock(mutex_);
+        free_.push_back(block);  // Capacity was reserved when the block's chunk was added
+    }
+
+    std::size_t block_size() const noexcept { return block_size_; }
+
+private:
+    void add_chunk() {
+        const std::size_t blocks = HUGE_PAGE_SIZE / block_size_;
+        free_.reserve(chunks_.size() * blocks + blocks);
+        chunks_.reserve(chunks_.size() + 1);
+
+        // Fall back to aligned operator new when no mapping is available
+        chunk c{map_huge_pages(HUGE_PAGE_SIZE), true};
+        if (!c.base) c = {::operator new(HUGE_PAGE_SIZE, std::align_val_t{HUGE_PAGE_SIZE}), false};
+        chunks_.push_back(c);
+
+        auto* bytes = static_cast<char*>(c.base);
+        for (std::size_t i = blocks; i-- > 0;) free_.push_back(bytes + i * block_size_);
+    }
+
+    struct chunk {
+        void* base;
+        bool mapped;
+    };
+
+    std::size_t block_size_;
+    std::mutex mutex_;
+    std::vector<void*> free_;
+    std::vector<chunk> chunks_;
+};
+
+} // namespace omm::detail
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace omm::detail {
+
+// Transparent huge page size on x86-64
+inline constexpr std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+/**
+ * @brief Rounds a byte count up to a whole number of huge pages.
+ */
+constexpr std::size_t round_to_huge_pages(std::size_t bytes) noexcept {
+    return (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+}
+
+/**
+ * @brief Maps anonymous memory aligned to a huge page boundary and eligible for THP.
+ *
+ * The mapping is over-allocated by one huge page and trimmed so the kernel can back
+ * it with huge pages from the first byte. Memory reads as zero until written.
+ *
+ * @param bytes Size of the mapping; should be a multiple of HUGE_PAGE_SIZE.
+ * @return Pointer to the mapping, or nullptr on failure.
+ */
+inline void* map_huge_pages(std::size_t bytes) noexcept {
+    #ifdef __linux__
+    const std::size_t padded = bytes + HUGE_PAGE_SIZE;
+    void* raw = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    // Trim the unaligned head and the unused tail
+    auto base = reinterpret_cast<std::uintptr_t>(raw);
+    auto aligned = (base + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    if (aligned > base) munmap(raw, aligned - base);
+    const std::size_t tail = padded - (aligned - base) - bytes;
+    if (tail > 0) munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+
+    madvise(reinterpret_cast<void*>(aligned), bytes, MADV_HUGEPAGE);
+    return reinterpret_cast<void*>(aligned);
+    #else
+    (void)bytes;
+    return nullptr;
+    #endif
+}
+
+/**
+ * @brief Resizes a mapping from map_huge_pages by remapping its page tables, without copying.
+ * @return Pointer to the (possibly moved) mapping, or nullptr on failure, in which case
+ *         the original mapping is left intact.
+ */
+inline void* remap_huge_pages(void* ptr, std::size_t old_bytes, std::size_t new_bytes) noexcept {
+    #ifdef __linux__
+    void* result = mremap(ptr, old_bytes, new_bytes, MREMAP_MAYMOVE);
+    if (result == MAP_FAILED) return nullptr;
+    madvise(result, new_bytes, MADV_HUGEPAGE);
+    return result;
+    #else
+    (void)ptr; (void)old_bytes; (void)new_bytes;
+    return nullptr;
+    #endif
+}
+
+/**
+ * @brief Releases a mapping from map_huge_pages or remap_huge_pages.
+ */
+inline void unmap_huge_pages(void* ptr, std::size_t bytes) noexcept {
+    #ifdef __linux__
+    if (ptr) munmap(ptr, bytes);
+    #else
+    (void)ptr; (void)bytes;
+    #endif
+}
+
+} // namespace omm::detail
@@ -0,0 +1,119 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace omm {
+
+/**
+ * @brief Returns the index of the first non-zero byte among size bytes at ptr, or size
+ *        if they are all zero.
+ *
+ * Blocks of eight vectors are OR-reduced with aligned loads and the scan stops at the
+ * first block with a set bit; only that block is searched byte by byte. Inputs of
+ * PREFETCH_THRESHOLD bytes or more are prefetched PREFETCH_DISTANCE ahead.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1)))
+inline std::size_t find_first_nonzero_avx2(const void* ptr, std::size_t size) noexcept {
+    // AVX2 uses 256-bit (32-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 8;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    static constexpr std::size_t PREFETCH_DISTANCE = 8 * BLOCK_SIZE;
+    static constexpr std::size_t PREFETCH_THRESHOLD = 256 * 1024;
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    const auto* bytes = static_cast<const uint8_t*>(ptr);
+    const __m256i zero = _mm256_setzero_si256();
+
+    // Index of the first non-zero byte in a vector known to hold one
+    auto locate = [&](__m256i v) {
+        const auto zero_mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero)));
+        return static_cast<std::size_t>(__builtin_ctz(~zero_mask));
+    };
+
+    // Inputs shorter than a vector are scanned a word at a time
+    if (size < ALIGNMENT) {
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            __builtin_memcpy(&word, bytes + i, sizeof(word));
+            if (word != 0) return i + static_cast<std::size_t>(__builtin_ctzll(word)) / 8;
+        }
+        for (; i < size; ++i) {
+            if (bytes[i] != 0) return i;
+        }
+        return size;
+    }
+
+    // Check the first, possibly unaligned vector, then continue from the next aligned address
+    const __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));
+    if (!_mm256_testz_si256(head, head)) return locate(head);
+    std::size_t offset = ALIGNMENT - (reinterpret_cast<std::uintptr_t>(bytes) & (ALIGNMENT - 1));
+
+    const bool prefetch = size >= PREFETCH_THRESHOLD;
+    for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+        if (prefetch) {
+            for (std::size_t p = 0; p < BLOCK_SIZE; p += CACHE_LINE) {
+                _mm_prefetch(reinterpret_cast<const char*>(bytes + offset + PREFETCH_DISTANCE + p), _MM_HINT_T0);
+            }
+        }
+        const auto* block = reinterpret_cast<const __m256i*>(bytes + offset);
+        __m256i acc = _mm256_load_si256(block);
+        #pragma unroll(UNROLL_FACTOR - 1)
+        for (std::size_t v = 1; v < UNROLL_FACTOR; ++v) {
+            acc = _mm256_or_si256(acc, _mm256_load_si256(block + v));
+        }
+        if (__builtin_expect(!_mm256_testz_si256(acc, acc), 0)) {
+            for (std::size_t v = 0;; ++v) {
+                const __m256i vec = _mm256_load_si256(block + v);
+                if (!_mm256_testz_si256(vec, vec)) return offset + v * ALIGNMENT + locate(vec);
+            }
+        }
+    }
+
+    // Remaining whole vectors
+    for (; offset + ALIGNMENT <= size; offset += ALIGNMENT) {
+        const __m256i vec = _mm256_load_si256(reinterpret_cast<const __m256i*>(bytes + offset));
+        if (!_mm256_testz_si256(vec, vec)) return offset + locate(vec);
+    }
+
+    // Tail: the last vector overlaps bytes already known to be zero
+    if (offset < size) {
+        const std::size_t last = size - ALIGNMENT;
+        const __m256i vec = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + last));
+        if (!_mm256_testz_si256(vec, vec)) return last + locate(vec);
+    }
+    return size;
+}
+
+/**
+ * @brief Returns true if the size bytes at ptr are all zero.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1)))
+inline bool is_zero_avx2(const void* ptr, std::size_t size) noexcept {
+    return find_first_nonzero_avx2(ptr, size) == size;
+}
+
+} // namespace omm
@@ -0,0 +1,123 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace omm {
+
+/**
+ * @brief Returns the index of the first non-zero byte among size bytes at ptr, or size
+ *        if they are all zero.
+ *
+ * Blocks of eight vectors are OR-reduced with aligned loads and the scan stops at the
+ * first block with a set bit; only that block is searched further. Inputs of
+ * PREFETCH_THRESHOLD bytes or more are prefetched PREFETCH_DISTANCE ahead.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1)))
+inline std::size_t find_first_nonzero_avx512(const void* ptr, std::size_t size) noexcept {
+    // AVX-512 uses 512-bit (64-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr std::size_t UNROLL_FACTOR = 8;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+    static constexpr std::size_t PREFETCH_DISTANCE = 4 * BLOCK_SIZE;
+    static constexpr std::size_t PREFETCH_THRESHOLD = 256 * 1024;
+    static constexpr std::size_t CACHE_LINE = 64;
+
+    const auto* bytes = static_cast<const uint8_t*>(ptr);
+
+    // Index of the first non-zero byte in the vector at p, known to hold one. AVX-512F
+    // has no byte compares, so find the 64-bit lane and then the byte within it.
+    auto locate = [](const uint8_t* p, __m512i v) {
+        const auto lane = static_cast<std::size_t>(__builtin_ctz(_mm512_test_epi64_mask(v, v)));
+        std::uint64_t word;
+        __builtin_memcpy(&word, p + lane * sizeof(word), sizeof(word));
+        return lane * sizeof(word) + static_cast<std::size_t>(__builtin_ctzll(word)) / 8;
+    };
+
+    // Inputs shorter than a vector are scanned a word at a time
+    if (size < ALIGNMENT) {
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            __builtin_memcpy(&word, bytes + i, sizeof(word));
+            if (word != 0) return i + static_cast<std::size_t>(__builtin_ctzll(word)) / 8;
+        }
+        for (; i < size; ++i) {
+            if (bytes[i] != 0) return i;
+        }
+        return size;
+    }
+
+    // Check the first, possibly unaligned vector, then continue from the next aligned address
+    const __m512i head = _mm512_loadu_si512(bytes);
+    if (_mm512_test_epi64_mask(head, head) != 0) return locate(bytes, head);
+    std::size_t offset = ALIGNMENT - (reinterpret_cast<std::uintptr_t>(bytes) & (ALIGNMENT - 1));
+
+    const bool prefetch = size >= PREFETCH_THRESHOLD;
+    for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+        if (prefetch) {
+            for (std::size_t p = 0; p < BLOCK_SIZE; p += CACHE_LINE) {
+                _mm_prefetch(reinterpret_cast<const char*>(bytes + offset + PREFETCH_DISTANCE + p), _MM_HINT_T0);
+            }
+        }
+        const auto* block = reinterpret_cast<const __m512i*>(bytes + offset);
+        __m512i acc = _mm512_load_si512(block);
+        #pragma unroll(UNROLL_FACTOR - 1)
+        for (std::size_t v = 1; v < UNROLL_FACTOR; ++v) {
+            acc = _mm512_or_si512(acc, _mm512_load_si512(block + v));
+        }
+        if (__builtin_expect(_mm512_test_epi64_mask(acc, acc) != 0, 0)) {
+            for (std::size_t v = 0;; ++v) {
+                const __m512i vec = _mm512_load_si512(block + v);
+                if (_mm512_test_epi64_mask(vec, vec) != 0) {
+                    return offset + v * ALIGNMENT + locate(bytes + offset + v * ALIGNMENT, vec);
+                }
+            }
+        }
+    }
+
+    // Remaining whole vectors
+    for (; offset + ALIGNMENT <= size; offset += ALIGNMENT) {
+        const __m512i vec = _mm512_load_si512(bytes + offset);
+        if (_mm512_test_epi64_mask(vec, vec) != 0) return offset + locate(bytes + offset, vec);
+    }
+
+    // Tail: the last vector overlaps bytes already known to be zero
+    if (offset < size) {
+        const std::size_t last = size - ALIGNMENT;
+        const __m512i vec = _mm512_loadu_si512(bytes + last);
+        if (_mm512_test_epi64_mask(vec, vec) != 0) return last + locate(bytes + last, vec);
+    }
+    return size;
+}
+
+/**
+ * @brief Returns true if the size bytes at ptr are all zero.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1)))
+inline bool is_zero_avx512(const void* ptr, std::size_t size) noexcept {
+    return find_first_nonzero_avx512(ptr, size) == size;
+}
+
+} // namespace omm
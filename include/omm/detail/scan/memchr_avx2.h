@@ -0,0 +1,216 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace omm {
+
+namespace detail {
+
+// Shared scan loops for the byte searches below. match(v) returns a vector with 0xFF in
+// the bytes of v that are hits.
+
+// First hit among size bytes at bytes, or nullptr
+template <typename Match>
+__attribute__((always_inline, hot))
+inline const uint8_t* scan_forward_avx2(const uint8_t* bytes, std::size_t size, Match match) noexcept {
+    // AVX2 uses 256-bit (32-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 4;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+
+    auto mask_of = [&](__m256i v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(match(v))); };
+
+    // Short inputs: aligned loads of the one or two vectors holding them never cross a
+    // page boundary, so they cannot fault even though they read past the ends
+    if (size < ALIGNMENT) {
+        if (size == 0) return nullptr;
+        const auto* base = reinterpret_cast<const uint8_t*>(reinterpret_cast<std::uintptr_t>(bytes) & ~(ALIGNMENT - 1));
+        const std::size_t shift = static_cast<std::size_t>(bytes - base);
+        std::uint64_t mask = mask_of(_mm256_load_si256(reinterpret_cast<const __m256i*>(base)));
+        if (shift + size > ALIGNMENT) {
+            mask |= static_cast<std::uint64_t>(mask_of(_mm256_load_si256(reinterpret_cast<const __m256i*>(base + ALIGNMENT)))) << ALIGNMENT;
+        }
+        mask = (mask >> shift) & ((std::uint64_t{1} << size) - 1);
+        return mask ? bytes + __builtin_ctzll(mask) : nullptr;
+    }
+
+    // Check the first, possibly unaligned vector, then continue from the next aligned address
+    if (const std::uint32_t mask = mask_of(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes)))) {
+        return bytes + __builtin_ctz(mask);
+    }
+    std::size_t offset = ALIGNMENT - (reinterpret_cast<std::uintptr_t>(bytes) & (ALIGNMENT - 1));
+
+    for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+        const auto* block = reinterpret_cast<const __m256i*>(bytes + offset);
+        const __m256i m0 = match(_mm256_load_si256(block));
+        const __m256i m1 = match(_mm256_load_si256(block + 1));
+        const __m256i m2 = match(_mm256_load_si256(block + 2));
+        const __m256i m3 = match(_mm256_load_si256(block + 3));
+        const __m256i any = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+        if (__builtin_expect(!_mm256_testz_si256(any, any), 0)) {
+            const std::uint64_t low = static_cast<std::uint32_t>(_mm256_movemask_epi8(m0)) |
+                                      static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m1))) << 32;
+            if (low) return bytes + offset + __builtin_ctzll(low);
+            const std::uint64_t high = static_cast<std::uint32_t>(_mm256_movemask_epi8(m2)) |
+                                       static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m3))) << 32;
+            return bytes + offset + 2 * ALIGNMENT + __builtin_ctzll(high);
+        }
+    }
+
+    // Remaining whole vectors
+    for (; offset + ALIGNMENT <= size; offset += ALIGNMENT) {
+        if (const std::uint32_t mask = mask_of(_mm256_load_si256(reinterpret_cast<const __m256i*>(bytes + offset)))) {
+            return bytes + offset + __builtin_ctz(mask);
+        }
+    }
+
+    // Tail: the last vector overlaps bytes already known to hold no hit
+    if (offset < size) {
+        const std::size_t last = size - ALIGNMENT;
+        if (const std::uint32_t mask = mask_of(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + last)))) {
+            return bytes + last + __builtin_ctz(mask);
+        }
+    }
+    return nullptr;
+}
+
+// Last hit among size bytes at bytes, or nullptr
+template <typename Match>
+__attribute__((always_inline, hot))
+inline const uint8_t* scan_backward_avx2(const uint8_t* bytes, std::size_t size, Match match) noexcept {
+    static constexpr std::size_t ALIGNMENT = 32;
+    static constexpr std::size_t UNROLL_FACTOR = 4;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+
+    auto mask_of = [&](__m256i v) { return static_cast<std::uint32_t>(_mm256_movemask_epi8(match(v))); };
+
+    // Short inputs: as in scan_forward_avx2
+    if (size < ALIGNMENT) {
+        if (size == 0) return nullptr;
+        const auto* base = reinterpret_cast<const uint8_t*>(reinterpret_cast<std::uintptr_t>(bytes) & ~(ALIGNMENT - 1));
+        const std::size_t shift = static_cast<std::size_t>(bytes - base);
+        std::uint64_t mask = mask_of(_mm256_load_si256(reinterpret_cast<const __m256i*>(base)));
+        if (shift + size > ALIGNMENT) {
+            mask |= static_cast<std::uint64_t>(mask_of(_mm256_load_si256(reinterpret_cast<const __m256i*>(base + ALIGNMENT)))) << ALIGNMENT;
+        }
+        mask = (mask >> shift) & ((std::uint64_t{1} << size) - 1);
+        return mask ? bytes + 63 - __builtin_clzll(mask) : nullptr;
+    }
+
+    // Check the last, possibly unaligned vector, then continue down from the aligned
+    // address below it
+    const std::size_t last = size - ALIGNMENT;
+    if (const std::uint32_t mask = mask_of(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes + last)))) {
+        return bytes + last + 31 - __builtin_clz(mask);
+    }
+    std::size_t end = size - ((reinterpret_cast<std::uintptr_t>(bytes) + size) & (ALIGNMENT - 1));
+
+    for (; end >= BLOCK_SIZE; end -= BLOCK_SIZE) {
+        const auto* block = reinterpret_cast<const __m256i*>(bytes + end - BLOCK_SIZE);
+        const __m256i m0 = match(_mm256_load_si256(block));
+        const __m256i m1 = match(_mm256_load_si256(block + 1));
+        const __m256i m2 = match(_mm256_load_si256(block + 2));
+        const __m256i m3 = match(_mm256_load_si256(block + 3));
+        const __m256i any = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+        if (__builtin_expect(!_mm256_testz_si256(any, any), 0)) {
+            const std::uint64_t high = static_cast<std::uint32_t>(_mm256_movemask_epi8(m2)) |
+                                       static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m3))) << 32;
+            if (high) return bytes + end - BLOCK_SIZE + 2 * ALIGNMENT + 63 - __builtin_clzll(high);
+            const std::uint64_t low = static_cast<std::uint32_t>(_mm256_movemask_epi8(m0)) |
+                                      static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(m1))) << 32;
+            return bytes + end - BLOCK_SIZE + 63 - __builtin_clzll(low);
+        }
+    }
+
+    // Remaining whole vectors
+    for (; end >= ALIGNMENT; end -= ALIGNMENT) {
+        if (const std::uint32_t mask = mask_of(_mm256_load_si256(reinterpret_cast<const __m256i*>(bytes + end - ALIGNMENT)))) {
+            return bytes + end - ALIGNMENT + 31 - __builtin_clz(mask);
+        }
+    }
+
+    // Head: the first vector overlaps bytes already known to hold no hit
+    if (end > 0) {
+        if (const std::uint32_t mask = mask_of(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes)))) {
+            return bytes + 31 - __builtin_clz(mask);
+        }
+    }
+    return nullptr;
+}
+
+// Hits for the bytes of v in a byte_set. tables[lo] has bit h set when byte (h << 4 | lo)
+// is in the set, for h below 8; tables[16 + lo] does the same for h from 8. pshufb
+// returns zero for indices with the top bit set, which selects between the two.
+__attribute__((always_inline))
+inline __m256i classify_avx2(__m256i v, __m256i low_table, __m256i high_table) noexcept {
+    const __m256i bit_table = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                                               1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+    const __m256i row = _mm256_or_si256(_mm256_shuffle_epi8(low_table, v),
+                                        _mm256_shuffle_epi8(high_table, _mm256_xor_si256(v, _mm256_set1_epi8(-128))));
+    const __m256i high_nibble = _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0F));
+    const __m256i bit = _mm256_shuffle_epi8(bit_table, high_nibble);
+    return _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns a pointer to the first byte equal to c among the size bytes at ptr,
+ *        or nullptr.
+ */
+__attribute__((always_inline, hot, artificial))
+inline const void* memchr_avx2(const void* ptr, int c, std::size_t size) noexcept {
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(c));
+    return detail::scan_forward_avx2(static_cast<const uint8_t*>(ptr), size,
+                                     [&](__m256i v) { return _mm256_cmpeq_epi8(v, needle); });
+}
+
+/**
+ * @brief Returns a pointer to the last byte equal to c among the size bytes at ptr,
+ *        or nullptr.
+ */
+__attribute__((always_inline, hot, artificial))
+inline const void* memrchr_avx2(const void* ptr, int c, std::size_t size) noexcept {
+    const __m256i needle = _mm256_set1_epi8(static_cast<char>(c));
+    return detail::scan_backward_avx2(static_cast<const uint8_t*>(ptr), size,
+                                      [&](__m256i v) { return _mm256_cmpeq_epi8(v, needle); });
+}
+
+/**
+ * @brief Returns a pointer to the first of the size bytes at ptr that is in the set
+ *        described by tables, or nullptr.
+ *
+ * tables holds the 32-byte nibble classification of a byte_set; each vector is
+ * classified with three pshufb lookups.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(3)))
+inline const void* find_any_of_avx2(const void* ptr, std::size_t size, const uint8_t* tables) noexcept {
+    const __m256i low_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables)));
+    const __m256i high_table = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16)));
+    return detail::scan_forward_avx2(static_cast<const uint8_t*>(ptr), size,
+                                     [&](__m256i v) { return detail::classify_avx2(v, low_table, high_table); });
+}
+
+} // namespace omm
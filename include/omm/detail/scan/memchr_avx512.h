@@ -0,0 +1,187 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+// Byte compares and shuffles need AVX-512BW, which the build does not enable with
+// AVX-512F; these kernels are compiled for it and dispatched on a runtime check
+#pragma GCC push_options
+#pragma GCC target("avx512bw")
+
+namespace omm {
+
+namespace detail {
+
+// Shared scan loops for the byte searches below. match(v) returns the mask of bytes of
+// v that are hits.
+
+// First hit among size bytes at bytes, or nullptr
+template <typename Match>
+__attribute__((always_inline, hot))
+inline const uint8_t* scan_forward_avx512(const uint8_t* bytes, std::size_t size, Match match) noexcept {
+    // AVX-512 uses 512-bit (64-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr std::size_t UNROLL_FACTOR = 4;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+
+    // Short inputs: a masked load, which cannot fault on the bytes it leaves out
+    if (size < ALIGNMENT) {
+        const __mmask64 valid = size ? ~std::uint64_t{0} >> (ALIGNMENT - size) : 0;
+        const __mmask64 mask = match(_mm512_maskz_loadu_epi8(valid, bytes)) & valid;
+        return mask ? bytes + __builtin_ctzll(mask) : nullptr;
+    }
+
+    // Check the first, possibly unaligned vector, then continue from the next aligned address
+    if (const __mmask64 mask = match(_mm512_loadu_si512(bytes))) return bytes + __builtin_ctzll(mask);
+    std::size_t offset = ALIGNMENT - (reinterpret_cast<std::uintptr_t>(bytes) & (ALIGNMENT - 1));
+
+    for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+        const uint8_t* block = bytes + offset;
+        const __mmask64 m0 = match(_mm512_load_si512(block));
+        const __mmask64 m1 = match(_mm512_load_si512(block + ALIGNMENT));
+        const __mmask64 m2 = match(_mm512_load_si512(block + 2 * ALIGNMENT));
+        const __mmask64 m3 = match(_mm512_load_si512(block + 3 * ALIGNMENT));
+        if (__builtin_expect((m0 | m1 | m2 | m3) != 0, 0)) {
+            if (m0) return block + __builtin_ctzll(m0);
+            if (m1) return block + ALIGNMENT + __builtin_ctzll(m1);
+            if (m2) return block + 2 * ALIGNMENT + __builtin_ctzll(m2);
+            return block + 3 * ALIGNMENT + __builtin_ctzll(m3);
+        }
+    }
+
+    // Remaining whole vectors
+    for (; offset + ALIGNMENT <= size; offset += ALIGNMENT) {
+        if (const __mmask64 mask = match(_mm512_load_si512(bytes + offset))) return bytes + offset + __builtin_ctzll(mask);
+    }
+
+    // Tail: the last vector overlaps bytes already known to hold no hit
+    if (offset < size) {
+        const std::size_t last = size - ALIGNMENT;
+        if (const __mmask64 mask = match(_mm512_loadu_si512(bytes + last))) return bytes + last + __builtin_ctzll(mask);
+    }
+    return nullptr;
+}
+
+// Last hit among size bytes at bytes, or nullptr
+template <typename Match>
+__attribute__((always_inline, hot))
+inline const uint8_t* scan_backward_avx512(const uint8_t* bytes, std::size_t size, Match match) noexcept {
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr std::size_t UNROLL_FACTOR = 4;
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+
+    // Short inputs: as in scan_forward_avx512
+    if (size < ALIGNMENT) {
+        const __mmask64 valid = size ? ~std::uint64_t{0} >> (ALIGNMENT - size) : 0;
+        const __mmask64 mask = match(_mm512_maskz_loadu_epi8(valid, bytes)) & valid;
+        return mask ? bytes + 63 - __builtin_clzll(mask) : nullptr;
+    }
+
+    // Check the last, possibly unaligned vector, then continue down from the aligned
+    // address below it
+    const std::size_t last = size - ALIGNMENT;
+    if (const __mmask64 mask = match(_mm512_loadu_si512(bytes + last))) return bytes + last + 63 - __builtin_clzll(mask);
+    std::size_t end = size - ((reinterpret_cast<std::uintptr_t>(bytes) + size) & (ALIGNMENT - 1));
+
+    for (; end >= BLOCK_SIZE; end -= BLOCK_SIZE) {
+        const uint8_t* block = bytes + end - BLOCK_SIZE;
+        const __mmask64 m0 = match(_mm512_load_si512(block));
+        const __mmask64 m1 = match(_mm512_load_si512(block + ALIGNMENT));
+        const __mmask64 m2 = match(_mm512_load_si512(block + 2 * ALIGNMENT));
+        const __mmask64 m3 = match(_mm512_load_si512(block + 3 * ALIGNMENT));
+        if (__builtin_expect((m0 | m1 | m2 | m3) != 0, 0)) {
+            if (m3) return block + 3 * ALIGNMENT + 63 - __builtin_clzll(m3);
+            if (m2) return block + 2 * ALIGNMENT + 63 - __builtin_clzll(m2);
+            if (m1) return block + ALIGNMENT + 63 - __builtin_clzll(m1);
+            return block + 63 - __builtin_clzll(m0);
+        }
+    }
+
+    // Remaining whole vectors
+    for (; end >= ALIGNMENT; end -= ALIGNMENT) {
+        if (const __mmask64 mask = match(_mm512_load_si512(bytes + end - ALIGNMENT))) {
+            return bytes + end - ALIGNMENT + 63 - __builtin_clzll(mask);
+        }
+    }
+
+    // Head: the first vector overlaps bytes already known to hold no hit
+    if (end > 0) {
+        if (const __mmask64 mask = match(_mm512_loadu_si512(bytes))) return bytes + 63 - __builtin_clzll(mask);
+    }
+    return nullptr;
+}
+
+// Hits for the bytes of v in a byte_set; see classify_avx2 for the table layout
+__attribute__((always_inline))
+inline __mmask64 classify_avx512(__m512i v, __m512i low_table, __m512i high_table) noexcept {
+    const __m512i bit_table = _mm512_set1_epi64(0x8040201008040201);
+    const __m512i row = _mm512_or_si512(_mm512_shuffle_epi8(low_table, v),
+                                        _mm512_shuffle_epi8(high_table, _mm512_xor_si512(v, _mm512_set1_epi8(-128))));
+    const __m512i high_nibble = _mm512_and_si512(_mm512_srli_epi16(v, 4), _mm512_set1_epi8(0x0F));
+    return _mm512_test_epi8_mask(row, _mm512_shuffle_epi8(bit_table, high_nibble));
+}
+
+} // namespace detail
+
+/**
+ * @brief Returns a pointer to the first byte equal to c among the size bytes at ptr,
+ *        or nullptr.
+ */
+__attribute__((always_inline, hot, artificial))
+inline const void* memchr_avx512(const void* ptr, int c, std::size_t size) noexcept {
+    const __m512i needle = _mm512_set1_epi8(static_cast<char>(c));
+    return detail::scan_forward_avx512(static_cast<const uint8_t*>(ptr), size,
+                                       [&](__m512i v) { return _mm512_cmpeq_epi8_mask(v, needle); });
+}
+
+/**
+ * @brief Returns a pointer to the last byte equal to c among the size bytes at ptr,
+ *        or nullptr.
+ */
+__attribute__((always_inline, hot, artificial))
+inline const void* memrchr_avx512(const void* ptr, int c, std::size_t size) noexcept {
+    const __m512i needle = _mm512_set1_epi8(static_cast<char>(c));
+    return detail::scan_backward_avx512(static_cast<const uint8_t*>(ptr), size,
+                                        [&](__m512i v) { return _mm512_cmpeq_epi8_mask(v, needle); });
+}
+
+/**
+ * @brief Returns a pointer to the first of the size bytes at ptr that is in the set
+ *        described by tables, or nullptr.
+ *
+ * tables holds the 32-byte nibble classification of a byte_set; each vector is
+ * classified with three vpshufb lookups.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(3)))
+inline const void* find_any_of_avx512(const void* ptr, std::size_t size, const uint8_t* tables) noexcept {
+    // Zero-masked broadcasts: the unmasked form trips -Wmaybe-uninitialized in GCC's headers
+    const __m512i low_table = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables)));
+    const __m512i high_table = _mm512_maskz_broadcast_i32x4(0xFFFF, _mm_loadu_si128(reinterpret_cast<const __m128i*>(tables + 16)));
+    return detail::scan_forward_avx512(static_cast<const uint8_t*>(ptr), size,
+                                       [&](__m512i v) { return detail::classify_avx512(v, low_table, high_table); });
+}
+
+} // namespace omm
+
+#pragma GCC pop_options
@@ -0,0 +1,79 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace omm {
+
+/**
+ * @brief Copies size bytes out of a seqlock-protected buffer, one 64-byte vector at a time.
+ *
+ * Used between the sequence reads of a seqlock reader and the sequence writes of its
+ * writer, whose fences keep the copy in place. The copy may observe a concurrent write
+ * half done; the sequence check, not the copy, decides whether the result is kept.
+ * Copies shorter than one vector fall back to 8-byte words.
+ */
+__attribute__((always_inline, hot, artificial, nonnull(1, 2)))
+inline void seqlock_copy_avx512(void* __restrict dest, const void* __restrict src, std::size_t size) noexcept {
+    // AVX-512 uses 512-bit (64-byte) vectors
+    static constexpr std::size_t ALIGNMENT = 64;
+    static constexpr std::size_t UNROLL_FACTOR = 4;  // Unrolling factor, use default or adjust based on profiling
+    static constexpr std::size_t BLOCK_SIZE = ALIGNMENT * UNROLL_FACTOR;
+
+    auto* __restrict dest_ptr = static_cast<uint8_t*>(dest);
+    const auto* __restrict src_ptr = static_cast<const uint8_t*>(src);
+
+    if (size < ALIGNMENT) {
+        std::size_t i = 0;
+        for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+            std::uint64_t word;
+            __builtin_memcpy(&word, src_ptr + i, sizeof(word));
+            __builtin_memcpy(dest_ptr + i, &word, sizeof(word));
+        }
+        for (; i < size; ++i) {
+            dest_ptr[i] = src_ptr[i];
+        }
+        return;
+    }
+
+    const std::size_t vector_size = size & ~(BLOCK_SIZE - 1);
+    for (std::size_t i = 0; i < vector_size; i += BLOCK_SIZE) {
+        #pragma unroll(UNROLL_FACTOR)
+        for (std::size_t p = 0; p < UNROLL_FACTOR; ++p) {
+            _mm512_storeu_si512(dest_ptr + i + p * ALIGNMENT, _mm512_loadu_si512(src_ptr + i + p * ALIGNMENT));
+        }
+    }
+
+    std::size_t offset = vector_size;
+    for (; offset + ALIGNMENT <= size; offset += ALIGNMENT) {
+        _mm512_storeu_si512(dest_ptr + offset, _mm512_loadu_si512(src_ptr + offset));
+    }
+
+    // Finish with one vector ending at the last byte, overlapping bytes already copied
+    if (offset < size) {
+        _mm512_storeu_si512(dest_ptr + size - ALIGNMENT, _mm512_loadu_si512(src_ptr + size - ALIGNMENT));
+    }
+}
+
+} // namespace omm
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2024-present OMM Project Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * File authors:
+ *   - Nima Mehrani <nm@gradientdynamics.com>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <x86intrin.h>
+
+namespace omm::detail {
+
+/**
+ * @brief Reads the time stamp counter.
+ *
+ * Assumes an invariant TSC, which ticks at a constant rate across cores and frequency
+ * changes on all x86-64 processors OMM targets.
+ */
+inline std::uint64_t read_tsc() noexcept {
+    return __rdtsc();
+}
+
+/**
+ * @brief TSC ticks per nanosecond, calibrated once against std::chrono::steady_clock.
+ */
+inline double tsc_ticks_per_ns() noexcept {
+    static const double ticks_per_ns = [] {
+        // Busy-wait for a short window so the measurement isn't skewed by scheduler wakeup
+        constexpr auto CALIBRATION_WINDOW = std::chrono::milliseconds(5);
+        const auto start_time = std::chrono::steady_clock::now();
+        const std::uint64_t start_tsc = read_tsc();
+        auto now = start_time;
+        while (now - start_time < CALIBRATION_WINDOW) {
+            now = std::chrono::steady_clock::now();
+        }
+        const std::uint64_t end_tsc = read_tsc();
+        const auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - start_time).count();
+        return static_cast<double>(end_tsc - start_tsc) / static_cast<double>(elapsed_ns);
+    }();
+    return ticks_per_ns;
+}
+
+inline std::uint64_t ns_to_tsc(std::uint64_t ns) noexcept {
+    return static_cast<std::uint64_t>(static_cast<double>(ns) * tsc_ticks_per_ns());
+}
+
+inline std::uint64_t tsc_to_ns(std::uint64_t ticks) noexcept {
+    return static_cast<std::uint64_t>(static_cast<double>(ticks) / tsc_ticks_per_ns());
+}
+
+} // namespace omm::detail
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+
+namespace omm {
+
+namespace detail {
+
+// Threads map onto this many epoch records; threads beyond it share records, which stays
+// correct but lets their pins contend on one cache line
+inline constexpr std::size_t EPOCH_RECORDS = 128;
+
+// Retired blocks a record collects before its thread tries to advance the epoch and
+// reclaim them
+inline constexpr std::size_t EPOCH_RETIRE_BATCH = 64;
+
+// Record used by the calling thread, assigned round-robin on first use
+inline std::size_t epoch_record_index() noexcept {
+    static std::atomic<std::size_t> next_record{0};
+    thread_local const std::size_t record = next_record.fetch_add(1, std::memory_order_relaxed) % EPOCH_RECORDS;
+    return record;
+}
+
+} // namespace detail
+
+/**
+ * @brief Epoch-based reclamation domain for blocks unlinked from lock-free structures.
+ *
+ * Readers pin the domain for the duration of a traversal with pin(). A writer that unlinks
+ * a block hands it to retire() instead of freeing it, and the block is passed to the
+ * domain's reclaim function once every section pinned before the unlink has ended.
+ *
+ * The global epoch advances only when no section remains pinned in the epoch before it,
+ * so blocks retired in epoch e are safe to free once the epoch reaches e + 2. Each thread
+ * pins by counting itself into its own record, a padded cache line holding one counter per
+ * epoch modulo 3, so readers never write a line another reader writes. Retired blocks
+ * collect in per-record batches; a full batch triggers an attempt to advance the epoch,
+ * and the ready blocks of the batch are handed to the reclaim function in one call.
+ *
+ * Long pinned sections hold back the epoch, and retired blocks accumulate until they end.
+ */
+class epoch {
+public:
+    // A retired block: the pointer and size given to retire()
+    struct block {
+        void* pointer;
+        std::size_t size;
+    };
+
+    // Frees count blocks; context is the pointer given to the constructor
+    using reclaim_func = void (*)(const block* blocks, std::size_t count, void* context);
+
+    // Reclaim functions for blocks from malloc, from mmap, and from a pool with a
+    // deallocate(void*) member passed as the context
+    static void free_blocks(const block* blocks, std::size_t count, void*) noexcept {
+        for (std::size_t i = 0; i < count; ++i) std::free(blocks[i].pointer);
+    }
+
+    static void unmap_blocks(const block* blocks, std::size_t count, void*) noexcept {
+        for (std::size_t i = 0; i < count; ++i) ::munmap(blocks[i].pointer, blocks[i].size);
+    }
+
+    template <typename Pool>
+    static void deallocate_blocks(const block* blocks, std::size_t count, void* pool) noexcept {
+        for (std::size_t i = 0; i < count; ++i) static_cast<Pool*>(pool)->deallocate(blocks[i].pointer);
+    }
+
+    /**
+     * @brief A pinned section; blocks retired after it began stay valid until it is destroyed.
+     */
+    class guard {
+    public:
+        guard(guard&& other) noexcept : count_(other.count_), epoch_(other.epoch_) { other.count_ = nullptr; }
+        guard(const guard&) = delete;
+        guard& operator=(const guard&) = delete;
+        guard& operator=(guard&&) = delete;
+
+        ~guard() {
+            if (count_) count_->fetch_sub(1, std::memory_order_release);
+        }
+
+        // Epoch the section was pinned in
+        std::uint64_t pinned_epoch() const noexcept { return epoch_; }
+
+    private:
+        friend class epoch;
+
+        guard(std::atomic<std::int64_t>* count, std::uint64_t pinned) noexcept : count_(count), epoch_(pinned) {}
+
+        std::atomic<std::int64_t>* count_;
+        std::uint64_t epoch_;
+    };
+
+    /**
+     * @param reclaim Called with batches of blocks that no pinned section can reach.
+     * @param context Passed through to reclaim.
+     * @param batch Retired blocks per record that trigger a reclamation attempt.
+     */
+    explicit epoch(reclaim_func reclaim = free_blocks, void* context = nullptr, std::size_t batch = detail::EPOCH_RETIRE_BATCH) noexcept
+            : reclaim_(reclaim), context_(context), batch_(batch > 0 ? batch : 1) {}
+
+    epoch(const epoch&) = delete;
+    epoch& operator=(const epoch&) = delete;
+
+    // Pinned sections must have ended; every block still retired is reclaimed
+    ~epoch() {
+        for (auto& r : records_) {
+            if (!r.blocks.empty()) reclaim_(r.blocks.data(), r.blocks.size(), context_);
+        }
+    }
+
+    /**
+     * @brief Pins the current epoch. Lock-free: retries only if the epoch advances under it.
+     */
+    guard pin() const noexcept {
+        auto& r = records_[detail::epoch_record_index()];
+        for (;;) {
+            const std::uint64_t e = epoch_.load(std::memory_order_seq_cst);
+            auto& count = r.pinned[e % 3];
+            count.fetch_add(1, std::memory_order_seq_cst);
+            // try_advance() reads the counters after loading the epoch it advances from, so
+            // either it sees this section or this section sees the new epoch
+            if (epoch_.load(std::memory_order_seq_cst) == e) return guard(&count, e);
+            count.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Hands over a block that has been unlinked, to be reclaimed once no pinned section can reach it.
+     *
+     * size is passed through to the reclaim function, e.g. for munmap.
+     * @throws std::bad_alloc if the retire batch cannot grow.
+     */
+    void retire(void* pointer, std::size_t size = 0) {
+        auto& r = records_[detail::epoch_record_index()];
+        std::lock_guard lock(r.mutex);
+        r.blocks.push_back({pointer, size});
+        r.epochs.push_back(epoch_.load(std::memory_order_seq_cst));
+        // Every batch_ retirements, so a stalled reader does not turn each one into a scan
+        if (r.blocks.size() % batch_ == 0) {
+            try_advance();
+            collect(r);
+        }
+    }
+
+    /**
+     * @brief Advances the global epoch if no section is pinned in the epoch before it.
+     * @return Whether the epoch advanced, here or concurrently.
+     */
+    bool try_advance() noexcept {
+        std::uint64_t e = epoch_.load(std::memory_order_seq_cst);
+        for (const auto& r : records_) {
+            if (r.pinned[(e + 2) % 3].load(std::memory_order_seq_cst) != 0) return false;
+        }
+        // A failed exchange means another thread advanced from e first
+        epoch_.compare_exchange_strong(e, e + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    /**
+     * @brief Advances the epoch as far as pinned sections allow and reclaims every ready block.
+     * @return The number of blocks reclaimed.
+     */
+    std::size_t reclaim() noexcept {
+        try_advance();
+        try_advance();
+        std::size_t reclaimed = 0;
+        for (auto& r : records_) {
+            std::lock_guard lock(r.mutex);
+            reclaimed += collect(r);
+        }
+        return reclaimed;
+    }
+
+    /**
+     * @brief Waits until every block retired before the call has been reclaimed.
+     *
+     * Must not be called from a pinned section, which would wait on itself.
+     */
+    void synchronize() noexcept {
+        const std::uint64_t target = epoch_.load(std::memory_order_seq_cst) + 2;
+        while (epoch_.load(std::memory_order_seq_cst) < target) {
+            if (!try_advance()) std::this_thread::yield();
+        }
+        reclaim();
+    }
+
+    // Current global epoch, starting at 0
+    std::uint64_t current() const noexcept { return epoch_.load(std::memory_order_acquire); }
+
+    // Blocks retired and not yet reclaimed
+    std::size_t pending() const noexcept {
+        std::size_t total = 0;
+        for (auto& r : records_) {
+            std::lock_guard lock(r.mutex);
+            total += r.blocks.size();
+        }
+        return total;
+    }
+
+private:
+    struct alignas(64) record {
+        // Sections pinned by the record's threads, per epoch modulo 3; the only line the pin path writes
+        std::atomic<std::int64_t> pinned[3] = {};
+        // Retired blocks and the epoch each was retired in, in retirement order
+        alignas(64) mutable std::mutex mutex;
+        std::vector<block> blocks;
+        std::vector<std::uint64_t> epochs;
+    };
+
+    // Reclaims the oldest blocks of r retired at least two epochs ago; r's mutex is held
+    std::size_t collect(record& r) noexcept {
+        const std::uint64_t e = epoch_.load(std::memory_order_seq_cst);
+        std::size_t ready = 0;
+        while (ready < r.epochs.size() && r.epochs[ready] + 2 <= e) ++ready;
+        if (ready == 0) return 0;
+        reclaim_(r.blocks.data(), ready, context_);
+        r.blocks.erase(r.blocks.begin(), r.blocks.begin() + static_cast<std::ptrdiff_t>(ready));
+        r.epochs.erase(r.epochs.begin(), r.epochs.begin() + static_cast<std::ptrdiff_t>(ready));
+        return ready;
+    }
+
+    reclaim_func reclaim_;
+    void* context_;
+    std::size_t batch_;
+    alignas(64) std::atomic<std::uint64_t> epoch_{0};
+    mutable record records_[detail::EPOCH_RECORDS];
+};
+
+} // namespace omm
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/fill/fill_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/fill/fill_avx2.h"
+#endif
+
+#ifndef OMM_FILL_MAX_PERIOD
+#define OMM_FILL_MAX_PERIOD 4096
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Function pointer type for pattern fill implementations
+using FillPatternFunc = void (*)(void*, std::size_t, const void*, std::size_t);
+
+// Portable fallback, also used for periods longer than OMM_FILL_MAX_PERIOD
+inline void fill_pattern_generic(void* __restrict dest, std::size_t size, const void* __restrict pattern,
+                                 std::size_t period) noexcept {
+    auto* dest_ptr = static_cast<uint8_t*>(dest);
+    for (std::size_t offset = 0; offset < size; offset += period) {
+        std::memcpy(dest_ptr + offset, pattern, size - offset < period ? size - offset : period);
+    }
+}
+
+// Selects the optimal fill implementation based on available CPU features
+inline FillPatternFunc initialize_best_fill_pattern() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return fill_pattern_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return fill_pattern_avx2;
+    #endif
+    return fill_pattern_generic;
+}
+
+static const FillPatternFunc best_fill_pattern = initialize_best_fill_pattern();
+
+} // namespace detail
+
+/**
+ * @brief Fills n bytes at dest by repeating the period-byte pattern.
+ *
+ * The last repetition is truncated if n is not a multiple of period. Large fills use
+ * streaming stores and bypass the cache.
+ */
+__attribute__((nonnull(1, 3)))
+inline void fill_pattern(void* __restrict dest, std::size_t n, const void* __restrict pattern, std::size_t period) noexcept {
+    if (period == 0 || n == 0) return;
+    if (period > OMM_FILL_MAX_PERIOD) {
+        detail::fill_pattern_generic(dest, n, pattern, period);
+        return;
+    }
+    detail::best_fill_pattern(dest, n, pattern, period);
+}
+
+// Fills count 16-bit elements at dest with value
+inline void fill16(void* dest, std::uint16_t value, std::size_t count) noexcept {
+    detail::best_fill_pattern(dest, count * sizeof(value), &value, sizeof(value));
+}
+
+// Fills count 32-bit elements at dest with value
+inline void fill32(void* dest, std::uint32_t value, std::size_t count) noexcept {
+    detail::best_fill_pattern(dest, count * sizeof(value), &value, sizeof(value));
+}
+
+// Fills count 64-bit elements at dest with value, e.g. a NaN-boxed double
+inline void fill64(void* dest, std::uint64_t value, std::size_t count) noexcept {
+    detail::best_fill_pattern(dest, count * sizeof(value), &value, sizeof(value));
+}
+
+// Fills count 16-byte elements at dest with the 16 bytes at value
+inline void fill128(void* dest, const void* value, std::size_t count) noexcept {
+    detail::best_fill_pattern(dest, count * 16, value, 16);
+}
+
+} // namespace omm
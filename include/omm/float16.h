@@ -0,0 +1,104 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+
+namespace omm {
+
+/**
+ * @brief IEEE 754 binary16 value, held as its bit pattern.
+ *
+ * A storage format only: convert to float for arithmetic, with to_float and to_float16
+ * or in bulk with omm::convert_copy.
+ */
+struct float16 {
+    std::uint16_t bits = 0;
+
+    friend constexpr bool operator==(float16, float16) = default;
+};
+
+/**
+ * @brief bfloat16 value (the upper half of a binary32), held as its bit pattern.
+ */
+struct bfloat16 {
+    std::uint16_t bits = 0;
+
+    friend constexpr bool operator==(bfloat16, bfloat16) = default;
+};
+
+/**
+ * @brief Rounds value to the nearest float16, ties to even, with the results of vcvtps2ph.
+ *
+ * Values of at least 65520 in magnitude become infinity, small values become subnormals
+ * or zero, and NaNs stay NaN with the quiet bit set and the top payload bits kept.
+ */
+constexpr float16 to_float16(float value) noexcept {
+    const auto x = std::bit_cast<std::uint32_t>(value);
+    const auto sign = static_cast<std::uint16_t>((x >> 16) & 0x8000);
+    const std::uint32_t magnitude = x & 0x7FFFFFFF;
+
+    if (magnitude > 0x7F800000) return {static_cast<std::uint16_t>(sign | 0x7E00 | ((magnitude >> 13) & 0x3FF))};
+    if (magnitude >= 0x477FF000) return {static_cast<std::uint16_t>(sign | 0x7C00)};
+
+    std::uint32_t shift;
+    std::uint32_t mantissa;
+    if (magnitude >= 0x38800000) {
+        // Normal: rebias the exponent, then drop 13 mantissa bits; a carry out of the
+        // mantissa correctly bumps the exponent
+        shift = 13;
+        mantissa = magnitude - (112u << 23);
+    } else {
+        // Subnormal: the value in units of 2^-24, from the mantissa with its implicit bit
+        shift = 126 - (magnitude >> 23);
+        if (shift > 24) return {sign};
+        mantissa = (magnitude & 0x7FFFFF) | 0x800000;
+    }
+    std::uint32_t result = mantissa >> shift;
+    const std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const std::uint32_t halfway = 1u << (shift - 1);
+    if (remainder > halfway || (remainder == halfway && (result & 1))) ++result;
+    return {static_cast<std::uint16_t>(sign | result)};
+}
+
+/**
+ * @brief Widens a float16 exactly, with the results of vcvtph2ps (signaling NaNs are quieted).
+ */
+constexpr float to_float(float16 value) noexcept {
+    const std::uint32_t sign = static_cast<std::uint32_t>(value.bits & 0x8000) << 16;
+    std::uint32_t exponent = (value.bits >> 10) & 0x1F;
+    std::uint32_t mantissa = value.bits & 0x3FF;
+
+    if (exponent == 0x1F) {
+        const std::uint32_t nan = mantissa ? 0x00400000 : 0;
+        return std::bit_cast<float>(sign | 0x7F800000 | nan | (mantissa << 13));
+    }
+    if (exponent == 0) {
+        if (mantissa == 0) return std::bit_cast<float>(sign);
+        // Subnormal: normalize into a float exponent
+        exponent = 113;
+        while (!(mantissa & 0x400)) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        return std::bit_cast<float>(sign | (exponent << 23) | ((mantissa & 0x3FF) << 13));
+    }
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+/**
+ * @brief Rounds value to the nearest bfloat16, ties to even; NaNs stay NaN with the quiet bit set.
+ */
+constexpr bfloat16 to_bfloat16(float value) noexcept {
+    const auto x = std::bit_cast<std::uint32_t>(value);
+    if ((x & 0x7FFFFFFF) > 0x7F800000) return {static_cast<std::uint16_t>((x | 0x00400000) >> 16)};
+    return {static_cast<std::uint16_t>((x + 0x7FFF + ((x >> 16) & 1)) >> 16)};
+}
+
+/**
+ * @brief Widens a bfloat16 exactly.
+ */
+constexpr float to_float(bfloat16 value) noexcept {
+    return std::bit_cast<float>(static_cast<std::uint32_t>(value.bits) << 16);
+}
+
+} // namespace omm
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "omm/detail/cpu_features.h"
+#include "omm/detail/memcpy/memcpy_fixed.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/gather_rows_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/gather_rows_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Function pointer type for fixed-width gather and scatter implementations
+template <typename Index>
+using RowsFunc = void (*)(void*, const void*, const Index*, std::size_t);
+
+// Portable fallbacks for the specialized widths
+template <std::size_t Width, typename Index>
+inline void gather_rows_generic(void* __restrict dest, const void* __restrict table, const Index* __restrict indices, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        memcpy_fixed<Width>(static_cast<uint8_t*>(dest) + i * Width, static_cast<const uint8_t*>(table) + static_cast<std::size_t>(indices[i]) * Width);
+    }
+}
+
+template <std::size_t Width, typename Index>
+inline void scatter_rows_generic(void* __restrict table, const void* __restrict src, const Index* __restrict indices, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        memcpy_fixed<Width>(static_cast<uint8_t*>(table) + static_cast<std::size_t>(indices[i]) * Width, static_cast<const uint8_t*>(src) + i * Width);
+    }
+}
+
+// Any other width: one memcpy per row, prefetching the row start ahead through the index stream
+inline constexpr std::size_t ROWS_PREFETCH_DISTANCE = 16;
+
+template <typename Index>
+inline void gather_rows_any_width(uint8_t* __restrict dest, const uint8_t* __restrict table, std::size_t row_width,
+                                  const Index* __restrict indices, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i + ROWS_PREFETCH_DISTANCE < count) __builtin_prefetch(table + static_cast<std::size_t>(indices[i + ROWS_PREFETCH_DISTANCE]) * row_width);
+        std::memcpy(dest + i * row_width, table + static_cast<std::size_t>(indices[i]) * row_width, row_width);
+    }
+}
+
+template <typename Index>
+inline void scatter_rows_any_width(uint8_t* __restrict table, const uint8_t* __restrict src, std::size_t row_width,
+                                   const Index* __restrict indices, std::size_t count) noexcept {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i + ROWS_PREFETCH_DISTANCE < count) __builtin_prefetch(table + static_cast<std::size_t>(indices[i + ROWS_PREFETCH_DISTANCE]) * row_width, 1);
+        std::memcpy(table + static_cast<std::size_t>(indices[i]) * row_width, src + i * row_width, row_width);
+    }
+}
+
+// Selects the optimal kernels for a row width based on available CPU features
+template <std::size_t Width, typename Index>
+inline RowsFunc<Index> initialize_best_gather_rows() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return gather_rows_avx512<Width, Index>;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return gather_rows_avx2<Width, Index>;
+    #endif
+    return gather_rows_generic<Width, Index>;
+}
+
+template <std::size_t Width, typename Index>
+inline RowsFunc<Index> initialize_best_scatter_rows() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return scatter_rows_avx512<Width, Index>;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return scatter_rows_avx2<Width, Index>;
+    #endif
+    return scatter_rows_generic<Width, Index>;
+}
+
+template <std::size_t Width, typename Index>
+inline const RowsFunc<Index> best_gather_rows = initialize_best_gather_rows<Width, Index>();
+
+template <std::size_t Width, typename Index>
+inline const RowsFunc<Index> best_scatter_rows = initialize_best_scatter_rows<Width, Index>();
+
+} // namespace detail
+
+/**
+ * @brief Copies row indices[i] of table to row i of dest, for count rows of row_width bytes.
+ *
+ * Materializes rows selected by an index vector. The cost is dominated by cache misses
+ * on table, so rows are prefetched ahead through the index stream.
+ * - Rows of 8, 16, 32, 64 and 128 bytes use straight-line copies specialized for the
+ *   width. On AVX-512, 8-byte rows are fetched eight at a time with vpgatherqq.
+ * - Outputs of at least the L3 size use streaming stores.
+ * - Other widths copy each row with memcpy.
+ *
+ * Indices must select rows within table. dest must not overlap table.
+ */
+template <typename Index>
+__attribute__((hot, nonnull(1, 2)))
+inline void gather_rows(void* __restrict dest, const void* __restrict table, std::size_t row_width,
+                        const Index* __restrict indices, std::size_t count) noexcept {
+    static_assert(std::is_integral_v<Index>, "gather_rows needs integer row indices");
+    switch (row_width) {
+        case 8: detail::best_gather_rows<8, Index>(dest, table, indices, count); return;
+        case 16: detail::best_gather_rows<16, Index>(dest, table, indices, count); return;
+        case 32: detail::best_gather_rows<32, Index>(dest, table, indices, count); return;
+        case 64: detail::best_gather_rows<64, Index>(dest, table, indices, count); return;
+        case 128: detail::best_gather_rows<128, Index>(dest, table, indices, count); return;
+        default:
+            detail::gather_rows_any_width(static_cast<uint8_t*>(dest), static_cast<const uint8_t*>(table), row_width, indices, count);
+    }
+}
+
+/**
+ * @brief Copies row i of src to row indices[i] of table, for count rows of row_width bytes.
+ *
+ * The inverse of gather_rows. Rows are written in order, so a repeated index keeps the
+ * last of its rows. Target rows are prefetched for ownership ahead through the index
+ * stream. Whole-line rows are streamed instead when the output is at least the L3 size
+ * and table is 64-byte aligned.
+ */
+template <typename Index>
+__attribute__((hot, nonnull(1, 2)))
+inline void scatter_rows(void* __restrict table, const void* __restrict src, std::size_t row_width,
+                         const Index* __restrict indices, std::size_t count) noexcept {
+    static_assert(std::is_integral_v<Index>, "scatter_rows needs integer row indices");
+    switch (row_width) {
+        case 8: detail::best_scatter_rows<8, Index>(table, src, indices, count); return;
+        case 16: detail::best_scatter_rows<16, Index>(table, src, indices, count); return;
+        case 32: detail::best_scatter_rows<32, Index>(table, src, indices, count); return;
+        case 64: detail::best_scatter_rows<64, Index>(table, src, indices, count); return;
+        case 128: detail::best_scatter_rows<128, Index>(table, src, indices, count); return;
+        default:
+            detail::scatter_rows_any_width(static_cast<uint8_t*>(table), static_cast<const uint8_t*>(src), row_width, indices, count);
+    }
+}
+
+} // namespace omm
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/interleave_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/interleave_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Channel counts and sample widths the interleave kernels are built for
+template <std::size_t Channels, typename T>
+inline constexpr bool is_interleave_supported_v =
+        Channels >= 2 && Channels <= 8 && (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4) && std::is_trivially_copyable_v<T>;
+
+// Function pointer types for interleave and deinterleave implementations
+template <typename T>
+using InterleaveFunc = void (*)(T*, const T* const*, std::size_t);
+
+template <typename T>
+using DeinterleaveFunc = void (*)(T* const*, const T*, std::size_t);
+
+// Portable fallbacks: one sample at a time
+template <std::size_t Channels, typename T>
+inline void interleave_generic(T* __restrict dest, const T* const* planes, std::size_t frames) noexcept {
+    for (std::size_t i = 0; i < frames; ++i) {
+        for (std::size_t c = 0; c < Channels; ++c) dest[i * Channels + c] = planes[c][i];
+    }
+}
+
+template <std::size_t Channels, typename T>
+inline void deinterleave_generic(T* const* planes, const T* __restrict src, std::size_t frames) noexcept {
+    for (std::size_t i = 0; i < frames; ++i) {
+        for (std::size_t c = 0; c < Channels; ++c) planes[c][i] = src[i * Channels + c];
+    }
+}
+
+// Selects the optimal kernels based on available CPU features. The AVX-512 kernels also
+// need AVX-512BW, and VBMI for 8-bit samples.
+template <std::size_t Channels, typename T>
+inline InterleaveFunc<T> initialize_best_interleave() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512bw() && (sizeof(T) != 1 || cpu_supports_avx512vbmi())) return interleave_avx512<Channels, T>;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return interleave_avx2<Channels, T>;
+    #endif
+    return interleave_generic<Channels, T>;
+}
+
+template <std::size_t Channels, typename T>
+inline DeinterleaveFunc<T> initialize_best_deinterleave() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512bw() && (sizeof(T) != 1 || cpu_supports_avx512vbmi())) return deinterleave_avx512<Channels, T>;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return deinterleave_avx2<Channels, T>;
+    #endif
+    return deinterleave_generic<Channels, T>;
+}
+
+template <std::size_t Channels, typename T>
+inline const InterleaveFunc<T> best_interleave = initialize_best_interleave<Channels, T>();
+
+template <std::size_t Channels, typename T>
+inline const DeinterleaveFunc<T> best_deinterleave = initialize_best_deinterleave<Channels, T>();
+
+} // namespace detail
+
+/**
+ * @brief Interleaves Channels planar buffers into packed frames.
+ *
+ * Frame i of dest is planes[0][i], planes[1][i], ..., planes[Channels - 1][i]. Channels
+ * is 2 to 8 and samples are 1, 2 or 4 bytes, so each shuffle sequence is fixed at
+ * compile time. Outputs of at least the L3 size are written with streaming stores. dest
+ * must not overlap the planes.
+ */
+template <std::size_t Channels, typename T>
+__attribute__((always_inline, hot, nonnull(1, 2)))
+inline void interleave(T* __restrict dest, const T* const* planes, std::size_t frames) noexcept {
+    static_assert(detail::is_interleave_supported_v<Channels, T>, "interleave supports 2 to 8 channels of 1, 2 or 4-byte samples");
+    detail::best_interleave<Channels, T>(dest, planes, frames);
+}
+
+/**
+ * @brief Splits packed frames into Channels planar buffers; the inverse of interleave.
+ *
+ * The planes must not overlap src or each other.
+ */
+template <std::size_t Channels, typename T>
+__attribute__((always_inline, hot, nonnull(1, 2)))
+inline void deinterleave(T* const* planes, const T* __restrict src, std::size_t frames) noexcept {
+    static_assert(detail::is_interleave_supported_v<Channels, T>, "deinterleave supports 2 to 8 channels of 1, 2 or 4-byte samples");
+    detail::best_deinterleave<Channels, T>(planes, src, frames);
+}
+
+} // namespace omm
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <new>
+#include <utility>
+#include <vector>
+#include <sys/uio.h>
+
+#include "omm/concat.h"
+#include "omm/memcpy.h"
+#include "omm/detail/memory/block_pool.h"
+#include "omm/detail/memory/huge_pages.h"
+
+namespace omm {
+
+namespace detail {
+
+// Size of the pooled blocks, header included; larger payloads get a block of their own
+inline constexpr std::size_t IOBUF_BLOCK_SIZE = 64 * 1024;
+
+// Refcounted storage shared by the iobuf segments that point into it. The payload
+// follows the header.
+struct alignas(64) iobuf_block {
+    enum class source : std::uint8_t { pool, mapped, heap };
+
+    std::atomic<std::uint32_t> refs{1};
+    source origin;
+    std::size_t capacity;  // Payload bytes
+    std::size_t used = 0;  // Payload bytes written; appends extend this while unshared
+
+    std::uint8_t* data() noexcept { return reinterpret_cast<std::uint8_t*>(this + 1); }
+};
+
+inline block_pool& iobuf_pool() {
+    // Never destroyed, so iobufs with static storage duration may outlive it
+    static block_pool* pool = new block_pool(IOBUF_BLOCK_SIZE);
+    return *pool;
+}
+
+// Returns a block with room for at least min_capacity payload bytes
+inline iobuf_block* iobuf_block_allocate(std::size_t min_capacity) {
+    const std::size_t bytes = sizeof(iobuf_block) + min_capacity;
+    void* memory;
+    auto origin = iobuf_block::source::heap;
+    std::size_t capacity = min_capacity;
+    if (bytes <= IOBUF_BLOCK_SIZE) {
+        memory = iobuf_pool().allocate();
+        origin = iobuf_block::source::pool;
+        capacity = IOBUF_BLOCK_SIZE - sizeof(iobuf_block);
+    } else if (bytes >= HUGE_PAGE_SIZE && (memory = map_huge_pages(round_to_huge_pages(bytes)))) {
+        origin = iobuf_block::source::mapped;
+        capacity = round_to_huge_pages(bytes) - sizeof(iobuf_block);
+    } else {
+        memory = ::operator new(bytes, std::align_val_t{alignof(iobuf_block)});
+    }
+
+    auto* block = new (memory) iobuf_block;
+    block->origin = origin;
+    block->capacity = capacity;
+    return block;
+}
+
+inline void iobuf_block_acquire(iobuf_block* block) noexcept {
+    block->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline void iobuf_block_release(iobuf_block* block) noexcept {
+    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    const auto origin = block->origin;
+    const std::size_t bytes = sizeof(iobuf_block) + block->capacity;
+    block->~iobuf_block();
+    switch (origin) {
+        case iobuf_block::source::pool:
+            iobuf_pool().deallocate(block);
+            break;
+        case iobuf_block::source::mapped:
+            unmap_huge_pages(block, bytes);
+            break;
+        case iobuf_block::source::heap:
+            ::operator delete(block, std::align_val_t{alignof(iobuf_block)});
+            break;
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief A byte sequence held as a chain of slices of refcounted blocks.
+ *
+ * Copying, slicing, splitting and joining iobufs only adjusts slice bounds and block
+ * reference counts, so payloads pass between pipeline stages without being copied.
+ * Bytes are copied in only by the constructor and append(data, n), which fill the tail
+ * room of an unshared last block first, and copied out only by coalesce() and
+ * copy_to(). Appended bytes go into IOBUF_BLOCK_SIZE blocks from a pool carved out of
+ * huge pages; only coalesce() allocates larger blocks.
+ *
+ * Blocks are never written once shared, so iobufs that share blocks may be used from
+ * different threads. A single iobuf is not thread-safe.
+ */
+class iobuf {
+public:
+    iobuf() = default;
+
+    // Copies n bytes from data into pooled blocks
+    iobuf(const void* data, std::size_t n) {
+        append(data, n);
+    }
+
+    iobuf(const iobuf& other) : segments_(other.segments_), size_(other.size_) {
+        for (const segment& s : segments_) detail::iobuf_block_acquire(s.block);
+    }
+
+    iobuf(iobuf&& other) : segments_(std::move(other.segments_)), size_(std::exchange(other.size_, 0)) {
+        other.segments_.clear();
+    }
+
+    iobuf& operator=(const iobuf& other) {
+        if (this != &other) *this = iobuf(other);
+        return *this;
+    }
+
+    iobuf& operator=(iobuf&& other) {
+        if (this != &other) {
+            clear();
+            segments_ = std::move(other.segments_);
+            size_ = std::exchange(other.size_, 0);
+            other.segments_.clear();
+        }
+        return *this;
+    }
+
+    ~iobuf() {
+        clear();
+    }
+
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+    std::size_t segment_count() const noexcept { return segments_.size(); }
+
+    void clear() noexcept {
+        for (const segment& s : segments_) detail::iobuf_block_release(s.block);
+        segments_.clear();
+        size_ = 0;
+    }
+
+    /**
+     * @brief Copies n bytes onto the end, into the last block's tail room while it is
+     *        unshared and into new blocks after that.
+     */
+    void append(const void* data, std::size_t n) {
+        const auto* src = static_cast<const std::uint8_t*>(data);
+        if (n == 0) return;
+
+        if (!segments_.empty()) {
+            segment& last = segments_.back();
+            detail::iobuf_block* block = last.block;
+            if (block->refs.load(std::memory_order_acquire) == 1 && last.data + last.size == block->data() + block->used) {
+                const std::size_t room = std::min(n, block->capacity - block->used);
+                omm::memcpy(last.data + last.size, src, room);
+                last.size += room;
+                block->used += room;
+                size_ += room;
+                src += room;
+                n -= room;
+            }
+        }
+        if (n == 0) return;
+
+        // Large payloads are spread over pooled blocks, which are recycled already faulted in
+        while (n > 0) {
+            detail::iobuf_block* block = detail::iobuf_block_allocate(std::min(n, detail::IOBUF_BLOCK_SIZE - sizeof(detail::iobuf_block)));
+            push_back_block(block);
+            const std::size_t take = std::min(n, block->capacity);
+            omm::memcpy(block->data(), src, take);
+            block->used = take;
+            segments_.back().size = take;
+            size_ += take;
+            src += take;
+            n -= take;
+        }
+    }
+
+    // Moves the segments of other onto the end; pass a copy to share rather than take them
+    void append(iobuf other) {
+        const std::size_t before = segments_.size();
+        try {
+            for (const segment& s : other.segments_) segments_.push_back(s);
+        } catch (...) {
+            segments_.resize(before);
+            throw;
+        }
+        size_ += std::exchange(other.size_, 0);
+        other.segments_.clear();
+    }
+
+    // Moves the segments of other onto the front
+    void prepend(iobuf other) {
+        std::size_t added = 0;
+        try {
+            for (auto it = other.segments_.rbegin(); it != other.segments_.rend(); ++it, ++added) segments_.push_front(*it);
+        } catch (...) {
+            segments_.erase(segments_.begin(), segments_.begin() + static_cast<std::ptrdiff_t>(added));
+            throw;
+        }
+        size_ += std::exchange(other.size_, 0);
+        other.segments_.clear();
+    }
+
+    /**
+     * @brief Returns n bytes starting at offset, sharing this iobuf's blocks.
+     *
+     * The range is clamped to the end of the iobuf.
+     */
+    iobuf slice(std::size_t offset, std::size_t n) const {
+        iobuf result;
+        offset = std::min(offset, size_);
+        n = std::min(n, size_ - offset);
+        for (auto it = segments_.begin(); it != segments_.end() && n > 0; ++it) {
+            if (offset >= it->size) {
+                offset -= it->size;
+                continue;
+            }
+            const std::size_t take = std::min(n, it->size - offset);
+            result.segments_.push_back({it->block, it->data + offset, take});
+            detail::iobuf_block_acquire(it->block);
+            result.size_ += take;
+            n -= take;
+            offset = 0;
+        }
+        return result;
+    }
+
+    /**
+     * @brief Removes the first n bytes and returns them, clamped to size().
+     *
+     * Only the segment containing the split point is shared between the two halves.
+     */
+    iobuf split(std::size_t n) {
+        iobuf head;
+        n = std::min(n, size_);
+        while (n > 0) {
+            segment& first = segments_.front();
+            if (first.size <= n) {
+                head.segments_.push_back(first);
+                head.size_ += first.size;
+                size_ -= first.size;
+                n -= first.size;
+                segments_.pop_front();
+            } else {
+                head.segments_.push_back({first.block, first.data, n});
+                detail::iobuf_block_acquire(first.block);
+                head.size_ += n;
+                first.data += n;
+                first.size -= n;
+                size_ -= n;
+                n = 0;
+            }
+        }
+        return head;
+    }
+
+    /**
+     * @brief Makes the contents contiguous and returns a pointer to them.
+     *
+     * Free when there is at most one segment; otherwise the segments are gathered into
+     * one new block with omm::concat, which streams outputs larger than the L3 cache.
+     * Returns nullptr for an empty iobuf.
+     */
+    const void* coalesce() {
+        if (segments_.empty()) return nullptr;
+        if (segments_.size() == 1) return segments_.front().data;
+
+        const std::vector<iovec> slices = iovecs();
+        detail::iobuf_block* block = detail::iobuf_block_allocate(size_);
+        omm::concat(block->data(), slices);
+        block->used = size_;
+
+        const std::size_t size = size_;
+        clear();
+        push_back_block(block);
+        segments_.back().size = size;
+        size_ = size;
+        return block->data();
+    }
+
+    /**
+     * @brief Copies the contents into dest, which must hold size() bytes.
+     * @return The number of bytes copied.
+     */
+    std::size_t copy_to(void* dest) const {
+        const std::vector<iovec> slices = iovecs();
+        return omm::concat(dest, slices);
+    }
+
+    // One iovec per segment, in order, for writev and similar calls
+    std::vector<iovec> iovecs() const {
+        std::vector<iovec> result;
+        result.reserve(segments_.size());
+        for (const segment& s : segments_) result.push_back({s.data, s.size});
+        return result;
+    }
+
+private:
+    struct segment {
+        detail::iobuf_block* block;
+        std::uint8_t* data;
+        std::size_t size;
+    };
+
+    // Adds an empty segment for a new block, releasing the block if that throws
+    void push_back_block(detail::iobuf_block* block) {
+        try {
+            segments_.push_back({block, block->data(), 0});
+        } catch (...) {
+            detail::iobuf_block_release(block);
+            throw;
+        }
+    }
+
+    std::deque<segment> segments_;
+    std::size_t size_ = 0;
+};
+
+} // namespace omm
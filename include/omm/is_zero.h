@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/scan/is_zero_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/scan/is_zero_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Function pointer types for zero scan implementations
+using IsZeroFunc = bool (*)(const void*, std::size_t);
+using FindNonzeroFunc = std::size_t (*)(const void*, std::size_t);
+
+// Returns true if the n bytes at ptr are all zero
+inline bool is_zero_generic(const void* ptr, std::size_t n) noexcept {
+    const auto* bytes = static_cast<const uint8_t*>(ptr);
+    std::uint64_t acc = 0;
+    std::size_t i = 0;
+    for (; i + sizeof(acc) <= n; i += sizeof(acc)) {
+        std::uint64_t word;
+        __builtin_memcpy(&word, bytes + i, sizeof(word));
+        acc |= word;
+    }
+    for (; i < n; ++i) acc |= bytes[i];
+    return acc == 0;
+}
+
+// Portable first non-zero search, a word at a time
+inline std::size_t find_first_nonzero_generic(const void* ptr, std::size_t n) noexcept {
+    const auto* bytes = static_cast<const uint8_t*>(ptr);
+    std::size_t i = 0;
+    for (; i + sizeof(std::uint64_t) <= n; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        __builtin_memcpy(&word, bytes + i, sizeof(word));
+        if (word != 0) return i + static_cast<std::size_t>(__builtin_ctzll(word)) / 8;
+    }
+    for (; i < n; ++i) {
+        if (bytes[i] != 0) return i;
+    }
+    return n;
+}
+
+// Selects the optimal zero scans based on available CPU features
+inline IsZeroFunc initialize_best_is_zero() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return is_zero_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return is_zero_avx2;
+    #endif
+    return is_zero_generic;
+}
+
+inline FindNonzeroFunc initialize_best_find_first_nonzero() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return find_first_nonzero_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return find_first_nonzero_avx2;
+    #endif
+    return find_first_nonzero_generic;
+}
+
+static const IsZeroFunc best_is_zero = initialize_best_is_zero();
+static const FindNonzeroFunc best_find_first_nonzero = initialize_best_find_first_nonzero();
+
+// Work unit of the parallel scans
+inline constexpr std::size_t PARALLEL_SCAN_CHUNK = 4 * 1024 * 1024;
+
+} // namespace detail
+
+// Inputs below this size are scanned on the calling thread by the parallel variants
+inline constexpr std::size_t PARALLEL_SCAN_THRESHOLD = 64 * 1024 * 1024;
+
+/**
+ * @brief Returns true if the n bytes at ptr are all zero, stopping at the first
+ *        non-zero block.
+ */
+__attribute__((always_inline, hot, artificial))
+inline bool is_zero(const void* ptr, std::size_t n) noexcept {
+    return detail::best_is_zero(ptr, n);
+}
+
+/**
+ * @brief Returns the index of the first non-zero byte among the n bytes at ptr, or n if
+ *        they are all zero.
+ */
+__attribute__((always_inline, hot, artificial))
+inline std::size_t find_first_nonzero(const void* ptr, std::size_t n) noexcept {
+    return detail::best_find_first_nonzero(ptr, n);
+}
+
+/**
+ * @brief find_first_nonzero for multi-gigabyte regions, split across threads.
+ *
+ * Threads claim PARALLEL_SCAN_CHUNK chunks in address order and keep the lowest hit.
+ * Chunks are claimed in increasing order, so once any hit is found no new chunk can
+ * precede it and the threads stop after their current chunk.
+ *
+ * @param threads Threads to use, including the caller; 0 for one per hardware thread.
+ */
+inline std::size_t find_first_nonzero_parallel(const void* ptr, std::size_t n, unsigned threads = 0) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t chunks = (n + detail::PARALLEL_SCAN_CHUNK - 1) / detail::PARALLEL_SCAN_CHUNK;
+    threads = static_cast<unsigned>(std::min<std::size_t>(threads, chunks));
+    if (n < PARALLEL_SCAN_THRESHOLD || threads <= 1) return find_first_nonzero(ptr, n);
+
+    const auto* bytes = static_cast<const uint8_t*>(ptr);
+    std::atomic<std::size_t> next_chunk{0};
+    std::atomic<std::size_t> first{n};
+
+    auto worker = [&] {
+        for (;;) {
+            const std::size_t start = next_chunk.fetch_add(1, std::memory_order_relaxed) * detail::PARALLEL_SCAN_CHUNK;
+            if (start >= n || start >= first.load(std::memory_order_relaxed)) return;
+
+            const std::size_t length = std::min(detail::PARALLEL_SCAN_CHUNK, n - start);
+            const std::size_t hit = find_first_nonzero(bytes + start, length);
+            if (hit < length) {
+                std::size_t current = first.load(std::memory_order_relaxed);
+                while (start + hit < current && !first.compare_exchange_weak(current, start + hit, std::memory_order_relaxed)) {}
+                return;
+            }
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    helpers.reserve(threads - 1);
+    for (unsigned t = 1; t < threads; ++t) helpers.emplace_back(worker);
+    worker();
+    for (auto& helper : helpers) helper.join();
+    return first.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief is_zero for multi-gigabyte regions, split across threads; stops all threads
+ *        soon after any of them finds a non-zero byte.
+ *
+ * @param threads Threads to use, including the caller; 0 for one per hardware thread.
+ */
+inline bool is_zero_parallel(const void* ptr, std::size_t n, unsigned threads = 0) {
+    return find_first_nonzero_parallel(ptr, n, threads) == n;
+}
+
+} // namespace omm
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <immintrin.h>
+
+#include "omm/memcpy.h"
+#include "omm/detail/memory/huge_pages.h"
+
+namespace omm {
+
+/**
+ * @brief Multi-producer append-only log split into fixed-size segments.
+ *
+ * Producers reserve space in the current segment with one fetch_add and copy their
+ * record in place; records of STREAM_THRESHOLD bytes or more are written with
+ * streaming stores so the log does not evict the producers' working set. The producer
+ * whose reservation crosses the end of a segment seals it and moves everyone on to the
+ * next one. A segment is handed to the flusher once it is sealed and every record in it
+ * has been copied, tracked by a second counter; no step takes a lock.
+ *
+ * Segments form a ring. A single flusher thread takes completed segments in order with
+ * poll() and returns them with release(); producers wait for the flusher when the ring
+ * is full. Records are stored back to back, so framing is up to the caller.
+ */
+class log_buffer {
+public:
+    // Records at least this large are copied with streaming stores
+    static constexpr std::size_t STREAM_THRESHOLD = 4096;
+
+    /**
+     * @brief A completed segment, valid until it is passed to release().
+     */
+    struct segment {
+        const void* data;
+        std::size_t size;
+        std::uint64_t sequence;
+    };
+
+    /**
+     * @param segment_size Bytes per segment, which is also the largest record.
+     * @param segment_count Segments in the ring, at least 2.
+     * @throws std::invalid_argument if segment_size is 0 or segment_count is below 2.
+     * @throws std::bad_alloc if the segments cannot be allocated.
+     */
+    explicit log_buffer(std::size_t segment_size, std::size_t segment_count = 4)
+            : segment_size_(segment_size), segment_count_(segment_count) {
+        if (segment_size == 0 || segment_count < 2) {
+            throw std::invalid_argument("log_buffer needs a non-zero segment size and at least 2 segments");
+        }
+        slots_ = std::make_unique<slot[]>(segment_count);
+        for (std::size_t i = 0; i < segment_count; ++i) {
+            slots_[i].free.store(i, std::memory_order_relaxed);
+        }
+
+        // Buffers of at least a huge page are mapped; smaller ones, or failed mappings, use operator new
+        const std::size_t bytes = segment_size * segment_count;
+        if (bytes >= detail::HUGE_PAGE_SIZE) {
+            data_ = static_cast<uint8_t*>(detail::map_huge_pages(detail::round_to_huge_pages(bytes)));
+            mapped_ = data_ != nullptr;
+        }
+        if (!data_) {
+            data_ = static_cast<uint8_t*>(::operator new(bytes, std::align_val_t{64}));
+        }
+    }
+
+    log_buffer(const log_buffer&) = delete;
+    log_buffer& operator=(const log_buffer&) = delete;
+
+    ~log_buffer() {
+        if (mapped_) {
+            detail::unmap_huge_pages(data_, detail::round_to_huge_pages(segment_size_ * segment_count_));
+        } else {
+            ::operator delete(data_, std::align_val_t{64});
+        }
+    }
+
+    /**
+     * @brief Appends a record of n bytes.
+     * @return false if the record is larger than a segment.
+     */
+    __attribute__((nonnull(2)))
+    bool append(const void* __restrict record, std::size_t n) noexcept {
+        if (n > segment_size_) return false;
+        if (n == 0) return true;
+
+        for (;;) {
+            const std::uint64_t sequence = current_.load(std::memory_order_acquire);
+            slot& s = slots_[sequence % segment_count_];
+            const std::uint64_t offset = s.reserved.fetch_add(n, std::memory_order_acq_rel);
+
+            if (offset + n <= segment_size_) {
+                // The slot may have been recycled since current_ was read; the reservation
+                // is then in the newer segment, which is just as good
+                uint8_t* dest = data_ + (sequence % segment_count_) * segment_size_ + offset;
+                if (n >= STREAM_THRESHOLD) {
+                    detail::best_memcpy_stream(dest, record, n);
+                    _mm_sfence();
+                } else {
+                    __builtin_memcpy(dest, record, n);
+                }
+                commit(s, n);
+                return true;
+            }
+            if (offset <= segment_size_) {
+                // This reservation crossed the end: seal the segment and retry in the next one
+                seal(s, offset);
+            } else {
+                wait_for_next(sequence);
+            }
+        }
+    }
+
+    /**
+     * @brief Seals the current segment so its records reach the flusher without waiting
+     *        for it to fill. Does nothing if the segment is empty.
+     *
+     * Waits for a free segment to move on to, so the flusher thread itself should only
+     * call it after releasing every segment it has taken.
+     */
+    void flush() noexcept {
+        const std::uint64_t sequence = current_.load(std::memory_order_acquire);
+        slot& s = slots_[sequence % segment_count_];
+        if (s.reserved.load(std::memory_order_relaxed) == 0) return;
+
+        // Reserving more than a segment always crosses the end, unless already sealed
+        const std::uint64_t offset = s.reserved.fetch_add(segment_size_ + 1, std::memory_order_acq_rel);
+        if (offset <= segment_size_) seal(s, offset);
+    }
+
+    /**
+     * @brief Returns the next completed segment in sequence order, if there is one.
+     *
+     * Flusher thread only. The same segment is returned until it is released.
+     */
+    std::optional<segment> poll() const noexcept {
+        const slot& s = slots_[next_flush_ % segment_count_];
+        if (s.ready.load(std::memory_order_acquire) != next_flush_ + 1) return std::nullopt;
+        return segment{data_ + (next_flush_ % segment_count_) * segment_size_, s.used, next_flush_};
+    }
+
+    /**
+     * @brief Returns the segment last given by poll() to the producers. Flusher thread only.
+     */
+    void release(const segment& done) noexcept {
+        slots_[done.sequence % segment_count_].free.store(done.sequence + segment_count_, std::memory_order_release);
+        ++next_flush_;
+    }
+
+    std::size_t segment_size() const noexcept { return segment_size_; }
+    std::size_t segment_count() const noexcept { return segment_count_; }
+
+private:
+    // Per-segment state. The counters producers hit on every append get their own cache lines.
+    struct slot {
+        alignas(64) std::atomic<std::uint64_t> reserved{0};   // Bytes handed out; past segment_size_ once sealed
+        alignas(64) std::atomic<std::uint64_t> committed{0};  // Bytes copied, plus the unused tail and 1 once sealed
+        alignas(64) std::atomic<std::uint64_t> ready{0};      // sequence + 1 once complete
+        std::atomic<std::uint64_t> free{0};                   // Sequence this slot may hold next
+        std::uint64_t sequence = 0;
+        std::size_t used = 0;                                 // Bytes of records, set when sealed
+    };
+
+    // Counts n bytes as copied. Only the seal adds the extra 1, so the total reaches
+    // segment_size_ + 1 exactly when the segment is sealed and every copy is done.
+    void commit(slot& s, std::uint64_t n) noexcept {
+        if (s.committed.fetch_add(n, std::memory_order_acq_rel) + n == segment_size_ + 1) {
+            s.ready.store(s.sequence + 1, std::memory_order_release);
+        }
+    }
+
+    // Closes s with offset bytes of records and makes the following segment current
+    void seal(slot& s, std::uint64_t offset) noexcept {
+        const std::uint64_t sequence = s.sequence;
+        s.used = offset;
+        commit(s, segment_size_ - offset + 1);
+
+        // A producer holding a stale sequence can seal a recycled slot before the previous
+        // segment has moved current_ on; keep current_ advancing in order
+        while (current_.load(std::memory_order_acquire) != sequence) std::this_thread::yield();
+
+        const std::uint64_t next = sequence + 1;
+        slot& n = slots_[next % segment_count_];
+        while (n.free.load(std::memory_order_acquire) != next) std::this_thread::yield();
+        n.sequence = next;
+        n.used = 0;
+        n.committed.store(0, std::memory_order_relaxed);
+        n.reserved.store(0, std::memory_order_release);
+        current_.store(next, std::memory_order_release);
+    }
+
+    void wait_for_next(std::uint64_t sequence) const noexcept {
+        while (current_.load(std::memory_order_acquire) == sequence) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::size_t segment_size_;
+    std::size_t segment_count_;
+    uint8_t* data_ = nullptr;
+    bool mapped_ = false;
+    std::unique_ptr<slot[]> slots_;
+    alignas(64) std::atomic<std::uint64_t> current_{0};
+    alignas(64) std::uint64_t next_flush_ = 0;
+};
+
+} // namespace omm
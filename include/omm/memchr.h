@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/scan/memchr_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/scan/memchr_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Membership test against byte_set nibble tables, used by the portable search
+constexpr bool nibble_tables_contain(const std::uint8_t* tables, std::uint8_t byte) noexcept {
+    return (tables[(byte >> 7) * 16 + (byte & 0x0F)] >> ((byte >> 4) & 7)) & 1;
+}
+
+} // namespace detail
+
+/**
+ * @brief A set of byte values for find_any_of.
+ *
+ * Stored as the 32-byte nibble tables the vector kernels classify with: entry lo of the
+ * first half has bit h set when byte (h << 4 | lo) is in the set, for h below 8, and
+ * the second half covers h from 8. Any set can be represented, so searches are exact.
+ */
+class byte_set {
+public:
+    constexpr byte_set() noexcept = default;
+
+    constexpr byte_set(std::string_view bytes) noexcept {
+        for (char c : bytes) insert(static_cast<std::uint8_t>(c));
+    }
+
+    constexpr void insert(std::uint8_t byte) noexcept {
+        tables_[(byte >> 7) * 16 + (byte & 0x0F)] |= static_cast<std::uint8_t>(1u << ((byte >> 4) & 7));
+    }
+
+    constexpr bool contains(std::uint8_t byte) const noexcept {
+        return detail::nibble_tables_contain(tables_, byte);
+    }
+
+    const std::uint8_t* tables() const noexcept { return tables_; }
+
+private:
+    alignas(32) std::uint8_t tables_[32] = {};
+};
+
+namespace detail {
+
+// Function pointer types for byte search implementations
+using MemchrFunc = const void* (*)(const void*, int, std::size_t);
+using FindAnyOfFunc = const void* (*)(const void*, std::size_t, const std::uint8_t*);
+
+inline const void* memchr_generic(const void* ptr, int c, std::size_t n) noexcept {
+    return std::memchr(ptr, c, n);
+}
+
+// Portable backward search
+inline const void* memrchr_generic(const void* ptr, int c, std::size_t n) noexcept {
+    const auto* bytes = static_cast<const std::uint8_t*>(ptr);
+    const auto needle = static_cast<std::uint8_t>(c);
+    while (n > 0) {
+        if (bytes[--n] == needle) return bytes + n;
+    }
+    return nullptr;
+}
+
+// Portable set search, one table lookup per byte
+inline const void* find_any_of_generic(const void* ptr, std::size_t n, const std::uint8_t* tables) noexcept {
+    const auto* bytes = static_cast<const std::uint8_t*>(ptr);
+    for (std::size_t i = 0; i < n; ++i) {
+        if (nibble_tables_contain(tables, bytes[i])) return bytes + i;
+    }
+    return nullptr;
+}
+
+// Selects the optimal byte searches based on available CPU features. The AVX-512
+// kernels also need AVX-512BW for byte compares.
+inline MemchrFunc initialize_best_memchr() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512bw()) return memchr_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return memchr_avx2;
+    #endif
+    return memchr_generic;
+}
+
+inline MemchrFunc initialize_best_memrchr() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512bw()) return memrchr_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return memrchr_avx2;
+    #endif
+    return memrchr_generic;
+}
+
+inline FindAnyOfFunc initialize_best_find_any_of() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f() && cpu_supports_avx512bw()) return find_any_of_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return find_any_of_avx2;
+    #endif
+    return find_any_of_generic;
+}
+
+static const MemchrFunc best_memchr = initialize_best_memchr();
+static const MemchrFunc best_memrchr = initialize_best_memrchr();
+static const FindAnyOfFunc best_find_any_of = initialize_best_find_any_of();
+
+} // namespace detail
+
+/**
+ * @brief Returns a pointer to the first byte equal to (unsigned char)c among the n
+ *        bytes at ptr, or nullptr.
+ */
+__attribute__((always_inline, hot, artificial))
+inline const void* memchr(const void* ptr, int c, std::size_t n) noexcept {
+    return detail::best_memchr(ptr, c, n);
+}
+
+/**
+ * @brief Returns a pointer to the last byte equal to (unsigned char)c among the n
+ *        bytes at ptr, or nullptr.
+ */
+__attribute__((always_inline, hot, artificial))
+inline const void* memrchr(const void* ptr, int c, std::size_t n) noexcept {
+    return detail::best_memrchr(ptr, c, n);
+}
+
+/**
+ * @brief Returns a pointer to the first of the n bytes at ptr that is in set, or nullptr.
+ *
+ * Each vector is classified against the set with three shuffles, so the cost does not
+ * depend on how many bytes the set holds.
+ */
+__attribute__((always_inline, hot, artificial))
+inline const void* find_any_of(const void* ptr, std::size_t n, const byte_set& set) noexcept {
+    return detail::best_find_any_of(ptr, n, set.tables());
+}
+
+} // namespace omm
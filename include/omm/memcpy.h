@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstring>
+#include <type_traits>
 
 // Include specialized implementations of memcpy for different CPU architectures
 #include "omm/detail/cpu_features.h"
@@ -12,6 +13,12 @@
 #ifdef __AVX2__
 #include "omm/detail/memcpy/memcpy_avx2.h"
 #endif
+#include "omm/detail/memcpy/memcpy_fixed.h"
+
+// Compile-time sizes at or above this threshold are routed to the streaming kernels
+#ifndef OMM_FIXED_STREAMING_THRESHOLD
+#define OMM_FIXED_STREAMING_THRESHOLD (32 * 1024 * 1024)  // 32MB
+#endif
 
 namespace omm {
 
@@ -36,6 +43,20 @@ MemcpyFunc initialize_best_memcpy() {
 // This is initialized once when the program starts
 static const MemcpyFunc best_memcpy = initialize_best_memcpy();
 
+// Selects the optimal streaming memcpy body, which has no small-size fast path and
+// leaves the trailing sfence to the caller
+inline MemcpyFunc initialize_best_memcpy_stream() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return memcpy_avx512_stream;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return memcpy_avx2_stream;
+    #endif
+    return std::memcpy;
+}
+
+static const MemcpyFunc best_memcpy_stream = initialize_best_memcpy_stream();
+
 } // namespace detail
 
 // Inline memcpy function with a fast path for small sizes
@@ -48,4 +69,26 @@ inline void* memcpy(void* __restrict dest, const void* __restrict src, std::size
     return detail::best_memcpy(dest, src, n);
 }
 
-} // namespace omm
\ No newline at end of file
+// Copy of a compile-time size: straight-line vector moves with no size dispatch,
+// or the streaming kernels once N reaches OMM_FIXED_STREAMING_THRESHOLD
+template <std::size_t N>
+__attribute__((always_inline, hot, artificial, returns_nonnull, nonnull(1, 2)))
+inline void* memcpy(void* __restrict dest, const void* __restrict src) noexcept {
+    if constexpr (N >= OMM_FIXED_STREAMING_THRESHOLD) {
+        return detail::best_memcpy(dest, src, N);
+    } else {
+        memcpy_fixed<N>(dest, src);
+        return dest;
+    }
+}
+
+// Copies one trivially copyable object using the fixed-size kernel for sizeof(T)
+template <typename T>
+__attribute__((always_inline, hot, artificial, returns_nonnull, nonnull(1, 2)))
+inline T* copy_fixed(T* __restrict dest, const T* __restrict src) noexcept {
+    static_assert(std::is_trivially_copyable_v<T>, "copy_fixed requires a trivially copyable type");
+    omm::memcpy<sizeof(T)>(dest, src);
+    return dest;
+}
+
+} // namespace omm
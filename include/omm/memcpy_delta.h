@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/memcpy_delta_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/memcpy_delta_avx2.h"
+#endif
+
+namespace omm {
+
+// Granularity of change detection in memcpy_delta
+inline constexpr std::size_t DELTA_LINE_SIZE = 64;
+
+/**
+ * @brief A contiguous run of changed bytes reported by dirty_ranges.
+ */
+struct delta_range {
+    std::size_t offset;
+    std::size_t length;
+};
+
+/**
+ * @brief Number of 64-bit words needed for the dirty bitmap of an n-byte copy.
+ */
+constexpr std::size_t dirty_bitmap_words(std::size_t n) noexcept {
+    const std::size_t lines = (n + DELTA_LINE_SIZE - 1) / DELTA_LINE_SIZE;
+    return (lines + 63) / 64;
+}
+
+namespace detail {
+
+// Function pointer type for delta copy implementations
+using MemcpyDeltaFunc = std::size_t (*)(void*, const void*, std::size_t, std::uint64_t*);
+
+// Portable line-by-line compare and copy
+inline std::size_t memcpy_delta_generic(void* __restrict dest, const void* __restrict src, std::size_t size,
+                                        std::uint64_t* __restrict dirty_bitmap) noexcept {
+    auto* dest_ptr = static_cast<uint8_t*>(dest);
+    const auto* src_ptr = static_cast<const uint8_t*>(src);
+    std::size_t changed = 0;
+
+    for (std::size_t offset = 0, line = 0; offset < size; offset += DELTA_LINE_SIZE, ++line) {
+        const std::size_t length = size - offset < DELTA_LINE_SIZE ? size - offset : DELTA_LINE_SIZE;
+        if (dirty_bitmap && line % 64 == 0) dirty_bitmap[line / 64] = 0;
+        if (std::memcmp(dest_ptr + offset, src_ptr + offset, length) != 0) {
+            std::memcpy(dest_ptr + offset, src_ptr + offset, length);
+            if (dirty_bitmap) dirty_bitmap[line / 64] |= std::uint64_t{1} << (line % 64);
+            ++changed;
+        }
+    }
+    return changed;
+}
+
+// Selects the optimal delta copy implementation based on available CPU features
+inline MemcpyDeltaFunc initialize_best_memcpy_delta() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return memcpy_delta_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return memcpy_delta_avx2;
+    #endif
+    return memcpy_delta_generic;
+}
+
+static const MemcpyDeltaFunc best_memcpy_delta = initialize_best_memcpy_delta();
+
+} // namespace detail
+
+/**
+ * @brief Copies src to dest, writing only the 64-byte lines that differ.
+ *
+ * Intended for shadow copies where most of the buffer is unchanged between calls:
+ * unchanged lines are read but never written. Lines are counted from dest, and the
+ * last line may be partial.
+ *
+ * @param dirty_bitmap Receives one bit per line, set if the line changed. Must hold
+ *                     dirty_bitmap_words(n) words, or be nullptr.
+ * @return Number of lines that changed.
+ */
+__attribute__((always_inline, hot, nonnull(1, 2)))
+inline std::size_t memcpy_delta(void* __restrict dest, const void* __restrict src, std::size_t n,
+                                std::uint64_t* __restrict dirty_bitmap = nullptr) noexcept {
+    return detail::best_memcpy_delta(dest, src, n, dirty_bitmap);
+}
+
+/**
+ * @brief Converts a dirty bitmap from memcpy_delta into coalesced byte ranges.
+ * @param n Size of the copy that produced the bitmap.
+ */
+inline std::vector<delta_range> dirty_ranges(const std::uint64_t* dirty_bitmap, std::size_t n) {
+    std::vector<delta_range> ranges;
+    const std::size_t words = dirty_bitmap_words(n);
+
+    for (std::size_t word = 0; word < words; ++word) {
+        std::uint64_t bits = dirty_bitmap[word];
+        while (bits != 0) {
+            const std::size_t bit = static_cast<std::size_t>(__builtin_ctzll(bits));
+            const std::size_t offset = (word * 64 + bit) * DELTA_LINE_SIZE;
+            bits &= bits - 1;
+
+            if (!ranges.empty() && ranges.back().offset + ranges.back().length == offset) {
+                ranges.back().length += DELTA_LINE_SIZE;
+            } else {
+                ranges.push_back({offset, DELTA_LINE_SIZE});
+            }
+        }
+    }
+
+    // The last line may extend past the end of the copy
+    if (!ranges.empty() && ranges.back().offset + ranges.back().length > n) {
+        ranges.back().length = n - ranges.back().offset;
+    }
+    return ranges;
+}
+
+} // namespace omm
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <span>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/memcpy_fanout_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/memcpy_fanout_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Function pointer type for fan-out copy implementations
+using MemcpyFanoutFunc = void (*)(void* const*, std::size_t, const void*, std::size_t);
+
+// Portable fallback: one copy per destination
+inline void memcpy_fanout_generic(void* const* dests, std::size_t count, const void* src, std::size_t size) noexcept {
+    for (std::size_t d = 0; d < count; ++d) {
+        std::memcpy(dests[d], src, size);
+    }
+}
+
+// Selects the optimal fan-out implementation based on available CPU features
+inline MemcpyFanoutFunc initialize_best_memcpy_fanout() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return memcpy_fanout_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return memcpy_fanout_avx2;
+    #endif
+    return memcpy_fanout_generic;
+}
+
+static const MemcpyFanoutFunc best_memcpy_fanout = initialize_best_memcpy_fanout();
+
+} // namespace detail
+
+/**
+ * @brief Copies n bytes from src into every buffer in dests, reading src only once.
+ *
+ * Destinations must not overlap src or each other. For large copies, allocate the
+ * destinations with a common alignment so all of them get streaming stores.
+ */
+__attribute__((always_inline, hot, nonnull(1)))
+inline void memcpy_fanout(const void* __restrict src, std::size_t n, std::span<void* const> dests) noexcept {
+    detail::best_memcpy_fanout(dests.data(), dests.size(), src, n);
+}
+
+} // namespace omm
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/memcpy_persist_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/memcpy_persist_avx2.h"
+#endif
+
+// Copies shorter than this are written with regular stores and flushed line by line
+#ifndef OMM_PERSIST_STREAM_THRESHOLD
+#define OMM_PERSIST_STREAM_THRESHOLD 256
+#endif
+
+namespace omm {
+
+/**
+ * @brief How memcpy_persist makes written data durable.
+ *
+ * The flush methods execute the named instruction, so pass them explicitly only when
+ * the CPU supports it; default_persist_method() picks the best supported one.
+ */
+enum class persist_method {
+    clwb,        // Write back dirty lines and keep them cached
+    clflushopt,  // Write back and evict dirty lines, weakly ordered
+    msync,       // Synchronous msync of the covering pages, for page-cache backed mappings
+};
+
+namespace detail {
+
+static constexpr std::size_t PERSIST_LINE_SIZE = 64;
+
+// Function pointer types for line flushes and persistent copy kernels
+using FlushLinesFunc = void (*)(const void*, std::size_t);
+using MemcpyPersistFunc = void (*)(void*, const void*, std::size_t, FlushLinesFunc);
+
+// Writes back every cache line overlapping [addr, addr + n)
+__attribute__((target("clwb")))
+inline void flush_lines_clwb(const void* addr, std::size_t n) noexcept {
+    auto line = reinterpret_cast<std::uintptr_t>(addr) & ~(PERSIST_LINE_SIZE - 1);
+    const auto end = reinterpret_cast<std::uintptr_t>(addr) + n;
+    for (; line < end; line += PERSIST_LINE_SIZE) {
+        _mm_clwb(reinterpret_cast<void*>(line));
+    }
+}
+
+// Writes back and evicts every cache line overlapping [addr, addr + n)
+__attribute__((target("clflushopt")))
+inline void flush_lines_clflushopt(const void* addr, std::size_t n) noexcept {
+    auto line = reinterpret_cast<std::uintptr_t>(addr) & ~(PERSIST_LINE_SIZE - 1);
+    const auto end = reinterpret_cast<std::uintptr_t>(addr) + n;
+    for (; line < end; line += PERSIST_LINE_SIZE) {
+        _mm_clflushopt(reinterpret_cast<void*>(line));
+    }
+}
+
+// Portable kernel: regular copy, then every line is flushed
+inline void memcpy_persist_generic(void* __restrict dest, const void* __restrict src, std::size_t size,
+                                   FlushLinesFunc flush_lines) noexcept {
+    std::memcpy(dest, src, size);
+    flush_lines(dest, size);
+}
+
+// Synchronously writes back the pages covering [addr, addr + n) to their backing file
+inline bool msync_range(const void* addr, std::size_t n) noexcept {
+    #ifdef __linux__
+    static const auto page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    const auto start = reinterpret_cast<std::uintptr_t>(addr) & ~(page_size - 1);
+    const auto end = reinterpret_cast<std::uintptr_t>(addr) + n;
+    return msync(reinterpret_cast<void*>(start), end - start, MS_SYNC) == 0;
+    #else
+    (void)addr;
+    (void)n;
+    return false;
+    #endif
+}
+
+// Selects the strongest flush instruction the CPU supports, or msync without one
+inline persist_method initialize_best_persist_method() {
+    if (cpu_supports_clwb()) return persist_method::clwb;
+    if (cpu_supports_clflushopt()) return persist_method::clflushopt;
+    return persist_method::msync;
+}
+
+// Selects the optimal persistent copy kernel based on available CPU features
+inline MemcpyPersistFunc initialize_best_memcpy_persist() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return memcpy_persist_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return memcpy_persist_avx2;
+    #endif
+    return memcpy_persist_generic;
+}
+
+static const persist_method best_persist_method = initialize_best_persist_method();
+static const MemcpyPersistFunc best_memcpy_persist = initialize_best_memcpy_persist();
+
+} // namespace detail
+
+// Method used by memcpy_persist and persist when none is given
+inline persist_method default_persist_method() noexcept {
+    return detail::best_persist_method;
+}
+
+/**
+ * @brief Makes n bytes already written at addr durable.
+ *
+ * With a flush method each overlapping line is flushed and a single sfence waits for
+ * all of them. This only reaches the persistence domain on DAX or persistent-memory
+ * mappings; page-cache backed file mappings need persist_method::msync.
+ *
+ * @return false if msync failed, with errno set.
+ */
+inline bool persist(const void* addr, std::size_t n, persist_method method = default_persist_method()) noexcept {
+    if (n == 0) return true;
+    switch (method) {
+        case persist_method::clwb:
+            detail::flush_lines_clwb(addr, n);
+            break;
+        case persist_method::clflushopt:
+            detail::flush_lines_clflushopt(addr, n);
+            break;
+        case persist_method::msync:
+            return detail::msync_range(addr, n);
+    }
+    _mm_sfence();
+    return true;
+}
+
+/**
+ * @brief Copies n bytes from src to dest and makes them durable before returning.
+ *
+ * With a flush method, copies of at least OMM_PERSIST_STREAM_THRESHOLD bytes stream
+ * every whole destination line and flush only the partial lines at either end; shorter
+ * copies use regular stores and flush each line. One sfence covers the whole copy. The
+ * msync method copies normally and then syncs the covering pages.
+ *
+ * @return false if msync failed, with errno set.
+ */
+__attribute__((nonnull(1, 2)))
+inline bool memcpy_persist(void* __restrict dest, const void* __restrict src, std::size_t n,
+                           persist_method method = default_persist_method()) noexcept {
+    if (n == 0) return true;
+    if (method == persist_method::msync) {
+        std::memcpy(dest, src, n);
+        return detail::msync_range(dest, n);
+    }
+
+    const detail::FlushLinesFunc flush_lines = method == persist_method::clwb ? detail::flush_lines_clwb
+                                                                              : detail::flush_lines_clflushopt;
+    if (n < OMM_PERSIST_STREAM_THRESHOLD) {
+        __builtin_memcpy(dest, src, n);
+        flush_lines(dest, n);
+    } else {
+        detail::best_memcpy_persist(dest, src, n, flush_lines);
+    }
+
+    // Orders the streaming stores and the flushes before the copy is acknowledged
+    _mm_sfence();
+    return true;
+}
+
+} // namespace omm
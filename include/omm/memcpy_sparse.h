@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+#include "omm/is_zero.h"
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/memcpy/memcpy_sparse_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/memcpy/memcpy_sparse_avx2.h"
+#endif
+
+namespace omm {
+
+/**
+ * @brief How memcpy_sparse treats destination pages whose source is all zero.
+ */
+enum class zero_page_policy {
+    skip,        // Leave the page untouched; the destination must already read as zero (e.g. fresh anonymous mmap)
+    discard,     // Release the page with madvise(MADV_DONTNEED); private anonymous mappings only
+    punch_hole,  // Deallocate the page from the backing file with fallocate(FALLOC_FL_PUNCH_HOLE)
+};
+
+/**
+ * @brief Options for memcpy_sparse.
+ */
+struct sparse_copy_options {
+    zero_page_policy policy = zero_page_policy::skip;
+    int fd = -1;            // File backing dest, required for punch_hole
+    off_t file_offset = 0;  // File offset that dest is mapped at
+};
+
+/**
+ * @brief Statistics returned by memcpy_sparse. Partial pages at either end count as pages.
+ */
+struct sparse_copy_stats {
+    std::size_t pages = 0;         // Destination pages covered by the copy
+    std::size_t zero_pages = 0;    // Pages whose source bytes were all zero
+    std::size_t bytes_copied = 0;  // Bytes copied from non-zero pages
+};
+
+namespace detail {
+
+// Function pointer type for sparse page kernels
+using SparsePageFunc = bool (*)(void*, const void*, std::size_t, bool);
+
+// Portable page kernel: zero test followed by a regular copy
+inline bool memcpy_sparse_page_generic(void* __restrict dest, const void* __restrict src,
+                                       std::size_t page_size, bool /*zero_prefix*/) noexcept {
+    if (is_zero_generic(src, page_size)) return true;
+    __builtin_memcpy(dest, src, page_size);
+    return false;
+}
+
+// Selects the optimal sparse page kernel based on available CPU features
+inline SparsePageFunc initialize_best_sparse_page() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return memcpy_sparse_page_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return memcpy_sparse_page_avx2;
+    #endif
+    return memcpy_sparse_page_generic;
+}
+
+static const SparsePageFunc best_sparse_page = initialize_best_sparse_page();
+
+inline std::size_t system_page_size() noexcept {
+    #ifdef __linux__
+    static const auto page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    return page_size;
+    #else
+    return 4096;
+    #endif
+}
+
+// Releases a run of zero destination pages according to the policy.
+// Falls back to an explicit zero fill if the kernel refuses the request.
+inline void release_zero_pages(uint8_t* dest, std::size_t offset, std::size_t length,
+                               const sparse_copy_options& options) noexcept {
+    int result = -1;
+    #ifdef __linux__
+    if (options.policy == zero_page_policy::discard) {
+        result = madvise(dest + offset, length, MADV_DONTNEED);
+    } else if (options.policy == zero_page_policy::punch_hole && options.fd >= 0) {
+        result = fallocate(options.fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                           options.file_offset + static_cast<off_t>(offset), static_cast<off_t>(length));
+    }
+    #endif
+    if (result != 0) {
+        std::memset(dest + offset, 0, length);
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Copies n bytes from src to dest, skipping source pages that are entirely zero.
+ *
+ * Pages are delimited by destination page boundaries. Whole zero pages are handled
+ * according to options.policy, with consecutive zero pages released in a single
+ * madvise/fallocate call. Partial pages at either end can't be released, so under
+ * discard and punch_hole they are zero filled explicitly.
+ *
+ * @return Page and byte counts for the copy.
+ */
+__attribute__((nonnull(1, 2)))
+inline sparse_copy_stats memcpy_sparse(void* __restrict dest, const void* __restrict src, std::size_t n,
+                                       const sparse_copy_options& options = {}) noexcept {
+    sparse_copy_stats stats;
+    const std::size_t page_size = detail::system_page_size();
+    const bool zero_fill = options.policy != zero_page_policy::skip;
+
+    auto* dest_ptr = static_cast<uint8_t*>(dest);
+    const auto* src_ptr = static_cast<const uint8_t*>(src);
+
+    // Copies a partial page, which can only be skipped or written
+    auto copy_partial = [&](std::size_t offset, std::size_t length) {
+        ++stats.pages;
+        if (!is_zero(src_ptr + offset, length)) {
+            __builtin_memcpy(dest_ptr + offset, src_ptr + offset, length);
+            stats.bytes_copied += length;
+            return;
+        }
+        ++stats.zero_pages;
+        if (zero_fill) std::memset(dest_ptr + offset, 0, length);
+    };
+
+    std::size_t head = (page_size - (reinterpret_cast<std::uintptr_t>(dest_ptr) & (page_size - 1))) & (page_size - 1);
+    if (head > n) head = n;
+    if (head > 0) copy_partial(0, head);
+
+    // Whole pages go through the vector kernel, with zero runs released in bulk
+    std::size_t offset = head;
+    std::size_t run_start = 0;
+    std::size_t run_length = 0;
+    for (; offset + page_size <= n; offset += page_size) {
+        ++stats.pages;
+        if (detail::best_sparse_page(dest_ptr + offset, src_ptr + offset, page_size, zero_fill)) {
+            if (run_length == 0) run_start = offset;
+            run_length += page_size;
+            ++stats.zero_pages;
+            continue;
+        }
+        stats.bytes_copied += page_size;
+        if (run_length > 0 && zero_fill) detail::release_zero_pages(dest_ptr, run_start, run_length, options);
+        run_length = 0;
+    }
+    if (run_length > 0 && zero_fill) detail::release_zero_pages(dest_ptr, run_start, run_length, options);
+
+    if (offset < n) copy_partial(offset, n - offset);
+
+    // Ensure all non-temporal (streaming) stores are visible
+    _mm_sfence();
+
+    return stats;
+}
+
+} // namespace omm
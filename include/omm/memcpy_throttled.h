@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <immintrin.h>
+
+#include "omm/memcpy.h"
+#include "omm/detail/tsc.h"
+
+namespace omm {
+
+/**
+ * @brief Token-bucket pacing policy for background copies.
+ *
+ * Copies are split into chunks that are streamed with the OMM kernels. Before each
+ * chunk the bucket is refilled from the elapsed TSC time at the configured rate, and
+ * the caller waits until it holds enough bytes for the chunk. Long waits sleep, the
+ * last stretch spins, so the pacing stays accurate without burning a core.
+ *
+ * In adaptive mode the rate is scaled by how the raw chunk throughput compares with the
+ * best seen so far. When foreground threads contend for memory bandwidth each chunk
+ * copies more slowly, and the background copy backs off in proportion.
+ *
+ * A throttle is not thread-safe; use one per background thread.
+ */
+class copy_throttle {
+public:
+    static constexpr std::size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+
+    /**
+     * @param bytes_per_second Target rate; zero or negative disables throttling.
+     * @param chunk_size Bytes copied per paced step, which is also the bucket capacity.
+     * @param adaptive Scale the rate down when observed copy throughput drops.
+     */
+    explicit copy_throttle(double bytes_per_second, std::size_t chunk_size = DEFAULT_CHUNK_SIZE,
+                           bool adaptive = false) noexcept
+            : chunk_size_(chunk_size > 0 ? chunk_size : DEFAULT_CHUNK_SIZE),
+              adaptive_(adaptive),
+              tokens_(static_cast<double>(chunk_size_)),
+              last_tsc_(detail::read_tsc()) {
+        set_rate(bytes_per_second);
+    }
+
+    void set_rate(double bytes_per_second) noexcept {
+        rate_ = bytes_per_second;
+        effective_rate_ = bytes_per_second;
+    }
+
+    // Configured target rate in bytes per second
+    double rate() const noexcept { return rate_; }
+
+    // Rate currently enforced, after adaptation
+    double effective_rate() const noexcept { return effective_rate_; }
+
+    // Smoothed raw throughput of the chunk copies in bytes per second
+    double observed_throughput() const noexcept { return observed_bps_; }
+
+    /**
+     * @brief Copies n bytes from src to dest at no more than the effective rate.
+     */
+    void copy(void* __restrict dest, const void* __restrict src, std::size_t n) noexcept {
+        auto* dest_ptr = static_cast<uint8_t*>(dest);
+        const auto* src_ptr = static_cast<const uint8_t*>(src);
+
+        for (std::size_t offset = 0; offset < n; offset += chunk_size_) {
+            const std::size_t chunk = std::min(chunk_size_, n - offset);
+            acquire(chunk);
+
+            const std::uint64_t start = detail::read_tsc();
+            detail::best_memcpy_stream(dest_ptr + offset, src_ptr + offset, chunk);
+            observe(chunk, detail::read_tsc() - start);
+        }
+
+        // Ensure all non-temporal (streaming) stores are visible
+        _mm_sfence();
+    }
+
+private:
+    // Lower bound on the adaptive rate, as a fraction of the target, so the copy always progresses
+    static constexpr double MIN_ADAPTIVE_FRACTION = 0.1;
+    // Waits longer than this sleep first and spin only for the remainder
+    static constexpr std::uint64_t SPIN_THRESHOLD_NS = 100'000;
+
+    // Waits until the bucket holds bytes tokens, then takes them
+    void acquire(std::size_t bytes) noexcept {
+        if (effective_rate_ <= 0) return;
+        const double bytes_per_tick = effective_rate_ / (detail::tsc_ticks_per_ns() * 1e9);
+
+        refill(bytes_per_tick);
+        if (tokens_ < static_cast<double>(bytes)) {
+            const double missing = static_cast<double>(bytes) - tokens_;
+            const std::uint64_t deadline = last_tsc_ + static_cast<std::uint64_t>(missing / bytes_per_tick);
+            const std::uint64_t wait_ns = detail::tsc_to_ns(deadline - last_tsc_);
+            if (wait_ns > SPIN_THRESHOLD_NS) {
+                std::this_thread::sleep_for(std::chrono::nanoseconds(wait_ns - SPIN_THRESHOLD_NS / 2));
+            }
+            while (detail::read_tsc() < deadline) {
+                _mm_pause();
+            }
+            refill(bytes_per_tick);
+        }
+        tokens_ -= static_cast<double>(bytes);
+    }
+
+    void refill(double bytes_per_tick) noexcept {
+        const std::uint64_t now = detail::read_tsc();
+        tokens_ = std::min(static_cast<double>(chunk_size_),
+                           tokens_ + static_cast<double>(now - last_tsc_) * bytes_per_tick);
+        last_tsc_ = now;
+    }
+
+    // Tracks raw chunk throughput and, in adaptive mode, rescales the effective rate
+    void observe(std::size_t bytes, std::uint64_t ticks) noexcept {
+        if (ticks == 0) return;
+        const double bps = static_cast<double>(bytes) / (static_cast<double>(ticks) / detail::tsc_ticks_per_ns()) * 1e9;
+        observed_bps_ = observed_bps_ == 0 ? bps : 0.875 * observed_bps_ + 0.125 * bps;
+        peak_bps_ = std::max(peak_bps_, observed_bps_);
+
+        if (adaptive_ && rate_ > 0) {
+            const double fraction = std::clamp(observed_bps_ / peak_bps_, MIN_ADAPTIVE_FRACTION, 1.0);
+            effective_rate_ = rate_ * fraction;
+        }
+    }
+
+    double rate_ = 0;
+    double effective_rate_ = 0;
+    std::size_t chunk_size_;
+    bool adaptive_;
+    double tokens_;
+    std::uint64_t last_tsc_;
+    double observed_bps_ = 0;
+    double peak_bps_ = 0;
+};
+
+/**
+ * @brief Copies n bytes at no more than bytes_per_second, using streaming stores.
+ *
+ * Convenience wrapper for a one-off copy. Callers issuing many background copies should
+ * keep a copy_throttle so the bucket state carries over between them.
+ */
+__attribute__((nonnull(1, 2)))
+inline void memcpy_throttled(void* __restrict dest, const void* __restrict src, std::size_t n,
+                             double bytes_per_second) noexcept {
+    copy_throttle throttle(bytes_per_second);
+    throttle.copy(dest, src, n);
+}
+
+} // namespace omm
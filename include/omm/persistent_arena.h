@@ -0,0 +1,391 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "omm/memcpy_persist.h"
+#include "omm/detail/memory/huge_pages.h"
+
+namespace omm {
+
+/**
+ * @brief Self-relative pointer that stays valid when the memory holding it is mapped
+ *        at a different address.
+ *
+ * Stores the distance from its own address to the target, so objects linked with
+ * offset_ptr inside a persistent_arena can be followed after the arena is reattached
+ * anywhere. Both the pointer and its target must live in the same mapping.
+ */
+template <typename T>
+class offset_ptr {
+public:
+    offset_ptr() noexcept = default;
+    offset_ptr(std::nullptr_t) noexcept {}
+    offset_ptr(T* ptr) noexcept { set(ptr); }
+    offset_ptr(const offset_ptr& other) noexcept { set(other.get()); }
+
+    offset_ptr& operator=(const offset_ptr& other) noexcept {
+        set(other.get());
+        return *this;
+    }
+    offset_ptr& operator=(T* ptr) noexcept {
+        set(ptr);
+        return *this;
+    }
+
+    T* get() const noexcept {
+        if (offset_ == NULL_OFFSET) return nullptr;
+        return reinterpret_cast<T*>(reinterpret_cast<std::intptr_t>(this) + offset_);
+    }
+
+    T& operator*() const noexcept { return *get(); }
+    T* operator->() const noexcept { return get(); }
+    explicit operator bool() const noexcept { return offset_ != NULL_OFFSET; }
+
+private:
+    // An offset of 1 would point inside the offset_ptr itself, so it marks null
+    static constexpr std::intptr_t NULL_OFFSET = 1;
+
+    void set(T* ptr) noexcept {
+        offset_ = ptr ? reinterpret_cast<std::intptr_t>(ptr) - reinterpret_cast<std::intptr_t>(this) : NULL_OFFSET;
+    }
+
+    std::intptr_t offset_ = NULL_OFFSET;
+};
+
+/**
+ * @brief Options for persistent_arena.
+ */
+struct persistent_arena_options {
+    void* base_hint = nullptr;   // Preferred address for a new arena; existing arenas reuse their recorded base
+    bool huge_pages = false;     // Round the capacity to huge pages, map at an aligned address unless placed at the base, and advise THP (tmpfs mounted with huge=)
+    bool prefault = true;        // Populate the page tables while mapping rather than on first touch
+    persist_method method = persist_method::msync;  // How commit() makes data durable; flush methods suit DAX files
+};
+
+namespace detail {
+
+inline constexpr std::uint64_t ARENA_MAGIC = 0x414E4552414D4D4FULL;  // "OMMARENA"
+inline constexpr std::uint32_t ARENA_VERSION = 1;
+
+// One of two alternating commit records; the valid one with the higher generation wins
+struct arena_commit {
+    std::uint64_t generation;
+    std::uint64_t used;      // Bytes allocated, counted from the start of the mapping
+    std::uint64_t root;      // Offset of the root object, or 0
+    std::uint64_t checksum;  // Detects a record torn by a crash during commit
+};
+
+struct arena_header {
+    std::uint64_t magic;
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t base;      // Address the arena was last mapped at, used as the next hint
+    arena_commit commits[2];
+};
+
+inline std::uint64_t arena_checksum(const arena_commit& commit) noexcept {
+    // Order-dependent mix, so torn or swapped fields change the sum
+    std::uint64_t hash = ARENA_MAGIC;
+    for (std::uint64_t value : {commit.generation, commit.used, commit.root}) {
+        hash = (hash ^ value) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 29;
+    }
+    return hash;
+}
+
+} // namespace detail
+
+/**
+ * @brief File-backed bump arena that can be reattached after a restart without reloading.
+ *
+ * The file (on disk, or under /dev/shm for restarts that keep the machine up) is mapped
+ * shared, at the address recorded by the previous run when it is free. Objects are
+ * linked with offset_ptr or arena offsets, so a mapping at a different address is still
+ * valid, just reported by relocated().
+ *
+ * Allocations become durable at commit(): the data is synced first, then the inactive
+ * one of two checksummed commit records in the header. After a crash the arena reopens
+ * at the last complete commit, and later allocations are discarded. With the msync
+ * method, commit() syncs every dirty page; with a flush method, only bytes allocated
+ * since the last commit are flushed, and changes to older objects must be persisted
+ * by the caller.
+ *
+ * Open failures throw std::system_error; allocations beyond the capacity throw
+ * std::bad_alloc.
+ */
+class persistent_arena {
+public:
+    // The header occupies the first page; allocations start after it
+    static constexpr std::size_t HEADER_SIZE = 4096;
+
+    /**
+     * @param path File backing the arena; created if it does not exist.
+     * @param capacity Size of the arena in bytes, including the header. An existing file
+     *                 is grown to this size but never shrunk.
+     */
+    persistent_arena(const std::string& path, std::size_t capacity, persistent_arena_options options = {})
+            : options_(options) {
+        #ifdef __linux__
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (fd_ < 0) throw std::system_error(errno, std::generic_category(), "persistent_arena: open " + path);
+
+        struct stat st {};
+        if (fstat(fd_, &st) != 0) fail("fstat");
+        const auto file_size = static_cast<std::size_t>(st.st_size);
+
+        capacity_ = capacity > file_size ? capacity : file_size;
+        if (capacity_ < HEADER_SIZE) capacity_ = HEADER_SIZE;
+        if (options_.huge_pages) capacity_ = detail::round_to_huge_pages(capacity_);
+        if (capacity_ > file_size && ftruncate(fd_, static_cast<off_t>(capacity_)) != 0) fail("ftruncate");
+
+        // Read the header through the descriptor to learn the preferred base before mapping
+        detail::arena_header header {};
+        const bool has_header = file_size >= HEADER_SIZE &&
+                                pread(fd_, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+                                header.magic == detail::ARENA_MAGIC && header.version == detail::ARENA_VERSION;
+        void* hint = has_header ? reinterpret_cast<void*>(header.base) : options_.base_hint;
+
+        map(hint);
+        if (!has_header || !load_commit()) {
+            try {
+                initialize();
+            } catch (...) {
+                release();
+                throw;
+            }
+        }
+        relocated_ = has_header && header.base != reinterpret_cast<std::uintptr_t>(base_);
+        this->header().base = reinterpret_cast<std::uintptr_t>(base_);
+        #else
+        (void)path; (void)capacity;
+        throw std::system_error(ENOSYS, std::generic_category(), "persistent_arena: unsupported platform");
+        #endif
+    }
+
+    persistent_arena(const persistent_arena&) = delete;
+    persistent_arena& operator=(const persistent_arena&) = delete;
+
+    persistent_arena(persistent_arena&& other) noexcept { swap(other); }
+    persistent_arena& operator=(persistent_arena&& other) noexcept {
+        if (this != &other) {
+            release();
+            swap(other);
+        }
+        return *this;
+    }
+
+    // Unmaps the arena without committing
+    ~persistent_arena() { release(); }
+
+    /**
+     * @brief Allocates bytes from the arena.
+     * @throws std::bad_alloc if the arena is full.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        const std::size_t start = (used_ + alignment - 1) & ~(alignment - 1);
+        if (start > capacity_ || bytes > capacity_ - start) throw std::bad_alloc();
+        used_ = start + bytes;
+        return base_ + start;
+    }
+
+    // Allocates and constructs a T in the arena
+    template <typename T, typename... Args>
+    T* construct(Args&&... args) {
+        return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // Records the object that is returned by root() after reattaching; durable at commit()
+    template <typename T>
+    void set_root(T* object) noexcept { root_ = object ? offset_of(object) : 0; }
+
+    template <typename T>
+    T* root() const noexcept { return root_ ? static_cast<T*>(at(root_)) : nullptr; }
+
+    /**
+     * @brief Makes all allocations and the root durable.
+     * @throws std::system_error if msync fails. The arena stays mapped and usable, and
+     *         commit() may be retried; until one succeeds, reopening may find the previous
+     *         commit.
+     */
+    void commit() {
+        if (options_.method == persist_method::msync) {
+            sync(base_ + HEADER_SIZE, used_ - HEADER_SIZE);
+        } else if (used_ > committed_used_) {
+            persist(base_ + committed_used_, used_ - committed_used_, options_.method);
+        }
+
+        const std::uint64_t generation = generation_ + 1;
+        detail::arena_commit& record = header().commits[generation & 1];
+        record.generation = generation;
+        record.used = used_;
+        record.root = root_;
+        record.checksum = detail::arena_checksum(record);
+        sync(&header(), sizeof(detail::arena_header));
+
+        generation_ = generation;
+        committed_used_ = used_;
+    }
+
+    // Converts between pointers into the arena and offsets from its base
+    std::uint64_t offset_of(const void* ptr) const noexcept {
+        return static_cast<std::uint64_t>(static_cast<const uint8_t*>(ptr) - base_);
+    }
+    void* at(std::uint64_t offset) const noexcept { return base_ + offset; }
+
+    // True if an existing arena was reattached rather than initialized
+    bool attached() const noexcept { return attached_; }
+    // True if the arena could not be mapped at its previous address
+    bool relocated() const noexcept { return relocated_; }
+
+    void* base() const noexcept { return base_; }
+    std::size_t capacity() const noexcept { return capacity_; }
+    std::size_t used() const noexcept { return used_; }
+    std::uint64_t generation() const noexcept { return generation_; }
+
+private:
+    detail::arena_header& header() const noexcept { return *reinterpret_cast<detail::arena_header*>(base_); }
+
+    // Releases the arena and throws; only for the constructor, before the arena is usable
+    [[noreturn]] void fail(const char* what) {
+        const int error = errno;
+        release();
+        throw std::system_error(error, std::generic_category(), std::string("persistent_arena: ") + what);
+    }
+
+    void map(void* hint) {
+        #ifdef __linux__
+        int flags = MAP_SHARED;
+        if (options_.prefault) flags |= MAP_POPULATE;
+
+        // A plain hint is honoured when the range is free and ignored otherwise
+        void* mapping = hint || !options_.huge_pages ? mmap(hint, capacity_, PROT_READ | PROT_WRITE, flags, fd_, 0) : MAP_FAILED;
+        // THP backs only aligned huge pages, so a huge page arena not placed at its hint is
+        // mapped at an aligned address instead
+        if (options_.huge_pages && mapping != hint) {
+            if (mapping != MAP_FAILED) munmap(mapping, capacity_);
+            mapping = map_huge_aligned(flags);
+        }
+        if (mapping == MAP_FAILED) fail("mmap");
+        base_ = static_cast<uint8_t*>(mapping);
+        if (options_.huge_pages) madvise(mapping, capacity_, MADV_HUGEPAGE);
+        #else
+        (void)hint;
+        #endif
+    }
+
+    // Maps the file at a huge page boundary: reserves a huge page more address space than
+    // needed, maps the file over its aligned part and releases the unaligned head and tail
+    void* map_huge_aligned(int flags) noexcept {
+        #ifdef __linux__
+        const std::size_t padded = capacity_ + detail::HUGE_PAGE_SIZE;
+        void* raw = mmap(nullptr, padded, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (raw == MAP_FAILED) return MAP_FAILED;
+
+        const auto start = reinterpret_cast<std::uintptr_t>(raw);
+        const auto aligned = (start + detail::HUGE_PAGE_SIZE - 1) & ~(detail::HUGE_PAGE_SIZE - 1);
+        void* mapping = mmap(reinterpret_cast<void*>(aligned), capacity_, PROT_READ | PROT_WRITE, flags | MAP_FIXED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            munmap(raw, padded);
+            return MAP_FAILED;
+        }
+        if (aligned > start) munmap(raw, aligned - start);
+        const std::size_t tail = padded - (aligned - start) - capacity_;
+        if (tail > 0) munmap(reinterpret_cast<void*>(aligned + capacity_), tail);
+        return mapping;
+        #else
+        (void)flags;
+        return nullptr;
+        #endif
+    }
+
+    // Restores the newest commit record with a valid checksum
+    bool load_commit() noexcept {
+        const detail::arena_commit* best = nullptr;
+        for (const auto& record : header().commits) {
+            if (record.checksum != detail::arena_checksum(record) || record.used < HEADER_SIZE || record.used > capacity_) continue;
+            if (!best || record.generation > best->generation) best = &record;
+        }
+        if (!best) return false;
+
+        generation_ = best->generation;
+        used_ = committed_used_ = best->used;
+        root_ = best->root;
+        attached_ = true;
+        return true;
+    }
+
+    void initialize() {
+        detail::arena_header& h = header();
+        h = {};
+        h.magic = detail::ARENA_MAGIC;
+        h.version = detail::ARENA_VERSION;
+        generation_ = 0;
+        used_ = committed_used_ = HEADER_SIZE;
+        root_ = 0;
+        h.commits[0] = {0, HEADER_SIZE, 0, 0};
+        h.commits[0].checksum = detail::arena_checksum(h.commits[0]);
+        h.commits[1] = h.commits[0];
+        sync(&h, sizeof(h));
+    }
+
+    void sync(const void* addr, std::size_t bytes) {
+        if (bytes == 0) return;
+        if (options_.method == persist_method::msync) {
+            if (!persist(addr, bytes, persist_method::msync)) {
+                throw std::system_error(errno, std::generic_category(), "persistent_arena: msync");
+            }
+        } else {
+            persist(addr, bytes, options_.method);
+        }
+    }
+
+    void release() noexcept {
+        #ifdef __linux__
+        if (base_) munmap(base_, capacity_);
+        if (fd_ >= 0) ::close(fd_);
+        #endif
+        base_ = nullptr;
+        fd_ = -1;
+    }
+
+    void swap(persistent_arena& other) noexcept {
+        std::swap(fd_, other.fd_);
+        std::swap(base_, other.base_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(used_, other.used_);
+        std::swap(committed_used_, other.committed_used_);
+        std::swap(root_, other.root_);
+        std::swap(generation_, other.generation_);
+        std::swap(attached_, other.attached_);
+        std::swap(relocated_, other.relocated_);
+        std::swap(options_, other.options_);
+    }
+
+    int fd_ = -1;
+    uint8_t* base_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t used_ = 0;
+    std::size_t committed_used_ = 0;
+    std::uint64_t root_ = 0;
+    std::uint64_t generation_ = 0;
+    bool attached_ = false;
+    bool relocated_ = false;
+    persistent_arena_options options_;
+};
+
+} // namespace omm
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <thread>
+#include <immintrin.h>
+
+#include "omm/memcpy.h"
+#include "omm/detail/memory/huge_pages.h"
+
+namespace omm {
+
+namespace detail {
+
+// Reader counts are spread over this many cache lines to keep readers on different
+// cores from contending on one counter
+inline constexpr std::size_t RCU_READER_SHARDS = 64;
+
+// Shard used by the calling thread, assigned round-robin on first use
+inline std::size_t rcu_reader_shard() noexcept {
+    static std::atomic<std::size_t> next_shard{0};
+    thread_local const std::size_t shard = next_shard.fetch_add(1, std::memory_order_relaxed) % RCU_READER_SHARDS;
+    return shard;
+}
+
+} // namespace detail
+
+/**
+ * @brief Double-buffered publication of a large read-mostly structure.
+ *
+ * Readers pin the current version with read() and access it without locks. The writer
+ * builds the next version in the spare buffer, streaming any unchanged ranges across
+ * from the current version with copy_unchanged(), and publish() swaps the buffers with
+ * one atomic store.
+ *
+ * Versions alternate between the two buffers, so each buffer belongs to every other
+ * epoch. Readers count themselves in per-epoch-parity sharded counters, and the grace
+ * period for a buffer ends when its counters drain: begin_update() waits for that
+ * before handing the spare buffer out again. Read sections should be short; a reader
+ * holding a version stalls the second update after it.
+ *
+ * Buffers of at least a huge page are mapped on huge page boundaries. There is one
+ * writer at a time; concurrent updates must be serialized by the caller.
+ */
+class rcu_buffer {
+public:
+    /**
+     * @brief A pinned version; the data stays valid and unchanged until it is destroyed.
+     */
+    class read_guard {
+    public:
+        read_guard(read_guard&& other) noexcept
+                : data_(other.data_), size_(other.size_), version_(other.version_), count_(other.count_) {
+            other.count_ = nullptr;
+        }
+        read_guard(const read_guard&) = delete;
+        read_guard& operator=(const read_guard&) = delete;
+        read_guard& operator=(read_guard&&) = delete;
+
+        ~read_guard() {
+            if (count_) count_->fetch_sub(1, std::memory_order_release);
+        }
+
+        const void* data() const noexcept { return data_; }
+        std::size_t size() const noexcept { return size_; }
+        std::uint64_t version() const noexcept { return version_; }
+
+    private:
+        friend class rcu_buffer;
+
+        read_guard(const void* data, std::size_t size, std::uint64_t version, std::atomic<std::int64_t>* count) noexcept
+                : data_(data), size_(size), version_(version), count_(count) {}
+
+        const void* data_;
+        std::size_t size_;
+        std::uint64_t version_;
+        std::atomic<std::int64_t>* count_;
+    };
+
+    /**
+     * @param capacity Size of each of the two buffers in bytes.
+     * @throws std::bad_alloc if the buffers cannot be allocated.
+     */
+    explicit rcu_buffer(std::size_t capacity) : capacity_(capacity) {
+        allocate(0);
+        try {
+            allocate(1);
+        } catch (...) {
+            deallocate(0);
+            throw;
+        }
+    }
+
+    rcu_buffer(const rcu_buffer&) = delete;
+    rcu_buffer& operator=(const rcu_buffer&) = delete;
+
+    // Readers must have released their guards
+    ~rcu_buffer() {
+        deallocate(0);
+        deallocate(1);
+    }
+
+    /**
+     * @brief Pins the current version. Lock-free: retries only if a publish races with it.
+     */
+    read_guard read() const noexcept {
+        const std::size_t shard = detail::rcu_reader_shard();
+        for (;;) {
+            const std::uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+            auto& count = readers_[epoch & 1][shard].value;
+            count.fetch_add(1, std::memory_order_seq_cst);
+            // The writer reads the counters after advancing the epoch, so either it sees
+            // this reader or this reader sees the new epoch
+            if (epoch_.load(std::memory_order_seq_cst) == epoch) {
+                return read_guard(buffers_[epoch & 1], sizes_[epoch & 1], epoch, &count);
+            }
+            count.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    /**
+     * @brief Waits for the grace period of the spare buffer and returns it for writing.
+     *
+     * The buffer holds the version before the current one, or uninitialized memory.
+     */
+    void* begin_update() noexcept {
+        const std::size_t spare = (epoch_.load(std::memory_order_relaxed) + 1) & 1;
+        while (active_readers(spare) != 0) {
+            std::this_thread::yield();
+        }
+        return buffers_[spare];
+    }
+
+    /**
+     * @brief Copies n bytes at offset from the current version into the spare buffer.
+     *
+     * Uses streaming stores for large ranges, so unchanged data does not displace the
+     * writer's cache; publish() issues the fence.
+     */
+    void copy_unchanged(std::size_t offset, std::size_t n) noexcept {
+        const std::uint64_t epoch = epoch_.load(std::memory_order_relaxed);
+        const auto* current = static_cast<const uint8_t*>(buffers_[epoch & 1]);
+        auto* spare = static_cast<uint8_t*>(buffers_[(epoch + 1) & 1]);
+        if (n >= G_L3_CACHE_SIZE) {
+            detail::best_memcpy_stream(spare + offset, current + offset, n);
+        } else {
+            __builtin_memcpy(spare + offset, current + offset, n);
+        }
+    }
+
+    /**
+     * @brief Publishes the spare buffer, holding size bytes, as the next version.
+     * @return The new version number.
+     */
+    std::uint64_t publish(std::size_t size) noexcept {
+        const std::uint64_t next = epoch_.load(std::memory_order_relaxed) + 1;
+        sizes_[next & 1] = size;
+        // Order the streaming stores from copy_unchanged before the new version is visible
+        _mm_sfence();
+        epoch_.store(next, std::memory_order_seq_cst);
+        return next;
+    }
+
+    // Current version, starting at 0 with an empty buffer
+    std::uint64_t version() const noexcept { return epoch_.load(std::memory_order_acquire); }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+private:
+    struct alignas(64) reader_count {
+        std::atomic<std::int64_t> value{0};
+    };
+
+    std::int64_t active_readers(std::size_t parity) const noexcept {
+        std::int64_t total = 0;
+        for (const auto& count : readers_[parity]) {
+            total += count.value.load(std::memory_order_seq_cst);
+        }
+        return total;
+    }
+
+    // Buffers of at least a huge page are mapped; smaller ones, or failed mappings, use operator new
+    void allocate(std::size_t index) {
+        if (capacity_ >= detail::HUGE_PAGE_SIZE) {
+            buffers_[index] = detail::map_huge_pages(detail::round_to_huge_pages(capacity_));
+            mapped_[index] = buffers_[index] != nullptr;
+        }
+        if (!buffers_[index]) {
+            buffers_[index] = ::operator new(capacity_ > 0 ? capacity_ : 1, std::align_val_t{64});
+        }
+    }
+
+    void deallocate(std::size_t index) noexcept {
+        if (mapped_[index]) {
+            detail::unmap_huge_pages(buffers_[index], detail::round_to_huge_pages(capacity_));
+        } else {
+            ::operator delete(buffers_[index], std::align_val_t{64});
+        }
+    }
+
+    std::size_t capacity_;
+    void* buffers_[2] = {nullptr, nullptr};
+    bool mapped_[2] = {false, false};
+    std::size_t sizes_[2] = {0, 0};
+    alignas(64) std::atomic<std::uint64_t> epoch_{0};
+    mutable reader_count readers_[2][detail::RCU_READER_SHARDS];
+};
+
+} // namespace omm
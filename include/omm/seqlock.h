@@ -0,0 +1,175 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <immintrin.h>
+
+#include "omm/detail/cpu_features.h"
+
+#ifdef __AVX512F__
+#include "omm/detail/sync/seqlock_avx512.h"
+#endif
+#ifdef __AVX2__
+#include "omm/detail/sync/seqlock_avx2.h"
+#endif
+
+namespace omm {
+
+namespace detail {
+
+// Function pointer type for seqlock copy implementations
+using SeqlockCopyFunc = void (*)(void*, const void*, std::size_t);
+
+// Portable reader copy: relaxed atomic loads from the shared buffer, 8 bytes at a time
+// once the source is aligned
+inline void seqlock_read_generic(void* __restrict dest, const void* __restrict shared, std::size_t size) noexcept {
+    auto* dest_ptr = static_cast<uint8_t*>(dest);
+    const auto* src_ptr = static_cast<const uint8_t*>(shared);
+    std::size_t i = 0;
+    for (; i < size && (reinterpret_cast<std::uintptr_t>(src_ptr + i) & 7) != 0; ++i) {
+        dest_ptr[i] = __atomic_load_n(src_ptr + i, __ATOMIC_RELAXED);
+    }
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        const std::uint64_t word = __atomic_load_n(reinterpret_cast<const std::uint64_t*>(src_ptr + i), __ATOMIC_RELAXED);
+        __builtin_memcpy(dest_ptr + i, &word, sizeof(word));
+    }
+    for (; i < size; ++i) {
+        dest_ptr[i] = __atomic_load_n(src_ptr + i, __ATOMIC_RELAXED);
+    }
+}
+
+// Portable writer copy: relaxed atomic stores to the shared buffer, 8 bytes at a time
+// once the destination is aligned
+inline void seqlock_write_generic(void* __restrict shared, const void* __restrict src, std::size_t size) noexcept {
+    auto* dest_ptr = static_cast<uint8_t*>(shared);
+    const auto* src_ptr = static_cast<const uint8_t*>(src);
+    std::size_t i = 0;
+    for (; i < size && (reinterpret_cast<std::uintptr_t>(dest_ptr + i) & 7) != 0; ++i) {
+        __atomic_store_n(dest_ptr + i, src_ptr[i], __ATOMIC_RELAXED);
+    }
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+        std::uint64_t word;
+        __builtin_memcpy(&word, src_ptr + i, sizeof(word));
+        __atomic_store_n(reinterpret_cast<std::uint64_t*>(dest_ptr + i), word, __ATOMIC_RELAXED);
+    }
+    for (; i < size; ++i) {
+        __atomic_store_n(dest_ptr + i, src_ptr[i], __ATOMIC_RELAXED);
+    }
+}
+
+// Selects the optimal seqlock copies based on available CPU features. The vector kernels
+// serve both directions.
+inline SeqlockCopyFunc initialize_best_seqlock_read() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return seqlock_copy_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return seqlock_copy_avx2;
+    #endif
+    return seqlock_read_generic;
+}
+
+inline SeqlockCopyFunc initialize_best_seqlock_write() {
+    #ifdef __AVX512F__
+    if (cpu_supports_avx512f()) return seqlock_copy_avx512;
+    #endif
+    #ifdef __AVX2__
+    if (cpu_supports_avx2()) return seqlock_copy_avx2;
+    #endif
+    return seqlock_write_generic;
+}
+
+static const SeqlockCopyFunc best_seqlock_read = initialize_best_seqlock_read();
+static const SeqlockCopyFunc best_seqlock_write = initialize_best_seqlock_write();
+
+} // namespace detail
+
+/**
+ * @brief Copies a consistent snapshot of n bytes at shared into dest.
+ *
+ * Retries while a writer holds seq (odd) or has changed it during the copy. The copy
+ * runs between an acquire load of seq and an acquire fence, so every byte of an
+ * accepted snapshot comes from the same write.
+ *
+ * @return The even sequence number the snapshot belongs to.
+ */
+__attribute__((nonnull(1, 2)))
+inline std::uint64_t seqlock_copy(void* __restrict dest, const void* __restrict shared, std::size_t n,
+                                  const std::atomic<std::uint64_t>& seq) noexcept {
+    for (;;) {
+        const std::uint64_t before = seq.load(std::memory_order_acquire);
+        if (before & 1) {
+            _mm_pause();
+            continue;
+        }
+        detail::best_seqlock_read(dest, shared, n);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (seq.load(std::memory_order_relaxed) == before) return before;
+    }
+}
+
+/**
+ * @brief Writes n bytes from src into shared under seq.
+ *
+ * Writers take seq from even to odd with a CAS, so concurrent writers are serialized,
+ * and release it at the next even value once the copy is done.
+ */
+__attribute__((nonnull(1, 2)))
+inline void seqlock_write(void* __restrict shared, const void* __restrict src, std::size_t n,
+                          std::atomic<std::uint64_t>& seq) noexcept {
+    std::uint64_t current = seq.load(std::memory_order_relaxed);
+    for (;;) {
+        if (!(current & 1) && seq.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                                        std::memory_order_relaxed)) {
+            break;
+        }
+        _mm_pause();
+        current = seq.load(std::memory_order_relaxed);
+    }
+    // Readers that see any of the new bytes also see the odd sequence
+    std::atomic_thread_fence(std::memory_order_release);
+    detail::best_seqlock_write(shared, src, n);
+    seq.store(current + 2, std::memory_order_release);
+}
+
+/**
+ * @brief A value of trivially copyable type T shared through a seqlock.
+ *
+ * Readers never block the writer and copy out whole snapshots with vector loads; they
+ * retry when a write overlaps their copy. Suited to multi-kilobyte structures that are
+ * read far more often than written.
+ */
+template <typename T>
+class seqlock {
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock requires a trivially copyable type");
+
+public:
+    seqlock() noexcept = default;
+    explicit seqlock(const T& value) noexcept : value_(value) {}
+
+    T load() const noexcept {
+        T result;
+        load(result);
+        return result;
+    }
+
+    // Copies a snapshot into out and returns its sequence number
+    std::uint64_t load(T& out) const noexcept {
+        return seqlock_copy(&out, &value_, sizeof(T), seq_);
+    }
+
+    void store(const T& value) noexcept {
+        seqlock_write(&value_, &value, sizeof(T), seq_);
+    }
+
+    // Even between writes; advances by two per write
+    std::uint64_t sequence() const noexcept { return seq_.load(std::memory_order_acquire); }
+
+private:
+    alignas(64) std::atomic<std::uint64_t> seq_{0};
+    alignas(64) T value_{};
+};
+
+} // namespace omm
@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "omm/memcpy.h"
+#include "omm/detail/memory/huge_pages.h"
+
+namespace omm {
+
+/**
+ * @brief Opt-in trait for types that can be relocated with a byte copy.
+ *
+ * A trivially relocatable type may be moved to a new address by copying its bytes
+ * and forgetting the original, without running its move constructor or destructor.
+ * Trivially copyable types qualify automatically; specialize this for others, such
+ * as types holding a unique pointer to a heap object.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+/**
+ * @brief Contiguous container specialized for large arrays of trivially relocatable types.
+ *
+ * Differences from std::vector:
+ * - Trivially relocatable elements are relocated with omm::memcpy rather than
+ *   element-wise moves.
+ * - Storage of at least HUGE_STORAGE_THRESHOLD bytes is mapped on huge page boundaries,
+ *   and grows with mremap so the kernel moves page tables instead of copying data.
+ * - resize_uninitialized grows the size without value-initializing new elements.
+ */
+template <typename T>
+class vector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    // Storage at least this large comes from huge page mappings
+    static constexpr size_type HUGE_STORAGE_THRESHOLD = detail::HUGE_PAGE_SIZE;
+
+    vector() noexcept = default;
+
+    // The constructors that allocate delegate to the default one, so the object is fully
+    // constructed and the destructor frees the storage if an element constructor throws
+    explicit vector(size_type count) : vector() {
+        resize(count);
+    }
+
+    vector(size_type count, const T& value) : vector() {
+        resize(count, value);
+    }
+
+    vector(std::initializer_list<T> init) : vector() {
+        reserve(init.size());
+        std::uninitialized_copy(init.begin(), init.end(), data_);
+        size_ = init.size();
+    }
+
+    vector(const vector& other) : vector() {
+        reserve(other.size_);
+        copy_elements(data_, other.data_, other.size_);
+        size_ = other.size_;
+    }
+
+    vector(vector&& other) noexcept
+            : data_(std::exchange(other.data_, nullptr)),
+              size_(std::exchange(other.size_, 0)),
+              capacity_(std::exchange(other.capacity_, 0)),
+              mapped_(std::exchange(other.mapped_, false)) {}
+
+    vector& operator=(const vector& other) {
+        if (this != &other) {
+            vector copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    vector& operator=(vector&& other) noexcept {
+        vector moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~vector() {
+        clear();
+        deallocate(data_, capacity_, mapped_);
+    }
+
+    void swap(vector& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(mapped_, other.mapped_);
+    }
+
+    // === Element access ===
+
+    T& operator[](size_type index) noexcept { return data_[index]; }
+    const T& operator[](size_type index) const noexcept { return data_[index]; }
+    T& front() noexcept { return data_[0]; }
+    const T& front() const noexcept { return data_[0]; }
+    T& back() noexcept { return data_[size_ - 1]; }
+    const T& back() const noexcept { return data_[size_ - 1]; }
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+
+    iterator begin() noexcept { return data_; }
+    iterator end() noexcept { return data_ + size_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+
+    // === Capacity ===
+
+    bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+
+    // True if the storage is a huge page mapping
+    bool is_mapped() const noexcept { return mapped_; }
+
+    void reserve(size_type new_capacity) {
+        if (new_capacity > capacity_) reallocate(new_capacity);
+    }
+
+    // === Modifiers ===
+
+    void clear() noexcept {
+        std::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (__builtin_expect(size_ == capacity_, 0)) return emplace_back_grow(std::forward<Args>(args)...);
+        T* slot = std::construct_at(data_ + size_, std::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void pop_back() noexcept {
+        std::destroy_at(data_ + --size_);
+    }
+
+    void resize(size_type count) {
+        if (count > capacity_) grow(count);
+        if (count > size_) {
+            std::uninitialized_value_construct(data_ + size_, data_ + count);
+        } else {
+            std::destroy(data_ + count, data_ + size_);
+        }
+        size_ = count;
+    }
+
+    void resize(size_type count, const T& value) {
+        if (count > capacity_) {
+            // value may be an element, which growing moves
+            const T copy(value);
+            grow(count);
+            std::uninitialized_fill(data_ + size_, data_ + count, copy);
+            size_ = count;
+            return;
+        }
+        if (count > size_) {
+            std::uninitialized_fill(data_ + size_, data_ + count, value);
+        } else {
+            std::destroy(data_ + count, data_ + size_);
+        }
+        size_ = count;
+    }
+
+    /**
+     * @brief Resizes without initializing new elements.
+     *
+     * New elements hold indeterminate values and must be written before being read.
+     * On mapped storage the pages are not touched, so no page faults are taken until
+     * the caller fills them.
+     */
+    void resize_uninitialized(size_type count) {
+        static_assert(std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>,
+                      "resize_uninitialized requires a trivial type");
+        if (count > capacity_) grow(count);
+        size_ = count;
+    }
+
+private:
+    static constexpr bool RELOCATE_BY_COPY = is_trivially_relocatable_v<T>;
+
+    static void copy_elements(T* dest, const T* src, size_type count) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (count > 0) omm::memcpy(dest, src, count * sizeof(T));
+        } else {
+            std::uninitialized_copy(src, src + count, dest);
+        }
+    }
+
+    // Allocates storage for at least count elements; mapped storage is rounded up to
+    // whole huge pages and count is updated to the usable capacity
+    static T* allocate(size_type& count, bool& mapped) {
+        const size_type bytes = count * sizeof(T);
+        if (bytes >= HUGE_STORAGE_THRESHOLD) {
+            const size_type mapped_bytes = detail::round_to_huge_pages(bytes);
+            if (void* ptr = detail::map_huge_pages(mapped_bytes)) {
+                count = mapped_bytes / sizeof(T);
+                mapped = true;
+                return static_cast<T*>(ptr);
+            }
+        }
+        mapped = false;
+        return static_cast<T*>(::operator new(bytes, std::align_val_t{alignof(T)}));
+    }
+
+    static void deallocate(T* ptr, size_type count, bool mapped) noexcept {
+        if (!ptr) return;
+        if (mapped) {
+            detail::unmap_huge_pages(ptr, detail::round_to_huge_pages(count * sizeof(T)));
+        } else {
+            ::operator delete(ptr, std::align_val_t{alignof(T)});
+        }
+    }
+
+    // The arguments may refer to elements, which growing moves, so the element is built
+    // before the storage is reallocated
+    template <typename... Args>
+    __attribute__((noinline)) T& emplace_back_grow(Args&&... args) {
+        T value(std::forward<Args>(args)...);
+        grow(size_ + 1);
+        T* slot = std::construct_at(data_ + size_, std::move(value));
+        ++size_;
+        return *slot;
+    }
+
+    // Geometric growth to at least min_capacity
+    void grow(size_type min_capacity) {
+        reallocate(std::max(min_capacity, capacity_ * 2));
+    }
+
+    void reallocate(size_type new_capacity) {
+        // Mapped storage grows in place or moves by remapping, without copying
+        if constexpr (RELOCATE_BY_COPY) {
+            if (mapped_) {
+                const size_type old_bytes = detail::round_to_huge_pages(capacity_ * sizeof(T));
+                const size_type new_bytes = detail::round_to_huge_pages(new_capacity * sizeof(T));
+                if (void* ptr = detail::remap_huge_pages(data_, old_bytes, new_bytes)) {
+                    data_ = static_cast<T*>(ptr);
+                    capacity_ = new_bytes / sizeof(T);
+                    return;
+                }
+            }
+        }
+
+        bool new_mapped = false;
+        T* new_data = allocate(new_capacity, new_mapped);
+
+        if constexpr (RELOCATE_BY_COPY) {
+            if (size_ > 0) omm::memcpy(static_cast<void*>(new_data), static_cast<const void*>(data_), size_ * sizeof(T));
+        } else {
+            try {
+                std::uninitialized_move(data_, data_ + size_, new_data);
+            } catch (...) {
+                deallocate(new_data, new_capacity, new_mapped);
+                throw;
+            }
+            std::destroy(data_, data_ + size_);
+        }
+
+        deallocate(data_, capacity_, mapped_);
+        data_ = new_data;
+        capacity_ = new_capacity;
+        mapped_ = new_mapped;
+    }
+
+    T* data_ = nullptr;
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+    bool mapped_ = false;
+};
+
+} // namespace omm
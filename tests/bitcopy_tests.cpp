@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "omm/bitcopy.h"
+
+using BitcopyShiftedFunc = void (*)(uint8_t*, const uint8_t*, unsigned, std::size_t);
+
+namespace {
+
+// Bit-at-a-time reference
+void reference_bitcopy(uint8_t* dest, std::size_t dest_bit, const uint8_t* src, std::size_t src_bit, std::size_t nbits) {
+    for (std::size_t i = 0; i < nbits; ++i) {
+        const std::size_t s = src_bit + i;
+        const std::size_t d = dest_bit + i;
+        const unsigned bit = (src[s / 8] >> (s % 8)) & 1;
+        dest[d / 8] = static_cast<uint8_t>((dest[d / 8] & ~(1u << (d % 8))) | (bit << (d % 8)));
+    }
+}
+
+std::vector<uint8_t> random_bytes(std::size_t size, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> bytes(size);
+    for (auto& byte : bytes) byte = static_cast<uint8_t>(rng());
+    return bytes;
+}
+
+} // namespace
+
+class BitcopyShiftedTest : public ::testing::TestWithParam<std::pair<BitcopyShiftedFunc, const char*>> {
+protected:
+    void SetUp() override {
+        // The AVX-512 kernel is compiled whenever AVX-512F is, but also needs VBMI2 to run
+        if (std::string(GetParam().second).find("avx512") != std::string::npos && !omm::detail::cpu_supports_avx512vbmi2()) {
+            GTEST_SKIP() << "AVX-512 VBMI2 not supported";
+        }
+    }
+};
+
+TEST_P(BitcopyShiftedTest, MatchesByteFunnel) {
+    auto [shifted_func, func_name] = GetParam();
+    const auto src = random_bytes(4096 + 1, 1);
+
+    for (std::size_t size = 0; size <= 4096; size += (size < 300 ? 1 : 379)) {
+        for (unsigned shift = 1; shift < 8; ++shift) {
+            // The kernel may read exactly size + 1 bytes; a copy that ends there catches overreads under ASan
+            const std::vector<uint8_t> source(src.begin(), src.begin() + static_cast<std::ptrdiff_t>(size + 1));
+            std::vector<uint8_t> dest(size + 1, 0xA5);
+            shifted_func(dest.data(), source.data(), shift, size);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto expected = static_cast<uint8_t>((source[i] >> shift) | (source[i + 1] << (8 - shift)));
+                ASSERT_EQ(expected, dest[i]) << func_name << ": size " << size << ", shift " << shift << ", byte " << i;
+            }
+            ASSERT_EQ(0xA5, dest[size]) << func_name << ": wrote past size " << size;
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        BitcopyShiftedTests,
+        BitcopyShiftedTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::bitcopy_shifted_generic, "bitcopy_shifted_generic"),
+                std::make_pair(omm::bitcopy_shifted_avx2, "omm::bitcopy_shifted_avx2")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        BitcopyShiftedTestsAVX512,
+        BitcopyShiftedTest,
+        ::testing::Values(
+                std::make_pair(omm::bitcopy_shifted_avx512, "omm::bitcopy_shifted_avx512")
+        )
+);
+#endif
+
+TEST(BitcopyTest, MatchesReferenceAtAllOffsets) {
+    const auto src = random_bytes(512, 2);
+    const auto background = random_bytes(512, 3);
+
+    for (std::size_t nbits = 0; nbits <= 2000; nbits += (nbits < 80 ? 1 : 97)) {
+        for (std::size_t src_bit = 0; src_bit < 16; ++src_bit) {
+            for (std::size_t dest_bit = 0; dest_bit < 16; ++dest_bit) {
+                auto expected = background;
+                auto actual = background;
+                reference_bitcopy(expected.data(), dest_bit, src.data(), src_bit, nbits);
+                omm::bitcopy(actual.data(), dest_bit, src.data(), src_bit, nbits);
+                ASSERT_EQ(expected, actual) << "nbits " << nbits << ", src_bit " << src_bit << ", dest_bit " << dest_bit;
+            }
+        }
+    }
+}
+
+TEST(BitcopyTest, LargeRunsAtFarOffsets) {
+    const std::size_t nbits = 8 * 1024 * 1024 + 13;
+    const auto src = random_bytes(nbits / 8 + 2048, 4);
+
+    for (auto [src_bit, dest_bit] : {std::pair<std::size_t, std::size_t>{8000, 16000}, {8003, 16000}, {8003, 16005}, {13, 70}}) {
+        std::vector<uint8_t> expected(nbits / 8 + 4096, 0x5A);
+        auto actual = expected;
+        reference_bitcopy(expected.data(), dest_bit, src.data(), src_bit, nbits);
+        omm::bitcopy(actual.data(), dest_bit, src.data(), src_bit, nbits);
+        ASSERT_EQ(expected, actual) << "src_bit " << src_bit << ", dest_bit " << dest_bit;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "omm/compress_copy.h"
+
+namespace {
+
+template <typename T>
+using Kernel = std::pair<omm::detail::CompressCopyFunc<T>, std::string>;
+
+// Every kernel for the element type this CPU can run, with its name
+template <typename T>
+std::vector<Kernel<T>> kernels() {
+    std::vector<Kernel<T>> result = {
+            {omm::detail::compress_copy_generic<T>, "compress_copy_generic"},
+            {omm::compress_copy_avx2<T>, "omm::compress_copy_avx2"}};
+#ifdef __AVX512F__
+    if (omm::detail::cpu_supports_avx512bw() && (sizeof(T) >= 4 || (omm::detail::cpu_supports_avx512vbmi() && omm::detail::cpu_supports_avx512vbmi2()))) {
+        result.emplace_back(omm::compress_copy_avx512<T>, "omm::compress_copy_avx512");
+    }
+#endif
+    result.emplace_back(
+            [](T* dest, const T* src, const std::uint8_t* mask, std::size_t count) { return omm::compress_copy(dest, src, mask, count); },
+            "omm::compress_copy");
+    return result;
+}
+
+// Distinct, nonzero values
+template <typename T>
+std::vector<T> make_source(std::size_t count) {
+    std::vector<T> src(count);
+    for (std::size_t i = 0; i < count; ++i) src[i] = static_cast<T>(i * 2654435761u | 1);
+    return src;
+}
+
+// A bitmap for count elements keeping each with the given probability
+std::vector<std::uint8_t> make_mask(std::size_t count, double density, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution keep(density);
+    std::vector<std::uint8_t> mask((count + 7) / 8);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (keep(rng)) mask[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+    }
+    return mask;
+}
+
+template <typename T>
+std::vector<T> expected_output(const std::vector<T>& src, const std::vector<std::uint8_t>& mask) {
+    std::vector<T> expected;
+    for (std::size_t i = 0; i < src.size(); ++i) {
+        if (mask[i / 8] >> (i % 8) & 1) expected.push_back(src[i]);
+    }
+    return expected;
+}
+
+} // namespace
+
+template <typename T>
+class CompressCopyTest : public ::testing::Test {};
+
+using ElementTypes = ::testing::Types<std::uint8_t, std::int16_t, std::uint32_t, float, std::uint64_t, double>;
+TYPED_TEST_SUITE(CompressCopyTest, ElementTypes);
+
+TYPED_TEST(CompressCopyTest, KeepsSelectedElementsInOrder) {
+    using T = TypeParam;
+    const auto all = kernels<T>();
+
+    // Every size through a few vectors of the widest kernel, then one uneven larger size
+    std::vector<std::size_t> sizes;
+    for (std::size_t count = 0; count <= 200; ++count) sizes.push_back(count);
+    sizes.push_back(4099);
+
+    for (std::size_t count : sizes) {
+        const auto src = make_source<T>(count);
+        for (double density : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+            const auto mask = make_mask(count, density, count);
+            const auto expected = expected_output(src, mask);
+
+            for (auto [kernel, name] : all) {
+                // Every offset from a vector boundary, with one guard element on either side
+                for (std::size_t offset : {std::size_t{1}, std::size_t{3}, 64 / sizeof(T)}) {
+                    std::vector<T> dest(expected.size() + offset + 1);
+                    const std::size_t written = kernel(dest.data() + offset, src.data(), mask.data(), count);
+                    ASSERT_EQ(expected.size(), written) << name << ": " << count << " elements at density " << density;
+                    for (std::size_t i = 0; i < written; ++i) {
+                        ASSERT_EQ(expected[i], dest[offset + i]) << name << ": element " << i << " of " << count << " at density " << density;
+                    }
+                    for (std::size_t i = 0; i < offset; ++i) ASSERT_EQ(T{}, dest[i]) << name << ": wrote before dest";
+                    ASSERT_EQ(T{}, dest[offset + written]) << name << ": wrote past " << written << " elements";
+                }
+            }
+        }
+    }
+}
+
+TYPED_TEST(CompressCopyTest, HandlesClusteredMasks) {
+    using T = TypeParam;
+    // Long runs of kept and dropped elements, so vectors fill across many empty chunks
+    constexpr std::size_t COUNT = 5000;
+    const auto src = make_source<T>(COUNT);
+    std::vector<std::uint8_t> mask((COUNT + 7) / 8);
+    for (std::size_t i = 0; i < COUNT; ++i) {
+        if ((i / 300) % 2 == 1 || i % 977 == 0) mask[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+    }
+    const auto expected = expected_output(src, mask);
+
+    for (auto [kernel, name] : kernels<T>()) {
+        std::vector<T> dest(expected.size() + 1);
+        ASSERT_EQ(expected.size(), kernel(dest.data() + 1, src.data(), mask.data(), COUNT)) << name;
+        ASSERT_EQ(expected, std::vector<T>(dest.begin() + 1, dest.end())) << name;
+    }
+}
+
+// Elements whose alignment is below their size, at destinations off the element size
+struct Point {
+    float x, y;
+    bool operator==(const Point&) const = default;
+};
+
+struct Rgba {
+    std::uint8_t r, g, b, a;
+    bool operator==(const Rgba&) const = default;
+};
+
+template <typename T>
+void check_underaligned_destination(const std::vector<T>& src) {
+    const auto mask = make_mask(src.size(), 0.6, 5);
+    const auto expected = expected_output(src, mask);
+    // Bytes before dest and past the output stay untouched
+    for (std::size_t offset = 1; offset < sizeof(T); ++offset) {
+        std::vector<std::uint8_t> bytes((expected.size() + 2) * sizeof(T), 0xEE);
+        T* dest = reinterpret_cast<T*>(bytes.data() + offset);
+        ASSERT_EQ(expected.size(), omm::compress_copy(dest, src.data(), mask.data(), src.size())) << "offset " << offset;
+        for (std::size_t i = 0; i < expected.size(); ++i) ASSERT_EQ(expected[i], dest[i]) << "offset " << offset << ", element " << i;
+        for (std::size_t b = 0; b < offset; ++b) ASSERT_EQ(0xEE, bytes[b]) << "offset " << offset;
+        for (std::size_t b = offset + expected.size() * sizeof(T); b < bytes.size(); ++b) ASSERT_EQ(0xEE, bytes[b]) << "offset " << offset;
+    }
+}
+
+TEST(CompressCopyUnderalignedTest, CopiesToDestinationsOffTheElementSize) {
+    std::vector<Point> points(1000);
+    for (std::size_t i = 0; i < points.size(); ++i) points[i] = {static_cast<float>(i), -static_cast<float>(i)};
+    check_underaligned_destination(points);
+
+    std::vector<Rgba> pixels(200);
+    for (std::size_t i = 0; i < pixels.size(); ++i) {
+        pixels[i] = {static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(i * 3), static_cast<std::uint8_t>(i * 7), static_cast<std::uint8_t>(~i)};
+    }
+    check_underaligned_destination(pixels);
+}
+
+TEST(CompressCopyStreamTest, StreamsLargeInputs) {
+    // Inputs past the streaming threshold, with an unaligned destination
+    const std::size_t count = G_L3_CACHE_SIZE / sizeof(std::uint32_t) + 1001;
+    const auto src = make_source<std::uint32_t>(count);
+    const auto mask = make_mask(count, 0.7, 11);
+    const auto expected = expected_output(src, mask);
+
+    for (auto [kernel, name] : kernels<std::uint32_t>()) {
+        std::vector<std::uint32_t> dest(expected.size() + 2);
+        ASSERT_EQ(expected.size(), kernel(dest.data() + 1, src.data(), mask.data(), count)) << name;
+        for (std::size_t i = 0; i < expected.size(); i += 997) ASSERT_EQ(expected[i], dest[i + 1]) << name << ": element " << i;
+        ASSERT_EQ(expected.back(), dest[expected.size()]) << name;
+        ASSERT_EQ(0u, dest[expected.size() + 1]) << name << ": wrote past the output";
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include "omm/concat.h"
+
+using ConcatFunc = std::size_t (*)(void*, const iovec*, std::size_t);
+
+class ConcatTest : public ::testing::TestWithParam<std::pair<ConcatFunc, const char*>> {
+protected:
+    std::mt19937 gen{42};  // Fixed seed for reproducibility
+
+    std::vector<char> generate_random_data(size_t size) {
+        std::vector<char> data(size);
+        std::uniform_int_distribution<> dis(0, 255);
+        std::generate(data.begin(), data.end(), [&]() { return static_cast<char>(dis(gen)); });
+        return data;
+    }
+
+    // Concatenates slices of the given lengths, cut from one random source at shuffled
+    // offsets, and checks the output against per-slice memcpy
+    void check_concat(const std::vector<size_t>& lengths, size_t dest_offset) {
+        auto [concat_func, func_name] = GetParam();
+
+        size_t total = 0;
+        for (size_t length : lengths) total += length;
+        auto src = generate_random_data(total + lengths.size() * 7);
+
+        // Place slices at varying source alignments and in non-sequential source order
+        std::vector<iovec> slices;
+        std::vector<size_t> order(lengths.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), gen);
+        std::vector<size_t> starts(lengths.size());
+        size_t cursor = 0;
+        for (size_t index : order) {
+            cursor += index % 7;
+            starts[index] = cursor;
+            cursor += lengths[index];
+        }
+        for (size_t s = 0; s < lengths.size(); ++s) {
+            slices.push_back({src.data() + starts[s], lengths[s]});
+        }
+
+        std::vector<char> expected(total);
+        size_t offset = 0;
+        for (const auto& slice : slices) {
+            std::memcpy(expected.data() + offset, slice.iov_base, slice.iov_len);
+            offset += slice.iov_len;
+        }
+
+        std::vector<char> dest(total + dest_offset + 64, 0);
+        EXPECT_EQ(total, concat_func(dest.data() + dest_offset, slices.data(), slices.size())) << func_name;
+        EXPECT_EQ(0, std::memcmp(dest.data() + dest_offset, expected.data(), total))
+                << func_name << ": mismatch for " << lengths.size() << " slices, dest offset " << dest_offset;
+        EXPECT_EQ(0, dest[dest_offset + total]) << "Overflow detected in destination";
+        if (dest_offset > 0) {
+            EXPECT_EQ(0, dest[dest_offset - 1]) << "Underflow detected in destination";
+        }
+    }
+};
+
+TEST_P(ConcatTest, Empty) {
+    auto [concat_func, func_name] = GetParam();
+    char dest = 'x';
+    EXPECT_EQ(0u, concat_func(&dest, nullptr, 0)) << func_name;
+    check_concat({0, 0, 0}, 3);
+}
+
+TEST_P(ConcatTest, SmallSlices) {
+    std::uniform_int_distribution<size_t> dis(0, 300);
+    std::vector<size_t> lengths(500);
+    std::generate(lengths.begin(), lengths.end(), [&]() { return dis(gen); });
+    for (size_t offset : {0, 1, 31, 63}) {
+        check_concat(lengths, offset);
+    }
+}
+
+// Outputs beyond the L3 threshold take the streaming path, with slice boundaries at
+// every alignment and empty or single-byte slices between large ones
+TEST_P(ConcatTest, StreamingSizes) {
+    std::vector<size_t> lengths;
+    size_t total = 0;
+    std::uniform_int_distribution<size_t> small(0, 100);
+    std::uniform_int_distribution<size_t> large(4096, 1 << 20);
+    while (total < G_L3_CACHE_SIZE + 4096) {
+        for (size_t length : {large(gen), small(gen), size_t{0}, size_t{1}, small(gen), large(gen)}) {
+            lengths.push_back(length);
+            total += length;
+        }
+    }
+    for (size_t offset : {0, 5, 33}) {
+        check_concat(lengths, offset);
+    }
+}
+
+TEST_P(ConcatTest, ManyTinySlicesStreaming) {
+    std::uniform_int_distribution<size_t> dis(1, 40);
+    std::vector<size_t> lengths;
+    size_t total = 0;
+    while (total < G_L3_CACHE_SIZE + 1) {
+        lengths.push_back(dis(gen));
+        total += lengths.back();
+    }
+    check_concat(lengths, 17);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        ConcatTests,
+        ConcatTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::concat_generic, "generic"),
+                std::make_pair(omm::concat_avx2, "omm::concat_avx2"),
+                std::make_pair(omm::detail::best_concat, "omm::detail::best_concat")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        ConcatTestsAVX512,
+        ConcatTest,
+        ::testing::Values(
+                std::make_pair(omm::concat_avx512, "omm::concat_avx512")
+        )
+);
+#endif
+
+TEST(ConcatApiTest, SpanOverload) {
+    const char first[] = "hello, ";
+    const char second[] = "world";
+    const iovec slices[] = {{const_cast<char*>(first), 7}, {const_cast<char*>(second), 5}};
+    char dest[13] = {};
+
+    EXPECT_EQ(12u, omm::concat(dest, slices));
+    EXPECT_STREQ("hello, world", dest);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
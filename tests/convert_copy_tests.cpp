@@ -0,0 +1,200 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "omm/convert_copy.h"
+
+namespace {
+
+template <typename From, typename To>
+using ConvertCopyFunc = void (*)(To*, const From*, std::size_t);
+
+// Every kernel for the pair this CPU can run, with its name
+template <typename From, typename To>
+std::vector<std::pair<ConvertCopyFunc<From, To>, std::string>> kernels() {
+    std::vector<std::pair<ConvertCopyFunc<From, To>, std::string>> result;
+    result.emplace_back(omm::detail::convert_copy_generic<From, To>, "convert_copy_generic");
+    const bool needs_f16c = std::is_same_v<From, omm::float16> || std::is_same_v<To, omm::float16>;
+    if (!needs_f16c || omm::detail::cpu_supports_f16c()) {
+        result.emplace_back(omm::convert_copy_avx2<From, To>, "omm::convert_copy_avx2");
+    }
+#ifdef __AVX512F__
+    if (omm::detail::cpu_supports_avx512bw()) {
+        result.emplace_back(omm::convert_copy_avx512<From, To>, "omm::convert_copy_avx512");
+    }
+#endif
+    result.emplace_back(omm::convert_copy<From, To>, "omm::convert_copy");
+    return result;
+}
+
+template <typename T>
+auto bits_of(T value) {
+    if constexpr (std::is_same_v<T, float>) return std::bit_cast<std::uint32_t>(value);
+    else if constexpr (std::is_same_v<T, omm::float16> || std::is_same_v<T, omm::bfloat16>) return value.bits;
+    else return value;
+}
+
+// Runs every kernel over src at several destination offsets and sizes, comparing bit
+// patterns with the element-wise conversion
+template <typename From, typename To>
+void check_all_kernels(const std::vector<From>& src) {
+    for (auto [kernel, name] : kernels<From, To>()) {
+        for (std::size_t count : {src.size(), src.size() - 1, std::size_t{1}, std::size_t{0}}) {
+            for (std::size_t offset : {0, 1}) {
+                std::vector<To> dest(count + offset + 1);
+                kernel(dest.data() + offset, src.data(), count);
+                for (std::size_t i = 0; i < count; ++i) {
+                    ASSERT_EQ(bits_of(omm::detail::convert_element<From, To>(src[i])), bits_of(dest[offset + i]))
+                            << name << ": element " << i << " of " << count << ", source " << +bits_of(src[i]);
+                }
+                ASSERT_EQ(bits_of(To{}), bits_of(dest[count + offset])) << name << ": wrote past " << count;
+            }
+        }
+    }
+}
+
+std::vector<float> interesting_floats() {
+    std::vector<float> values = {0.0f, -0.0f, 1.0f, -1.0f, 65504.0f, 65519.99f, 65520.0f, -65520.0f, 1e10f,
+                                 std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(),
+                                 std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min(),
+                                 std::ldexp(1.0f, -14), std::ldexp(1.0f, -24), std::ldexp(1.0f, -25), std::ldexp(1.5f, -25),
+                                 std::ldexp(1.0f, -26), std::ldexp(3.0f, -26)};
+    // Quiet and signaling NaNs with payloads
+    for (std::uint32_t bits : {0x7FC00000u, 0xFFC00001u, 0x7F800001u, 0x7FA00000u, 0xFF812345u}) {
+        values.push_back(std::bit_cast<float>(bits));
+    }
+    // Exact ties and their neighbours for both rounding grids
+    for (std::uint32_t base : {0x3F800000u, 0x38800000u, 0x477FE000u, 0x33800000u}) {
+        for (std::uint32_t low : {0x0FFFu, 0x1000u, 0x1001u, 0x3000u, 0x7FFFu, 0x8000u, 0x8001u, 0x18000u}) {
+            values.push_back(std::bit_cast<float>(base + low));
+        }
+    }
+    std::mt19937 rng(7);
+    while (values.size() < 4099) values.push_back(std::bit_cast<float>(static_cast<std::uint32_t>(rng())));
+    return values;
+}
+
+} // namespace
+
+TEST(Float16Test, WidensEveryValueLikeHardware) {
+    std::vector<omm::float16> halves(65536);
+    for (std::uint32_t bits = 0; bits < 65536; ++bits) halves[bits].bits = static_cast<std::uint16_t>(bits);
+    check_all_kernels<omm::float16, float>(halves);
+}
+
+TEST(Float16Test, RoundsLikeHardware) {
+    check_all_kernels<float, omm::float16>(interesting_floats());
+}
+
+TEST(Float16Test, ScalarRoundTrips) {
+    EXPECT_EQ(0x3C00, omm::to_float16(1.0f).bits);
+    EXPECT_EQ(0x7BFF, omm::to_float16(65504.0f).bits);
+    EXPECT_EQ(0x7C00, omm::to_float16(65520.0f).bits);
+    EXPECT_EQ(0x0001, omm::to_float16(std::ldexp(1.0f, -24)).bits);
+    EXPECT_EQ(0x0000, omm::to_float16(std::ldexp(1.0f, -25)).bits);  // Tie to even
+    EXPECT_EQ(1.5f, omm::to_float(omm::to_float16(1.5f)));
+    EXPECT_EQ(0x7E00, omm::to_float16(std::bit_cast<float>(0x7FC00000u)).bits);
+}
+
+TEST(BFloat16Test, WidensEveryValue) {
+    std::vector<omm::bfloat16> halves(65536);
+    for (std::uint32_t bits = 0; bits < 65536; ++bits) halves[bits].bits = static_cast<std::uint16_t>(bits);
+    check_all_kernels<omm::bfloat16, float>(halves);
+    EXPECT_EQ(1.0f, omm::to_float(omm::bfloat16{0x3F80}));
+}
+
+TEST(BFloat16Test, RoundsToNearestEven) {
+    check_all_kernels<float, omm::bfloat16>(interesting_floats());
+    EXPECT_EQ(0x3F80, omm::to_bfloat16(std::bit_cast<float>(0x3F808000u)).bits);  // Tie to even
+    EXPECT_EQ(0x3F82, omm::to_bfloat16(std::bit_cast<float>(0x3F818000u)).bits);
+    EXPECT_EQ(0x7FC1, omm::to_bfloat16(std::bit_cast<float>(0x7F812345u)).bits);  // Signaling NaN quieted
+}
+
+template <typename Pair>
+class IntegerConvertTest : public ::testing::Test {};
+
+using IntegerPairs = ::testing::Types<
+        std::pair<std::int8_t, std::int16_t>, std::pair<std::int8_t, std::int32_t>, std::pair<std::int8_t, std::int64_t>,
+        std::pair<std::int16_t, std::int32_t>, std::pair<std::int16_t, std::int64_t>, std::pair<std::int32_t, std::int64_t>,
+        std::pair<std::int16_t, std::int8_t>, std::pair<std::int32_t, std::int8_t>, std::pair<std::int64_t, std::int8_t>,
+        std::pair<std::int32_t, std::int16_t>, std::pair<std::int64_t, std::int16_t>, std::pair<std::int64_t, std::int32_t>,
+        std::pair<std::uint8_t, std::uint16_t>, std::pair<std::uint8_t, std::uint32_t>, std::pair<std::uint8_t, std::uint64_t>,
+        std::pair<std::uint16_t, std::uint32_t>, std::pair<std::uint16_t, std::uint64_t>, std::pair<std::uint32_t, std::uint64_t>,
+        std::pair<std::uint16_t, std::uint8_t>, std::pair<std::uint32_t, std::uint8_t>, std::pair<std::uint64_t, std::uint8_t>,
+        std::pair<std::uint32_t, std::uint16_t>, std::pair<std::uint64_t, std::uint16_t>, std::pair<std::uint64_t, std::uint32_t>>;
+TYPED_TEST_SUITE(IntegerConvertTest, IntegerPairs);
+
+TYPED_TEST(IntegerConvertTest, MatchesSaturatingScalar) {
+    using From = typename TypeParam::first_type;
+    using To = typename TypeParam::second_type;
+    using Limits = std::numeric_limits<From>;
+
+    // Extremes, the target's bounds and one past them, then random values at every magnitude
+    std::vector<From> values = {Limits::min(), Limits::max(), From{0}, From{1}};
+    for (From bound : {static_cast<From>(std::numeric_limits<To>::max()), static_cast<From>(std::numeric_limits<To>::min())}) {
+        values.push_back(bound);
+        values.push_back(static_cast<From>(bound + 1));
+        values.push_back(static_cast<From>(bound - 1));
+    }
+    std::mt19937_64 rng(11);
+    while (values.size() < 300) {
+        values.push_back(static_cast<From>(rng() >> (rng() % (64 - 1))));
+        values.push_back(static_cast<From>(rng()));
+    }
+    check_all_kernels<From, To>(values);
+
+    // Every size up to a few unrolled blocks, for the partial steps
+    for (std::size_t count = 0; count <= 200; ++count) {
+        std::vector<To> expected(count);
+        std::vector<To> actual(count);
+        omm::detail::convert_copy_generic(expected.data(), values.data(), count);
+        omm::convert_copy(actual.data(), values.data(), count);
+        ASSERT_EQ(expected, actual) << "count " << count;
+    }
+}
+
+TEST(ConvertCopyTest, SaturatesNarrowing) {
+    const std::vector<std::int32_t> src = {300, -300, 127, -128, 5};
+    std::vector<std::int8_t> dest(src.size());
+    omm::convert_copy(dest.data(), src.data(), src.size());
+    EXPECT_EQ((std::vector<std::int8_t>{127, -128, 127, -128, 5}), dest);
+
+    const std::vector<std::uint64_t> big = {~std::uint64_t{0}, 70000, 65535, 1};
+    std::vector<std::uint16_t> narrow(big.size());
+    omm::convert_copy(narrow.data(), big.data(), big.size());
+    EXPECT_EQ((std::vector<std::uint16_t>{65535, 65535, 65535, 1}), narrow);
+}
+
+TEST(ConvertCopyTest, StreamsLargeOutputs) {
+    // Output past the streaming threshold, at a destination offset the prologue must align
+    const std::size_t count = G_L3_CACHE_SIZE / sizeof(omm::float16) + 1001;
+    std::vector<float> src(count);
+    for (std::size_t i = 0; i < count; ++i) src[i] = static_cast<float>(i % 4099) * 0.37f - 700.0f;
+
+    for (auto [kernel, name] : kernels<float, omm::float16>()) {
+        if (name == "convert_copy_generic") continue;
+        std::vector<omm::float16> dest(count + 3);
+        kernel(dest.data() + 3, src.data(), count);
+        for (std::size_t i = 0; i < count; i += 997) {
+            ASSERT_EQ(omm::to_float16(src[i]), dest[i + 3]) << name << ": element " << i;
+        }
+        ASSERT_EQ(omm::to_float16(src[count - 1]), dest[count + 2]) << name;
+    }
+}
+
+TEST(ConvertCopyTest, SameTypeIsCopy) {
+    const std::vector<std::int32_t> src = {1, -2, 3};
+    std::vector<std::int32_t> dest(src.size());
+    omm::convert_copy(dest.data(), src.data(), src.size());
+    EXPECT_EQ(src, dest);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstddef>
+#include "omm/copy_cost.h"
+
+namespace {
+
+constexpr std::size_t KB = 1024;
+constexpr std::size_t MB = 1024 * KB;
+
+// A host with round numbers: 32KB/1MB/32MB caches measured at working sets a power of 16
+// apart, 1 ns per byte more per tier with regular stores, and 8 hardware threads
+omm::copy_calibration fixed_calibration() {
+    omm::copy_calibration calibration;
+    calibration.capacity = {32 * KB, 1 * MB, 32 * MB, SIZE_MAX};
+    calibration.working_set = {16 * KB, 256 * KB, 4 * MB, 64 * MB};
+    calibration.latency_ns = {1, 5, 25, 125};
+    calibration.bandwidth = {1, 0.5, 1 / 3.0, 0.25};
+    calibration.stream_bandwidth = {0.5, 0.5, 0.25, 0.125};
+    calibration.dram_peak_bandwidth = 0.5;
+    calibration.hardware_threads = 8;
+    calibration.thread_start_ns = 10000;
+    return calibration;
+}
+
+} // namespace
+
+TEST(CopyCostTest, InterpolatesBetweenTiers) {
+    const auto calibration = fixed_calibration();
+    // Source and destination together at a measured working set
+    EXPECT_DOUBLE_EQ(1 + 8 * KB, omm::estimate_copy_ns(8 * KB, {}, 1, calibration));
+    EXPECT_DOUBLE_EQ(5 + 2 * 128 * KB, omm::estimate_copy_ns(128 * KB, {}, 1, calibration));
+    // Halfway between two working sets on a log scale
+    EXPECT_DOUBLE_EQ(3 + 1.5 * 32 * KB, omm::estimate_copy_ns(32 * KB, {}, 1, calibration));
+    EXPECT_DOUBLE_EQ(15 + 2.5 * 512 * KB, omm::estimate_copy_ns(512 * KB, {}, 1, calibration));
+    // Held beyond the first and last
+    EXPECT_DOUBLE_EQ(1 + 64, omm::estimate_copy_ns(64, {}, 1, calibration));
+    EXPECT_DOUBLE_EQ(125 + 4.0 * 1024 * MB, omm::estimate_copy_ns(1024 * MB, {omm::copy_kernel::temporal, false}, 1, calibration));
+    EXPECT_EQ(0, omm::estimate_copy_ns(0, {}, 4, calibration));
+}
+
+TEST(CopyCostTest, FollowsKernelAndSourceHints) {
+    const auto calibration = fixed_calibration();
+    const omm::copy_hints temporal{omm::copy_kernel::temporal, false};
+    const omm::copy_hints streaming{omm::copy_kernel::streaming, false};
+    const omm::copy_hints cold{omm::copy_kernel::automatic, true};
+
+    // omm::memcpy streams from the L3 size on
+    EXPECT_DOUBLE_EQ(75 + 3.5 * 8 * MB, omm::estimate_copy_ns(8 * MB, {}, 1, calibration));
+    EXPECT_DOUBLE_EQ(omm::estimate_copy_ns(8 * MB, temporal, 1, calibration), omm::estimate_copy_ns(8 * MB, {}, 1, calibration));
+    EXPECT_DOUBLE_EQ(125 + 4.0 * 32 * MB, omm::estimate_copy_ns(32 * MB, temporal, 1, calibration));
+    EXPECT_DOUBLE_EQ(125 + 8.0 * 32 * MB, omm::estimate_copy_ns(32 * MB, {}, 1, calibration));
+    EXPECT_DOUBLE_EQ(1 + 2.0 * 8 * KB, omm::estimate_copy_ns(8 * KB, streaming, 1, calibration));
+    // A cold source is read at the DRAM point whatever its size
+    EXPECT_DOUBLE_EQ(125 + 4.0 * 8 * KB, omm::estimate_copy_ns(8 * KB, cold, 1, calibration));
+}
+
+TEST(CopyCostTest, ScalesThreadsUpToDramPeak) {
+    const auto calibration = fixed_calibration();
+    // Cache-resident copies scale with every thread
+    EXPECT_DOUBLE_EQ(25 + 3.0 * 2 * MB / 4 + 3 * 10000, omm::estimate_copy_ns(2 * MB, {}, 4, calibration));
+    // Copies reaching DRAM stop scaling at the DRAM peak
+    EXPECT_DOUBLE_EQ(125 + 256.0 * MB / 0.25 + 10000, omm::estimate_copy_ns(256 * MB, {}, 2, calibration));
+    EXPECT_DOUBLE_EQ(125 + 256.0 * MB / 0.5 + 7 * 10000, omm::estimate_copy_ns(256 * MB, {}, 8, calibration));
+    // Threads beyond the host's only add start costs
+    EXPECT_DOUBLE_EQ(25 + 3.0 * 2 * MB / 8 + 15 * 10000, omm::estimate_copy_ns(2 * MB, {}, 16, calibration));
+    // Thread start costs outweigh splitting small copies
+    EXPECT_LT(omm::estimate_copy_ns(4 * KB, {}, 1, calibration), omm::estimate_copy_ns(4 * KB, {}, 2, calibration));
+    EXPECT_DOUBLE_EQ(omm::estimate_copy_ns(64 * KB, {}, 1, calibration), omm::estimate_copy_ns(64 * KB, {}, 0, calibration));
+}
+
+TEST(CopyCostTest, CalibratesThisHost) {
+    const auto& calibration = omm::detail::host_copy_calibration();
+    EXPECT_EQ(G_L1_CACHE_SIZE, calibration.capacity[0]);
+    EXPECT_EQ(G_L3_CACHE_SIZE, calibration.capacity[2]);
+    for (std::size_t tier = 0; tier < omm::MEMORY_TIERS; ++tier) {
+        EXPECT_TRUE(std::isfinite(calibration.latency_ns[tier]) && calibration.latency_ns[tier] > 0) << "tier " << tier;
+        EXPECT_TRUE(std::isfinite(calibration.bandwidth[tier]) && calibration.bandwidth[tier] > 0) << "tier " << tier;
+        EXPECT_TRUE(std::isfinite(calibration.stream_bandwidth[tier]) && calibration.stream_bandwidth[tier] > 0) << "tier " << tier;
+    }
+    // DRAM is slower to reach than the L1
+    EXPECT_GT(calibration.latency_ns[3], calibration.latency_ns[0]);
+    EXPECT_GE(calibration.dram_peak_bandwidth, calibration.stream_bandwidth[3]);
+    EXPECT_GE(calibration.hardware_threads, 1u);
+    EXPECT_GT(calibration.thread_start_ns, 0);
+
+    // Estimates grow with the size
+    double previous = 0;
+    for (std::size_t n = 64; n <= 1024 * MB; n *= 4) {
+        const double estimate = omm::estimate_copy_ns(n);
+        EXPECT_GT(estimate, previous) << n << " bytes";
+        previous = estimate;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <coroutine>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "omm/copy_job.h"
+
+class CopyJobTest : public ::testing::Test {
+protected:
+    std::mt19937 gen{42};  // Fixed seed for reproducibility
+
+    std::vector<char> generate_random_data(size_t size) {
+        std::vector<char> data(size);
+        std::uniform_int_distribution<> dis(0, 255);
+        std::generate(data.begin(), data.end(), [&]() { return static_cast<char>(dis(gen)); });
+        return data;
+    }
+};
+
+TEST_F(CopyJobTest, ByteStepsCopyEverything) {
+    for (size_t size : {0, 1, 100, 4096, (1 << 20) + 17}) {
+        for (size_t step : {1, 63, 1000, 65536}) {
+            SCOPED_TRACE("Size: " + std::to_string(size) + ", step: " + std::to_string(step));
+            auto src = generate_random_data(size + 8);
+            std::vector<char> dest(size + 8, 0);
+
+            omm::copy_job job(dest.data() + 5, src.data() + 1, size, 4096 + 3);
+            size_t steps = 0;
+            size_t previous = 0;
+            while (!job.step(step)) {
+                ASSERT_GT(job.copied(), previous) << "Job made no progress";
+                ASSERT_LE(job.copied() - previous, step) << "Step copied more than requested";
+                previous = job.copied();
+                ++steps;
+            }
+
+            EXPECT_TRUE(job.done());
+            EXPECT_EQ(size, job.copied());
+            EXPECT_DOUBLE_EQ(1.0, job.progress());
+            EXPECT_GE(steps + 1, size / step);
+            EXPECT_EQ(0, std::memcmp(dest.data() + 5, src.data() + 1, size));
+            EXPECT_EQ(0, dest[5 + size]) << "Overflow detected in destination";
+        }
+    }
+}
+
+TEST_F(CopyJobTest, TimeSlicesProgressAndComplete) {
+    constexpr size_t size = 32 * 1024 * 1024 + 3;
+    auto src = generate_random_data(size);
+    std::vector<char> dest(size, 0);
+
+    omm::copy_job job(dest.data(), src.data(), size);
+    size_t slices = 0;
+    while (!job.step(std::chrono::microseconds(50))) {
+        ++slices;
+        ASSERT_GT(job.progress(), 0.0);
+        ASSERT_LT(job.progress(), 1.0);
+    }
+
+    EXPECT_GT(slices, 1u) << "A 32 MiB copy should not fit in one 50us slice";
+    EXPECT_EQ(0, std::memcmp(dest.data(), src.data(), size));
+}
+
+TEST_F(CopyJobTest, ZeroBudgetStillProgresses) {
+    constexpr size_t size = 1 << 20;
+    auto src = generate_random_data(size);
+    std::vector<char> dest(size, 0);
+
+    omm::copy_job job(dest.data(), src.data(), size);
+    EXPECT_FALSE(job.step(std::chrono::nanoseconds(0)));
+    EXPECT_GT(job.copied(), 0u);
+    EXPECT_FALSE(job.step(size_t{0}));
+
+    // A negative budget copies one granule rather than wrapping to an unbounded deadline
+    const size_t before = job.copied();
+    EXPECT_FALSE(job.step(std::chrono::nanoseconds(-1000)));
+    EXPECT_GT(job.copied(), before);
+    EXPECT_LE(job.copied(), before + omm::copy_job::DEFAULT_GRANULE);
+}
+
+// Minimal round-robin scheduler to drive copy jobs from coroutines
+namespace {
+
+struct task {
+    struct promise_type {
+        task get_return_object() { return {std::coroutine_handle<promise_type>::from_promise(*this)}; }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+struct scheduler {
+    std::deque<std::coroutine_handle<>> ready;
+
+    auto yield() {
+        struct awaiter {
+            scheduler& owner;
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { owner.ready.push_back(h); }
+            void await_resume() const noexcept {}
+        };
+        return awaiter{*this};
+    }
+
+    void run() {
+        while (!ready.empty()) {
+            auto h = ready.front();
+            ready.pop_front();
+            h.resume();
+        }
+    }
+};
+
+task copy_in_background(scheduler& sched, omm::copy_job& job, size_t& slices) {
+    while (!job.step(std::chrono::microseconds(20))) {
+        ++slices;
+        co_await sched.yield();
+    }
+}
+
+} // namespace
+
+TEST_F(CopyJobTest, InterleavesWithCoroutines) {
+    constexpr size_t size = 8 * 1024 * 1024;
+    auto src_a = generate_random_data(size);
+    auto src_b = generate_random_data(size);
+    std::vector<char> dest_a(size, 0), dest_b(size, 0);
+
+    omm::copy_job job_a(dest_a.data(), src_a.data(), size);
+    omm::copy_job job_b(dest_b.data(), src_b.data(), size);
+    size_t slices_a = 0, slices_b = 0;
+
+    scheduler sched;
+    task a = copy_in_background(sched, job_a, slices_a);
+    task b = copy_in_background(sched, job_b, slices_b);
+    sched.ready.push_back(a.handle);
+    sched.ready.push_back(b.handle);
+    sched.run();
+
+    EXPECT_TRUE(a.handle.done());
+    EXPECT_TRUE(b.handle.done());
+    EXPECT_GT(slices_a, 0u);
+    EXPECT_GT(slices_b, 0u);
+    EXPECT_EQ(0, std::memcmp(dest_a.data(), src_a.data(), size));
+    EXPECT_EQ(0, std::memcmp(dest_b.data(), src_b.data(), size));
+
+    a.handle.destroy();
+    b.handle.destroy();
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <numeric>
+#include <span>
+#include "omm/copy.h"
+
+using MemcpyFunc = void *(*)(void*, const void*, std::size_t);
+
+struct alignas(64) Line {
+    std::uint32_t values[16];
+};
+
+struct alignas(32) Pair {
+    double a;
+    double b;
+};
+
+struct Packed {
+    char bytes[7];
+};
+
+template <typename T>
+std::vector<T> make_objects(size_t count) {
+    std::vector<T> objects(count);
+    auto* bytes = reinterpret_cast<unsigned char*>(objects.data());
+    for (size_t i = 0; i < count * sizeof(T); ++i) {
+        bytes[i] = static_cast<unsigned char>(i * 31 + 7);
+    }
+    return objects;
+}
+
+template <typename T>
+class CopyTest : public ::testing::Test {};
+
+using CopyTypes = ::testing::Types<char, std::uint64_t, Packed, Pair, Line>;
+TYPED_TEST_SUITE(CopyTest, CopyTypes);
+
+// Test element counts on both sides of the streaming threshold
+TYPED_TEST(CopyTest, SpanCopy) {
+    for (size_t bytes : {size_t{0}, size_t{sizeof(TypeParam)}, size_t{4096}, size_t{G_L3_CACHE_SIZE} + 4096}) {
+        const size_t count = bytes / sizeof(TypeParam);
+        SCOPED_TRACE("Count: " + std::to_string(count));
+
+        auto src = make_objects<TypeParam>(count);
+        std::vector<TypeParam> dest(count + 1);
+        std::memset(static_cast<void*>(dest.data()), 0, dest.size() * sizeof(TypeParam));
+
+        TypeParam* end = omm::copy(std::span<const TypeParam>(src), std::span<TypeParam>(dest));
+
+        EXPECT_EQ(dest.data() + count, end);
+        EXPECT_EQ(0, std::memcmp(src.data(), dest.data(), count * sizeof(TypeParam)));
+        const auto* guard = reinterpret_cast<const unsigned char*>(dest.data() + count);
+        EXPECT_TRUE(std::all_of(guard, guard + sizeof(TypeParam), [](unsigned char c) { return c == 0; }))
+                << "Overflow detected in destination";
+    }
+}
+
+TYPED_TEST(CopyTest, CopyN) {
+    const size_t count = 1000;
+    auto src = make_objects<TypeParam>(count);
+    std::vector<TypeParam> dest(count);
+
+    TypeParam* end = omm::copy_n(src.data(), count, dest.data());
+
+    EXPECT_EQ(dest.data() + count, end);
+    EXPECT_EQ(0, std::memcmp(src.data(), dest.data(), count * sizeof(TypeParam)));
+}
+
+TEST(CopyRangesTest, ContiguousRanges) {
+    std::vector<int> src(10000);
+    std::iota(src.begin(), src.end(), 0);
+    std::array<int, 10000> dest{};
+
+    int* end = omm::copy(src, dest);
+
+    EXPECT_EQ(dest.data() + dest.size(), end);
+    EXPECT_TRUE(std::equal(src.begin(), src.end(), dest.begin()));
+}
+
+TEST(CopyRangesTest, ShortDestinationTakesTheFront) {
+    std::vector<int> src(1000);
+    std::iota(src.begin(), src.end(), 0);
+    std::vector<int> storage(700 + 1, -1);
+
+    // Only the first 700 objects fit; the guard past them stays untouched
+    int* end = omm::copy(std::span<const int>(src), std::span<int>(storage.data(), 700));
+    EXPECT_EQ(storage.data() + 700, end);
+    EXPECT_TRUE(std::equal(src.begin(), src.begin() + 700, storage.begin()));
+    EXPECT_EQ(-1, storage[700]);
+
+    // Ranges go through the same overload
+    std::array<int, 10> small{};
+    EXPECT_EQ(small.data() + small.size(), omm::copy(src, small));
+    EXPECT_TRUE(std::equal(small.begin(), small.end(), src.begin()));
+}
+
+// The aligned kernels skip the prologue, so exercise them directly on aligned buffers
+class AlignedMemcpyTest : public ::testing::TestWithParam<std::tuple<MemcpyFunc, size_t, const char*>> {};
+
+TEST_P(AlignedMemcpyTest, AlignedDestination) {
+    auto [memcpy_func, alignment, func_name] = GetParam();
+
+    for (size_t size : {size_t{G_L3_CACHE_SIZE}, size_t{G_L3_CACHE_SIZE} + 64 * 3, size_t{G_L3_CACHE_SIZE} + 1023}) {
+        SCOPED_TRACE("Size: " + std::to_string(size));
+        auto src = make_objects<char>(size + 8);
+        std::vector<char> buffer(size + 2 * alignment, 0);
+        char* dest = buffer.data() + ((alignment - (reinterpret_cast<std::uintptr_t>(buffer.data()) & (alignment - 1))) & (alignment - 1));
+
+        // Source alignment is not guaranteed by the aligned kernels
+        memcpy_func(dest, src.data() + 3, size);
+
+        EXPECT_EQ(0, std::memcmp(dest, src.data() + 3, size)) << func_name;
+        EXPECT_EQ(0, dest[size]) << "Overflow detected in destination";
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        AlignedMemcpyTests,
+        AlignedMemcpyTest,
+        ::testing::Values(
+                std::make_tuple(omm::memcpy_avx2_aligned, size_t{32}, "omm::memcpy_avx2_aligned")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        AlignedMemcpyTestsAVX512,
+        AlignedMemcpyTest,
+        ::testing::Values(
+                std::make_tuple(omm::memcpy_avx512_aligned, size_t{64}, "omm::memcpy_avx512_aligned")
+        )
+);
+#endif
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,203 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include "omm/epoch.h"
+#include "omm/detail/memory/block_pool.h"
+
+namespace {
+
+// Records every batch handed to it
+struct Recorder {
+    std::vector<omm::epoch::block> blocks;
+    std::vector<std::size_t> batches;
+
+    static void reclaim(const omm::epoch::block* blocks, std::size_t count, void* context) {
+        auto* self = static_cast<Recorder*>(context);
+        self->blocks.insert(self->blocks.end(), blocks, blocks + count);
+        self->batches.push_back(count);
+    }
+};
+
+void* tag(std::uintptr_t i) { return reinterpret_cast<void*>(i * 64); }
+
+} // namespace
+
+TEST(EpochTest, ReclaimsAfterTwoEpochs) {
+    Recorder recorder;
+    omm::epoch domain(Recorder::reclaim, &recorder);
+    EXPECT_EQ(0u, domain.current());
+
+    domain.retire(tag(1), 100);
+    EXPECT_EQ(1u, domain.pending());
+    EXPECT_EQ(1u, domain.reclaim());
+    EXPECT_EQ(2u, domain.current());
+    ASSERT_EQ(1u, recorder.blocks.size());
+    EXPECT_EQ(tag(1), recorder.blocks[0].pointer);
+    EXPECT_EQ(100u, recorder.blocks[0].size);
+    EXPECT_EQ(0u, domain.pending());
+}
+
+TEST(EpochTest, PinnedSectionHoldsBackReclamation) {
+    Recorder recorder;
+    omm::epoch domain(Recorder::reclaim, &recorder);
+    {
+        auto guard = domain.pin();
+        EXPECT_EQ(0u, guard.pinned_epoch());
+        domain.retire(tag(1));
+
+        // The epoch can advance once past the section, but not twice
+        domain.reclaim();
+        EXPECT_EQ(1u, domain.current());
+        EXPECT_TRUE(recorder.blocks.empty());
+
+        // Nested pins are counted separately
+        auto inner = domain.pin();
+        EXPECT_EQ(1u, inner.pinned_epoch());
+    }
+    EXPECT_EQ(1u, domain.reclaim());
+    ASSERT_EQ(1u, recorder.blocks.size());
+}
+
+TEST(EpochTest, SynchronizeWaitsForReaders) {
+    Recorder recorder;
+    omm::epoch domain(Recorder::reclaim, &recorder);
+    std::atomic<bool> pinned{false};
+    std::atomic<bool> release{false};
+
+    std::thread reader([&] {
+        auto guard = domain.pin();
+        pinned = true;
+        while (!release) std::this_thread::yield();
+    });
+    while (!pinned) std::this_thread::yield();
+    domain.retire(tag(7));
+
+    std::atomic<bool> done{false};
+    std::thread writer([&] {
+        domain.synchronize();
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(done.load()) << "synchronize returned while a reader was pinned";
+    EXPECT_TRUE(recorder.blocks.empty());
+
+    release = true;
+    reader.join();
+    writer.join();
+    ASSERT_EQ(1u, recorder.blocks.size());
+    EXPECT_EQ(tag(7), recorder.blocks[0].pointer);
+}
+
+TEST(EpochTest, ReclaimsInBatches) {
+    Recorder recorder;
+    omm::epoch domain(Recorder::reclaim, &recorder, 16);
+
+    // Each full batch advances the epoch once, freeing what was retired two batches ago
+    for (std::uintptr_t i = 1; i <= 160; ++i) domain.retire(tag(i));
+    EXPECT_FALSE(recorder.batches.empty());
+    for (std::size_t count : recorder.batches) EXPECT_GE(count, 16u);
+    for (std::size_t i = 0; i < recorder.blocks.size(); ++i) {
+        ASSERT_EQ(tag(i + 1), recorder.blocks[i].pointer) << "Blocks are reclaimed in retirement order";
+    }
+    EXPECT_EQ(160u, recorder.blocks.size() + domain.pending());
+}
+
+TEST(EpochTest, DestructorReclaimsEverything) {
+    Recorder recorder;
+    {
+        omm::epoch domain(Recorder::reclaim, &recorder);
+        for (std::uintptr_t i = 1; i <= 10; ++i) domain.retire(tag(i));
+        auto guard = domain.pin();
+    }
+    EXPECT_EQ(10u, recorder.blocks.size());
+}
+
+TEST(EpochTest, BuiltInReclaimFunctions) {
+    {
+        omm::epoch domain;
+        domain.retire(std::malloc(64));
+        domain.synchronize();
+        EXPECT_EQ(0u, domain.pending());
+    }
+    {
+        omm::epoch domain(omm::epoch::unmap_blocks);
+        const std::size_t size = 1 << 16;
+        void* mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        ASSERT_NE(MAP_FAILED, mapping);
+        domain.retire(mapping, size);
+        domain.synchronize();
+        EXPECT_EQ(0u, domain.pending());
+    }
+    {
+        omm::detail::block_pool pool(4096);
+        void* block = pool.allocate();
+        {
+            omm::epoch domain(omm::epoch::deallocate_blocks<omm::detail::block_pool>, &pool);
+            domain.retire(block);
+        }
+        // The reclaimed block went back on the pool's free list
+        EXPECT_EQ(block, pool.allocate());
+    }
+}
+
+// Readers follow a shared pointer while writers replace and retire it; a reclaimed node is
+// poisoned before it is freed, so a reader reaching one would see the poison
+TEST(EpochTest, ConcurrentReadersNeverSeeReclaimedNodes) {
+    struct node {
+        std::atomic<std::uint64_t> value;
+    };
+    constexpr std::uint64_t POISON = 0xDEADDEADDEADDEAD;
+    const auto reclaim = [](const omm::epoch::block* blocks, std::size_t count, void*) {
+        for (std::size_t i = 0; i < count; ++i) {
+            auto* n = static_cast<node*>(blocks[i].pointer);
+            n->value.store(POISON, std::memory_order_relaxed);
+            delete n;
+        }
+    };
+
+    omm::epoch domain(reclaim, nullptr, 8);
+    std::atomic<node*> head{new node{{1}}};
+    std::atomic<bool> stop{false};
+    std::atomic<std::size_t> poisoned{0};
+    std::atomic<std::size_t> reads{0};
+
+    std::vector<std::thread> threads;
+    for (int r = 0; r < 3; ++r) {
+        threads.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto guard = domain.pin();
+                const node* n = head.load(std::memory_order_acquire);
+                if (n->value.load(std::memory_order_relaxed) == POISON) poisoned.fetch_add(1);
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (int w = 0; w < 2; ++w) {
+        threads.emplace_back([&] {
+            std::uint64_t value = 2;
+            while (!stop.load(std::memory_order_relaxed)) {
+                node* old = head.exchange(new node{{value++}}, std::memory_order_acq_rel);
+                domain.retire(old, sizeof(node));
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    stop = true;
+    for (auto& thread : threads) thread.join();
+    delete head.load();
+
+    EXPECT_EQ(0u, poisoned.load());
+    EXPECT_GT(reads.load(), 0u);
+    EXPECT_GT(domain.current(), 2u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include "omm/fill.h"
+
+using FillPatternFunc = void (*)(void*, std::size_t, const void*, std::size_t);
+
+class FillPatternTest : public ::testing::TestWithParam<std::pair<FillPatternFunc, const char*>> {
+protected:
+    // Fills size bytes at the given destination offset and verifies contents and guard bytes
+    static void check_fill(FillPatternFunc fill_func, const char* func_name, size_t size, size_t period, size_t offset) {
+        std::vector<unsigned char> pattern(period);
+        std::iota(pattern.begin(), pattern.end(), static_cast<unsigned char>(period * 3 + 1));
+        std::vector<unsigned char> dest(size + offset + 64, 0xEE);
+
+        fill_func(dest.data() + offset, size, pattern.data(), period);
+
+        for (size_t i = 0; i < size; ++i) {
+            if (dest[offset + i] != pattern[i % period]) {
+                ADD_FAILURE() << func_name << ": mismatch at byte " << i << " for size " << size
+                              << ", period " << period << ", offset " << offset;
+                return;
+            }
+        }
+        EXPECT_EQ(0xEE, dest[offset + size]) << "Overflow detected in destination";
+        if (offset > 0) {
+            EXPECT_EQ(0xEE, dest[offset - 1]) << "Underflow detected in destination";
+        }
+    }
+};
+
+TEST_P(FillPatternTest, AllSmallPeriods) {
+    auto [fill_func, func_name] = GetParam();
+
+    for (size_t period = 1; period <= 130; ++period) {
+        for (size_t size : {0, 1, 63, 64, 65, 1000, 4099}) {
+            check_fill(fill_func, func_name, size, period, period % 13);
+        }
+    }
+}
+
+TEST_P(FillPatternTest, LongPeriods) {
+    auto [fill_func, func_name] = GetParam();
+
+    for (size_t period : {1000, 4095, 4096}) {
+        check_fill(fill_func, func_name, 3 * period + 17, period, 5);
+    }
+}
+
+// Sizes beyond the L3 threshold take the aligned streaming path
+TEST_P(FillPatternTest, StreamingSizes) {
+    auto [fill_func, func_name] = GetParam();
+
+    for (size_t period : {2, 8, 16, 24, 100}) {
+        for (size_t offset : {0, 3, 40}) {
+            check_fill(fill_func, func_name, G_L3_CACHE_SIZE + 1023, period, offset);
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        FillPatternTests,
+        FillPatternTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::fill_pattern_generic, "generic"),
+                std::make_pair(omm::fill_pattern_avx2, "omm::fill_pattern_avx2"),
+                std::make_pair(static_cast<FillPatternFunc>(omm::fill_pattern), "omm::fill_pattern")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        FillPatternTestsAVX512,
+        FillPatternTest,
+        ::testing::Values(
+                std::make_pair(omm::fill_pattern_avx512, "omm::fill_pattern_avx512")
+        )
+);
+#endif
+
+TEST(FillTest, TypedFills) {
+    constexpr size_t count = 1001;
+
+    std::vector<std::uint16_t> values16(count + 1, 0);
+    omm::fill16(values16.data(), 0xBEEF, count);
+    EXPECT_EQ(count, static_cast<size_t>(std::count(values16.begin(), values16.end(), 0xBEEF)));
+
+    std::vector<std::uint32_t> values32(count + 1, 0);
+    omm::fill32(values32.data(), 0xDEADBEEF, count);
+    EXPECT_EQ(count, static_cast<size_t>(std::count(values32.begin(), values32.end(), 0xDEADBEEFu)));
+
+    std::vector<std::uint64_t> values64(count + 1, 0);
+    omm::fill64(values64.data(), 0x7FF8000000000001ULL, count);
+    EXPECT_EQ(count, static_cast<size_t>(std::count(values64.begin(), values64.end(), 0x7FF8000000000001ULL)));
+
+    unsigned char block[16];
+    std::iota(std::begin(block), std::end(block), 1);
+    std::vector<unsigned char> values128(count * 16 + 1, 0);
+    omm::fill128(values128.data(), block, count);
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(0, std::memcmp(values128.data() + i * 16, block, 16)) << "Element " << i;
+    }
+    EXPECT_EQ(0, values128[count * 16]);
+}
+
+TEST(FillTest, PeriodBeyondTemplate) {
+    std::vector<unsigned char> pattern(OMM_FILL_MAX_PERIOD + 100);
+    std::iota(pattern.begin(), pattern.end(), 0);
+    std::vector<unsigned char> dest(pattern.size() * 2 + 10);
+
+    omm::fill_pattern(dest.data(), dest.size(), pattern.data(), pattern.size());
+
+    for (size_t i = 0; i < dest.size(); ++i) {
+        ASSERT_EQ(pattern[i % pattern.size()], dest[i]) << "Byte " << i;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "omm/gather_rows.h"
+
+namespace {
+
+template <typename Index>
+using Kernel = std::pair<omm::detail::RowsFunc<Index>, std::string>;
+
+// Every gather kernel for the width this CPU can run, with its name
+template <std::size_t Width, typename Index>
+std::vector<Kernel<Index>> gather_kernels() {
+    std::vector<Kernel<Index>> result = {
+            {omm::detail::gather_rows_generic<Width, Index>, "gather_rows_generic"},
+            {omm::gather_rows_avx2<Width, Index>, "omm::gather_rows_avx2"}};
+#ifdef __AVX512F__
+    result.emplace_back(omm::gather_rows_avx512<Width, Index>, "omm::gather_rows_avx512");
+#endif
+    return result;
+}
+
+template <std::size_t Width, typename Index>
+std::vector<Kernel<Index>> scatter_kernels() {
+    std::vector<Kernel<Index>> result = {
+            {omm::detail::scatter_rows_generic<Width, Index>, "scatter_rows_generic"},
+            {omm::scatter_rows_avx2<Width, Index>, "omm::scatter_rows_avx2"}};
+#ifdef __AVX512F__
+    result.emplace_back(omm::scatter_rows_avx512<Width, Index>, "omm::scatter_rows_avx512");
+#endif
+    return result;
+}
+
+// A table whose every byte identifies its row and offset
+std::vector<uint8_t> make_table(std::size_t rows, std::size_t row_width) {
+    std::vector<uint8_t> table(rows * row_width);
+    for (std::size_t i = 0; i < table.size(); ++i) table[i] = static_cast<uint8_t>(i * 131 + i / 251);
+    return table;
+}
+
+template <typename Index>
+std::vector<Index> random_indices(std::size_t count, std::size_t rows, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<Index> indices(count);
+    for (auto& index : indices) index = static_cast<Index>(rng() % rows);
+    return indices;
+}
+
+// 64-byte aligned storage for the streaming paths
+struct AlignedBuffer {
+    explicit AlignedBuffer(std::size_t size) : storage(size + 64) {}
+    uint8_t* data() { return storage.data() + (64 - reinterpret_cast<std::uintptr_t>(storage.data()) % 64) % 64; }
+    std::vector<uint8_t> storage;
+};
+
+} // namespace
+
+template <typename Shape>
+class GatherRowsTest : public ::testing::Test {};
+
+template <std::size_t Width, typename Index>
+struct Shape {
+    static constexpr std::size_t WIDTH = Width;
+    using RowIndex = Index;
+};
+
+using Shapes = ::testing::Types<
+        Shape<8, std::uint32_t>, Shape<8, std::int32_t>, Shape<8, std::uint64_t>, Shape<8, std::uint16_t>,
+        Shape<16, std::uint32_t>, Shape<32, std::uint32_t>, Shape<64, std::uint32_t>, Shape<64, std::int64_t>,
+        Shape<128, std::uint32_t>>;
+TYPED_TEST_SUITE(GatherRowsTest, Shapes);
+
+TYPED_TEST(GatherRowsTest, GathersSelectedRows) {
+    constexpr std::size_t W = TypeParam::WIDTH;
+    using Index = typename TypeParam::RowIndex;
+    constexpr std::size_t ROWS = 1000;
+    const auto table = make_table(ROWS, W);
+
+    for (std::size_t count : {0, 1, 7, 8, 9, 17, 24, 25, 100, 1001}) {
+        const auto indices = random_indices<Index>(count, ROWS, count);
+        for (auto [kernel, name] : gather_kernels<W, Index>()) {
+            // Guard rows on either side of an unaligned destination
+            std::vector<uint8_t> dest((count + 2) * W + 1);
+            kernel(dest.data() + W + 1, table.data(), indices.data(), count);
+            for (std::size_t i = 0; i < count; ++i) {
+                ASSERT_EQ(0, std::memcmp(dest.data() + W + 1 + i * W, table.data() + static_cast<std::size_t>(indices[i]) * W, W))
+                        << name << ": row " << i << " of " << count;
+            }
+            for (std::size_t b = 0; b < W + 1; ++b) ASSERT_EQ(0, dest[b]) << name << ": wrote before dest";
+            for (std::size_t b = (count + 1) * W + 1; b < dest.size(); ++b) ASSERT_EQ(0, dest[b]) << name << ": wrote past " << count;
+        }
+    }
+}
+
+TYPED_TEST(GatherRowsTest, ScattersInOrder) {
+    constexpr std::size_t W = TypeParam::WIDTH;
+    using Index = typename TypeParam::RowIndex;
+    constexpr std::size_t ROWS = 300;
+
+    // Repeated indices keep the last row written to them
+    for (std::size_t count : {0, 1, 9, 100, 1001}) {
+        const auto src = make_table(count, W);
+        const auto indices = random_indices<Index>(count, ROWS, count + 1);
+        std::vector<uint8_t> expected(ROWS * W, 0xEE);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::memcpy(expected.data() + static_cast<std::size_t>(indices[i]) * W, src.data() + i * W, W);
+        }
+        for (auto [kernel, name] : scatter_kernels<W, Index>()) {
+            std::vector<uint8_t> table(ROWS * W, 0xEE);
+            kernel(table.data(), src.data(), indices.data(), count);
+            ASSERT_EQ(expected, table) << name << ": " << count << " rows";
+        }
+    }
+}
+
+TEST(GatherRowsAnyWidthTest, CopiesOtherWidths) {
+    for (std::size_t width : {1, 3, 12, 24, 100, 200, 256}) {
+        const auto table = make_table(500, width);
+        const auto indices = random_indices<std::uint32_t>(300, 500, width);
+        std::vector<uint8_t> dest(300 * width);
+        omm::gather_rows(dest.data(), table.data(), width, indices.data(), indices.size());
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            ASSERT_EQ(0, std::memcmp(dest.data() + i * width, table.data() + indices[i] * width, width)) << "width " << width << ", row " << i;
+        }
+
+        std::vector<uint8_t> scattered(500 * width);
+        omm::scatter_rows(scattered.data(), dest.data(), width, indices.data(), indices.size());
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            ASSERT_EQ(0, std::memcmp(scattered.data() + indices[i] * width, table.data() + indices[i] * width, width)) << "width " << width;
+        }
+    }
+}
+
+TEST(GatherRowsStreamTest, StreamsLargeOutputs) {
+    // Outputs past the streaming threshold; gathers start one row off alignment
+    constexpr std::size_t ROWS = 1 << 16;
+    for (std::size_t width : {8, 64}) {
+        const std::size_t count = G_L3_CACHE_SIZE / width + 11;
+        const auto table = make_table(ROWS, width);
+        const auto indices = random_indices<std::uint32_t>(count, ROWS, width);
+
+        AlignedBuffer dest((count + 1) * width);
+        omm::gather_rows(dest.data() + width, table.data(), width, indices.data(), count);
+        for (std::size_t i = 0; i < count; i += 997) {
+            ASSERT_EQ(0, std::memcmp(dest.data() + (i + 1) * width, table.data() + indices[i] * width, width)) << "width " << width << ", row " << i;
+        }
+        ASSERT_EQ(0, std::memcmp(dest.data() + count * width, table.data() + indices[count - 1] * width, width)) << "width " << width;
+    }
+
+    // Scattering whole lines into an aligned table streams them
+    const std::size_t count = G_L3_CACHE_SIZE / 64 + 11;
+    const auto src = make_table(count, 64);
+    std::vector<std::uint32_t> indices(count);
+    for (std::size_t i = 0; i < count; ++i) indices[i] = static_cast<std::uint32_t>((i * 7919) % count);
+    AlignedBuffer table(count * 64);
+    omm::scatter_rows(table.data(), src.data(), 64, indices.data(), count);
+    for (std::size_t i = 0; i < count; i += 997) {
+        ASSERT_EQ(0, std::memcmp(table.data() + indices[i] * 64, src.data() + i * 64, 64)) << "row " << i;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+#include "omm/interleave.h"
+
+namespace {
+
+template <typename T>
+struct Kernels {
+    std::vector<std::pair<omm::detail::InterleaveFunc<T>, std::string>> interleave;
+    std::vector<std::pair<omm::detail::DeinterleaveFunc<T>, std::string>> deinterleave;
+};
+
+// Every kernel for the shape this CPU can run, with its name
+template <std::size_t Channels, typename T>
+Kernels<T> kernels() {
+    Kernels<T> result;
+    result.interleave.emplace_back(omm::interleave_avx2<Channels, T>, "omm::interleave_avx2");
+    result.deinterleave.emplace_back(omm::deinterleave_avx2<Channels, T>, "omm::deinterleave_avx2");
+#ifdef __AVX512F__
+    if (omm::detail::cpu_supports_avx512bw() && (sizeof(T) != 1 || omm::detail::cpu_supports_avx512vbmi())) {
+        result.interleave.emplace_back(omm::interleave_avx512<Channels, T>, "omm::interleave_avx512");
+        result.deinterleave.emplace_back(omm::deinterleave_avx512<Channels, T>, "omm::deinterleave_avx512");
+    }
+#endif
+    result.interleave.emplace_back(omm::interleave<Channels, T>, "omm::interleave");
+    result.deinterleave.emplace_back(omm::deinterleave<Channels, T>, "omm::deinterleave");
+    return result;
+}
+
+// Distinct, nonzero bit patterns per channel and frame
+template <typename T>
+std::vector<std::vector<T>> make_planes(std::size_t channels, std::size_t frames, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::vector<std::vector<T>> planes(channels, std::vector<T>(frames));
+    for (auto& plane : planes) {
+        for (auto& sample : plane) {
+            const std::uint64_t bits = rng() | 1;
+            __builtin_memcpy(&sample, &bits, sizeof(T));
+        }
+    }
+    return planes;
+}
+
+template <typename T>
+bool same_bits(const T& a, const T& b) {
+    return __builtin_memcmp(&a, &b, sizeof(T)) == 0;
+}
+
+} // namespace
+
+template <typename Shape>
+class InterleaveTest : public ::testing::Test {};
+
+template <std::size_t Channels, typename T>
+struct Shape {
+    static constexpr std::size_t CHANNELS = Channels;
+    using Sample = T;
+};
+
+using Shapes = ::testing::Types<
+        Shape<2, std::uint8_t>, Shape<3, std::uint8_t>, Shape<4, std::uint8_t>, Shape<5, std::uint8_t>,
+        Shape<6, std::uint8_t>, Shape<7, std::uint8_t>, Shape<8, std::uint8_t>,
+        Shape<2, std::int16_t>, Shape<3, std::int16_t>, Shape<4, std::int16_t>, Shape<5, std::int16_t>,
+        Shape<6, std::int16_t>, Shape<7, std::int16_t>, Shape<8, std::int16_t>,
+        Shape<2, float>, Shape<3, float>, Shape<4, float>, Shape<5, float>,
+        Shape<6, float>, Shape<7, float>, Shape<8, float>>;
+TYPED_TEST_SUITE(InterleaveTest, Shapes);
+
+TYPED_TEST(InterleaveTest, MatchesScalarAtEverySize) {
+    constexpr std::size_t C = TypeParam::CHANNELS;
+    using T = typename TypeParam::Sample;
+    const auto all = kernels<C, T>();
+
+    // Every size through a few blocks of the widest kernel, then one uneven larger size
+    std::vector<std::size_t> sizes;
+    for (std::size_t frames = 0; frames <= 200; ++frames) sizes.push_back(frames);
+    sizes.push_back(4099);
+
+    for (std::size_t frames : sizes) {
+        const auto planes = make_planes<T>(C, frames, frames);
+        const T* sources[C];
+        for (std::size_t c = 0; c < C; ++c) sources[c] = planes[c].data();
+
+        std::vector<T> expected(frames * C);
+        omm::detail::interleave_generic<C>(expected.data(), sources, frames);
+
+        for (auto [kernel, name] : all.interleave) {
+            // One guard sample on either side of an unaligned destination
+            std::vector<T> dest(frames * C + 3);
+            kernel(dest.data() + 1, sources, frames);
+            for (std::size_t i = 0; i < frames * C; ++i) {
+                ASSERT_TRUE(same_bits(expected[i], dest[i + 1])) << name << ": sample " << i << " of " << frames << " frames";
+            }
+            ASSERT_TRUE(same_bits(T{}, dest[0])) << name << ": wrote before dest";
+            ASSERT_TRUE(same_bits(T{}, dest[frames * C + 1])) << name << ": wrote past " << frames << " frames";
+        }
+
+        for (auto [kernel, name] : all.deinterleave) {
+            std::vector<std::vector<T>> out(C, std::vector<T>(frames + 1));
+            T* targets[C];
+            for (std::size_t c = 0; c < C; ++c) targets[c] = out[c].data();
+            kernel(targets, expected.data(), frames);
+            for (std::size_t c = 0; c < C; ++c) {
+                for (std::size_t i = 0; i < frames; ++i) {
+                    ASSERT_TRUE(same_bits(planes[c][i], out[c][i])) << name << ": channel " << c << ", frame " << i << " of " << frames;
+                }
+                ASSERT_TRUE(same_bits(T{}, out[c][frames])) << name << ": wrote past " << frames << " frames";
+            }
+        }
+    }
+}
+
+TEST(InterleaveStreamTest, StreamsLargeOutputs) {
+    // Outputs past the streaming threshold, unaligned so the prologue has to reach alignment
+    constexpr std::size_t C = 3;
+    const std::size_t frames = G_L3_CACHE_SIZE / (C * sizeof(std::int16_t)) + 1001;
+    const auto planes = make_planes<std::int16_t>(C, frames, 5);
+    const std::int16_t* sources[C] = {planes[0].data(), planes[1].data(), planes[2].data()};
+
+    const auto all = kernels<C, std::int16_t>();
+    for (std::size_t k = 0; k < all.interleave.size(); ++k) {
+        std::vector<std::int16_t> packed(frames * C + 1);
+        all.interleave[k].first(packed.data() + 1, sources, frames);
+        for (std::size_t i = 0; i < frames; i += 997) {
+            for (std::size_t c = 0; c < C; ++c) {
+                ASSERT_EQ(planes[c][i], packed[1 + i * C + c]) << all.interleave[k].second << ": frame " << i;
+            }
+        }
+        ASSERT_EQ(planes[C - 1][frames - 1], packed[frames * C]) << all.interleave[k].second;
+
+        // Planes offset alike stream; planes offset differently fall back to regular stores
+        for (std::size_t skew : {0, 1}) {
+            std::vector<std::vector<std::int16_t>> out(C, std::vector<std::int16_t>(frames + 2));
+            std::int16_t* targets[C] = {out[0].data() + 1, out[1].data() + 1, out[2].data() + 1 + skew};
+            all.deinterleave[k].first(targets, packed.data() + 1, frames);
+            for (std::size_t c = 0; c < C; ++c) {
+                for (std::size_t i = 0; i < frames; i += 997) {
+                    ASSERT_EQ(planes[c][i], targets[c][i]) << all.deinterleave[k].second << ": channel " << c << ", frame " << i;
+                }
+                ASSERT_EQ(planes[c][frames - 1], targets[c][frames - 1]) << all.deinterleave[k].second;
+            }
+        }
+    }
+}
+
+TEST(InterleaveStreamTest, AcceptsMutablePlanes) {
+    std::vector<float> left = {1, 2, 3};
+    std::vector<float> right = {-1, -2, -3};
+    float* planes[2] = {left.data(), right.data()};
+
+    std::vector<float> packed(6);
+    omm::interleave<2>(packed.data(), planes, 3);
+    EXPECT_EQ((std::vector<float>{1, -1, 2, -2, 3, -3}), packed);
+
+    std::fill(left.begin(), left.end(), 0.0f);
+    omm::deinterleave<2>(planes, packed.data(), 3);
+    EXPECT_EQ((std::vector<float>{1, 2, 3}), left);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "omm/iobuf.h"
+
+namespace {
+
+std::vector<std::uint8_t> random_bytes(size_t size, unsigned seed) {
+    std::mt19937 gen{seed};
+    std::uniform_int_distribution<> dis(0, 255);
+    std::vector<std::uint8_t> bytes(size);
+    std::generate(bytes.begin(), bytes.end(), [&]() { return static_cast<std::uint8_t>(dis(gen)); });
+    return bytes;
+}
+
+std::vector<std::uint8_t> contents(const omm::iobuf& buf) {
+    std::vector<std::uint8_t> out(buf.size());
+    EXPECT_EQ(buf.size(), buf.copy_to(out.data()));
+    return out;
+}
+
+std::string as_string(const omm::iobuf& buf) {
+    const auto bytes = contents(buf);
+    return std::string(bytes.begin(), bytes.end());
+}
+
+} // namespace
+
+TEST(IobufTest, EmptyBuffer) {
+    omm::iobuf buf;
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(0u, buf.size());
+    EXPECT_EQ(0u, buf.segment_count());
+    EXPECT_EQ(nullptr, buf.coalesce());
+    EXPECT_TRUE(buf.iovecs().empty());
+}
+
+TEST(IobufTest, AppendFillsTailRoom) {
+    omm::iobuf buf("hello", 5);
+    buf.append(" ", 1);
+    buf.append("world", 5);
+    EXPECT_EQ(1u, buf.segment_count());
+    EXPECT_EQ("hello world", as_string(buf));
+
+    // A shared block is never written again, so appends start a new block
+    omm::iobuf copy = buf;
+    buf.append("!", 1);
+    EXPECT_EQ(2u, buf.segment_count());
+    EXPECT_EQ("hello world!", as_string(buf));
+    EXPECT_EQ("hello world", as_string(copy));
+}
+
+TEST(IobufTest, LargeAppendsSpanBlocks) {
+    for (size_t size : {omm::detail::IOBUF_BLOCK_SIZE, 3 * omm::detail::HUGE_PAGE_SIZE + 17}) {
+        SCOPED_TRACE("Size: " + std::to_string(size));
+        const auto bytes = random_bytes(size, 1);
+        omm::iobuf buf;
+        buf.append(bytes.data(), 100);
+        buf.append(bytes.data() + 100, size - 100);
+        EXPECT_EQ(size, buf.size());
+        EXPECT_EQ(bytes, contents(buf));
+    }
+}
+
+TEST(IobufTest, AppendAndPrependChains) {
+    omm::iobuf buf("middle", 6);
+    buf.append(omm::iobuf("-end", 4));
+    buf.prepend(omm::iobuf("start-", 6));
+    EXPECT_EQ(3u, buf.segment_count());
+    EXPECT_EQ(16u, buf.size());
+    EXPECT_EQ("start-middle-end", as_string(buf));
+
+    // Appending a copy shares its blocks, and both stay valid
+    omm::iobuf twice = buf;
+    twice.append(buf);
+    EXPECT_EQ("start-middle-endstart-middle-end", as_string(twice));
+    EXPECT_EQ("start-middle-end", as_string(buf));
+}
+
+TEST(IobufTest, SliceSharesBlocks) {
+    omm::iobuf buf("abc", 3);
+    buf.append(omm::iobuf("defg", 4));
+    buf.append(omm::iobuf("hij", 3));
+
+    EXPECT_EQ("abcdefghij", as_string(buf.slice(0, 100)));
+    EXPECT_EQ("cdefgh", as_string(buf.slice(2, 6)));
+    EXPECT_EQ("e", as_string(buf.slice(4, 1)));
+    EXPECT_EQ("", as_string(buf.slice(10, 5)));
+    EXPECT_EQ(3u, buf.slice(2, 6).segment_count());
+
+    // The slice keeps its blocks alive after the source is gone
+    omm::iobuf slice = buf.slice(1, 8);
+    buf.clear();
+    EXPECT_EQ("bcdefghi", as_string(slice));
+}
+
+TEST(IobufTest, SplitRemovesPrefix) {
+    omm::iobuf buf("hello", 5);
+    buf.append(omm::iobuf(", world", 7));
+
+    omm::iobuf head = buf.split(3);
+    EXPECT_EQ("hel", as_string(head));
+    EXPECT_EQ("lo, world", as_string(buf));
+
+    omm::iobuf rest = buf.split(2);
+    EXPECT_EQ("lo", as_string(rest));
+    EXPECT_EQ(", world", as_string(buf));
+    EXPECT_EQ(1u, buf.segment_count());
+
+    omm::iobuf all = buf.split(100);
+    EXPECT_EQ(", world", as_string(all));
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(0u, buf.segment_count());
+}
+
+TEST(IobufTest, CoalesceGathersSegments) {
+    for (size_t part : {size_t{1000}, omm::detail::HUGE_PAGE_SIZE}) {
+        SCOPED_TRACE("Part: " + std::to_string(part));
+        const auto bytes = random_bytes(4 * part, 2);
+        omm::iobuf buf;
+        for (size_t i = 0; i < 4; ++i) buf.append(omm::iobuf(bytes.data() + i * part, part));
+        ASSERT_GE(buf.segment_count(), 4u);
+
+        const void* data = buf.coalesce();
+        ASSERT_NE(nullptr, data);
+        EXPECT_EQ(1u, buf.segment_count());
+        EXPECT_EQ(0, std::memcmp(data, bytes.data(), bytes.size()));
+
+        // Already contiguous: no further copy
+        EXPECT_EQ(data, buf.coalesce());
+    }
+}
+
+TEST(IobufTest, IovecsCoverSegmentsInOrder) {
+    omm::iobuf buf("ab", 2);
+    buf.append(omm::iobuf("cde", 3));
+    const auto slices = buf.iovecs();
+    ASSERT_EQ(2u, slices.size());
+    EXPECT_EQ(2u, slices[0].iov_len);
+    EXPECT_EQ(3u, slices[1].iov_len);
+    EXPECT_EQ(0, std::memcmp(slices[0].iov_base, "ab", 2));
+    EXPECT_EQ(0, std::memcmp(slices[1].iov_base, "cde", 3));
+}
+
+TEST(IobufTest, MoveLeavesSourceEmpty) {
+    omm::iobuf buf("payload", 7);
+    omm::iobuf moved = std::move(buf);
+    EXPECT_TRUE(buf.empty());
+    EXPECT_EQ(0u, buf.segment_count());
+    EXPECT_EQ("payload", as_string(moved));
+
+    buf = std::move(moved);
+    EXPECT_EQ("payload", as_string(buf));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "omm/is_zero.h"
+
+using FindNonzeroFunc = std::size_t (*)(const void*, std::size_t);
+using IsZeroFunc = bool (*)(const void*, std::size_t);
+
+class FindNonzeroTest : public ::testing::TestWithParam<std::pair<FindNonzeroFunc, const char*>> {};
+class IsZeroTest : public ::testing::TestWithParam<std::pair<IsZeroFunc, const char*>> {};
+
+TEST_P(FindNonzeroTest, FindsEveryPosition) {
+    auto [find_func, func_name] = GetParam();
+    // Room for the largest size at the largest offset, with non-zero guard bytes around it
+    std::vector<std::uint8_t> buffer(64 + 600 + 64, 0xFF);
+
+    for (size_t size = 0; size <= 600; size += (size < 100 ? 1 : 37)) {
+        for (size_t offset : {0, 1, 31, 63}) {
+            std::uint8_t* data = buffer.data() + 64 + offset;
+            std::memset(data, 0, size);
+            ASSERT_EQ(size, find_func(data, size)) << func_name << ": all zero, size " << size << ", offset " << offset;
+
+            for (size_t pos = 0; pos < size; ++pos) {
+                data[pos] = 0x10;
+                ASSERT_EQ(pos, find_func(data, size)) << func_name << ": size " << size << ", offset " << offset;
+                data[pos] = 0;
+            }
+            std::memset(data, 0xFF, size);
+        }
+    }
+}
+
+TEST_P(FindNonzeroTest, ReturnsFirstOfSeveral) {
+    auto [find_func, func_name] = GetParam();
+    std::vector<std::uint8_t> data(4096, 0);
+    data[3000] = 1;
+    data[1500] = 0x80;
+    data[1501] = 1;
+    EXPECT_EQ(1500u, find_func(data.data(), data.size())) << func_name;
+}
+
+TEST_P(IsZeroTest, DetectsAnySetBit) {
+    auto [zero_func, func_name] = GetParam();
+    std::vector<std::uint8_t> buffer(1024 + 8, 0);
+
+    for (size_t size : {0, 1, 7, 8, 31, 32, 33, 63, 64, 65, 255, 256, 511, 512, 513, 1024}) {
+        for (size_t offset : {0, 3}) {
+            std::uint8_t* data = buffer.data() + offset;
+            ASSERT_TRUE(zero_func(data, size)) << func_name << ": size " << size;
+            for (size_t pos = 0; pos < size; ++pos) {
+                for (int bit : {0, 7}) {
+                    data[pos] = static_cast<std::uint8_t>(1 << bit);
+                    ASSERT_FALSE(zero_func(data, size)) << func_name << ": size " << size << ", position " << pos;
+                    data[pos] = 0;
+                }
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        FindNonzeroTests,
+        FindNonzeroTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::find_first_nonzero_generic, "find_first_nonzero_generic"),
+                std::make_pair(omm::find_first_nonzero_avx2, "omm::find_first_nonzero_avx2"),
+                std::make_pair(omm::find_first_nonzero, "omm::find_first_nonzero")
+        )
+);
+
+INSTANTIATE_TEST_SUITE_P(
+        IsZeroTests,
+        IsZeroTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::is_zero_generic, "is_zero_generic"),
+                std::make_pair(omm::is_zero_avx2, "omm::is_zero_avx2"),
+                std::make_pair(omm::is_zero, "omm::is_zero")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        FindNonzeroTestsAVX512,
+        FindNonzeroTest,
+        ::testing::Values(
+                std::make_pair(omm::find_first_nonzero_avx512, "omm::find_first_nonzero_avx512")
+        )
+);
+
+INSTANTIATE_TEST_SUITE_P(
+        IsZeroTestsAVX512,
+        IsZeroTest,
+        ::testing::Values(
+                std::make_pair(omm::is_zero_avx512, "omm::is_zero_avx512")
+        )
+);
+#endif
+
+TEST(FindNonzeroParallelTest, MatchesSerialScan) {
+    const size_t size = omm::PARALLEL_SCAN_THRESHOLD + 5 * 1024 * 1024 + 123;
+    std::vector<std::uint8_t> data(size, 0);
+
+    EXPECT_EQ(size, omm::find_first_nonzero_parallel(data.data(), size, 4));
+    EXPECT_TRUE(omm::is_zero_parallel(data.data(), size, 4));
+
+    // Hits at the start, inside and at chunk edges, and in the short last chunk
+    for (size_t pos : {size_t{0}, size_t{4 * 1024 * 1024 - 1}, size_t{4 * 1024 * 1024}, size / 2, size - 1}) {
+        data[pos] = 1;
+        EXPECT_EQ(pos, omm::find_first_nonzero_parallel(data.data(), size, 4)) << "Position " << pos;
+        EXPECT_FALSE(omm::is_zero_parallel(data.data(), size, 4));
+        data[pos] = 0;
+    }
+
+    // The lowest of several hits wins, whichever thread finds it
+    data[size - 10] = 1;
+    data[size / 3] = 1;
+    data[size / 3 + 4 * 1024 * 1024] = 1;
+    EXPECT_EQ(size / 3, omm::find_first_nonzero_parallel(data.data(), size, 4));
+    EXPECT_EQ(size / 3, omm::find_first_nonzero_parallel(data.data(), size, 0));
+}
+
+TEST(FindNonzeroParallelTest, SmallInputsStaySerial) {
+    std::vector<std::uint8_t> data(1000, 0);
+    data[999] = 1;
+    EXPECT_EQ(999u, omm::find_first_nonzero_parallel(data.data(), data.size(), 8));
+    EXPECT_FALSE(omm::is_zero_parallel(data.data(), data.size(), 8));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
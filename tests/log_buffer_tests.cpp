@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "omm/log_buffer.h"
+
+namespace {
+
+// Test records: a header followed by a payload derived from it
+struct record_header {
+    std::uint32_t size;      // Whole record, header included
+    std::uint32_t producer;
+    std::uint64_t index;
+};
+
+std::vector<std::uint8_t> make_record(std::uint32_t producer, std::uint64_t index, std::size_t size) {
+    std::vector<std::uint8_t> record(size);
+    const record_header header{static_cast<std::uint32_t>(size), producer, index};
+    std::memcpy(record.data(), &header, sizeof(header));
+    for (size_t i = sizeof(header); i < size; ++i) record[i] = static_cast<std::uint8_t>(producer * 31 + index + i);
+    return record;
+}
+
+bool record_intact(const std::uint8_t* data, const record_header& header) {
+    for (size_t i = sizeof(header); i < header.size; ++i) {
+        if (data[i] != static_cast<std::uint8_t>(header.producer * 31 + header.index + i)) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TEST(LogBufferTest, RejectsInvalidGeometry) {
+    EXPECT_THROW(omm::log_buffer(0, 4), std::invalid_argument);
+    EXPECT_THROW(omm::log_buffer(4096, 1), std::invalid_argument);
+}
+
+TEST(LogBufferTest, RejectsOversizedRecords) {
+    omm::log_buffer log(1024, 2);
+    std::vector<std::uint8_t> record(1025);
+    EXPECT_FALSE(log.append(record.data(), record.size()));
+    EXPECT_TRUE(log.append(record.data(), 1024));
+}
+
+TEST(LogBufferTest, FlushHandsOverPartialSegment) {
+    omm::log_buffer log(4096, 2);
+    EXPECT_FALSE(log.poll().has_value());
+
+    log.flush();  // Empty segment: nothing to hand over
+    EXPECT_FALSE(log.poll().has_value());
+
+    const char first[] = "first";
+    const char second[] = "second";
+    ASSERT_TRUE(log.append(first, sizeof(first)));
+    ASSERT_TRUE(log.append(second, sizeof(second)));
+    EXPECT_FALSE(log.poll().has_value());
+
+    log.flush();
+    auto segment = log.poll();
+    ASSERT_TRUE(segment.has_value());
+    EXPECT_EQ(0u, segment->sequence);
+    ASSERT_EQ(sizeof(first) + sizeof(second), segment->size);
+    EXPECT_EQ(0, std::memcmp(segment->data, "first\0second", segment->size));
+    log.release(*segment);
+    EXPECT_FALSE(log.poll().has_value());
+}
+
+TEST(LogBufferTest, FullSegmentsAreHandedOverInOrder) {
+    omm::log_buffer log(1000, 3);
+    std::vector<std::uint8_t> record(300);
+
+    // Three records fit; the fourth seals the segment and starts the next one
+    for (int i = 0; i < 8; ++i) {
+        std::fill(record.begin(), record.end(), static_cast<std::uint8_t>(i));
+        ASSERT_TRUE(log.append(record.data(), record.size()));
+    }
+
+    for (std::uint64_t sequence = 0; sequence < 2; ++sequence) {
+        auto segment = log.poll();
+        ASSERT_TRUE(segment.has_value());
+        EXPECT_EQ(sequence, segment->sequence);
+        ASSERT_EQ(900u, segment->size);
+        const auto* data = static_cast<const std::uint8_t*>(segment->data);
+        for (size_t r = 0; r < 3; ++r) {
+            EXPECT_EQ(sequence * 3 + r, data[r * 300]);
+        }
+        log.release(*segment);
+    }
+    EXPECT_FALSE(log.poll().has_value());
+}
+
+TEST(LogBufferTest, ConcurrentProducersLoseNothing) {
+    constexpr std::uint32_t PRODUCERS = 4;
+    constexpr std::uint64_t RECORDS = 3000;
+    omm::log_buffer log(64 * 1024, 4);
+    std::atomic<bool> producers_done{false};
+
+    std::vector<std::uint64_t> seen(PRODUCERS, 0);
+    size_t corrupt = 0;
+    std::thread flusher([&] {
+        auto drain = [&] {
+            while (auto segment = log.poll()) {
+                const auto* data = static_cast<const std::uint8_t*>(segment->data);
+                for (size_t offset = 0; offset < segment->size;) {
+                    record_header header;
+                    std::memcpy(&header, data + offset, sizeof(header));
+                    if (header.size < sizeof(header) || header.producer >= PRODUCERS ||
+                        offset + header.size > segment->size || !record_intact(data + offset, header)) {
+                        ++corrupt;
+                        break;
+                    }
+                    ++seen[header.producer];
+                    offset += header.size;
+                }
+                log.release(*segment);
+            }
+        };
+        while (!producers_done.load()) {
+            drain();
+            std::this_thread::yield();
+        }
+        drain();
+        log.flush();
+        drain();
+    });
+
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&, p] {
+            std::mt19937 gen{p};
+            // Mostly small records, with some above the streaming threshold
+            std::uniform_int_distribution<size_t> small(sizeof(record_header), 256);
+            std::uniform_int_distribution<size_t> large(omm::log_buffer::STREAM_THRESHOLD, 3 * omm::log_buffer::STREAM_THRESHOLD);
+            for (std::uint64_t i = 0; i < RECORDS; ++i) {
+                const auto record = make_record(p, i, i % 16 == 0 ? large(gen) : small(gen));
+                ASSERT_TRUE(log.append(record.data(), record.size()));
+            }
+        });
+    }
+    for (auto& producer : producers) producer.join();
+    producers_done = true;
+    flusher.join();
+
+    EXPECT_EQ(0u, corrupt);
+    for (std::uint32_t p = 0; p < PRODUCERS; ++p) {
+        EXPECT_EQ(RECORDS, seen[p]) << "Producer " << p;
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
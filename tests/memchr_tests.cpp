@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "omm/memchr.h"
+
+using MemchrFunc = const void* (*)(const void*, int, std::size_t);
+using FindAnyOfFunc = const void* (*)(const void*, std::size_t, const std::uint8_t*);
+
+namespace {
+
+// The AVX-512 kernels are compiled whenever AVX-512F is, but also need AVX-512BW to run
+bool runnable(const char* func_name) {
+    return std::string(func_name).find("avx512") == std::string::npos || omm::detail::cpu_supports_avx512bw();
+}
+
+// Sizes covering the short path, block boundaries and the tails
+std::vector<size_t> test_sizes() {
+    std::vector<size_t> sizes;
+    for (size_t size = 0; size <= 300; ++size) sizes.push_back(size);
+    for (size_t size : {511, 512, 513, 1000, 4096, 4099}) sizes.push_back(size);
+    return sizes;
+}
+
+} // namespace
+
+class MemchrTest : public ::testing::TestWithParam<std::pair<MemchrFunc, const char*>> {
+protected:
+    void SetUp() override {
+        if (!runnable(GetParam().second)) GTEST_SKIP() << "AVX-512BW not supported";
+    }
+};
+
+class MemrchrTest : public MemchrTest {};
+
+class FindAnyOfTest : public ::testing::TestWithParam<std::pair<FindAnyOfFunc, const char*>> {
+protected:
+    void SetUp() override {
+        if (!runnable(GetParam().second)) GTEST_SKIP() << "AVX-512BW not supported";
+    }
+};
+
+TEST_P(MemchrTest, FindsFirstMatch) {
+    auto [search, func_name] = GetParam();
+    // Matching guard bytes on both sides must never be reported
+    std::vector<std::uint8_t> buffer(64 + 4099 + 64, 'x');
+
+    for (size_t size : test_sizes()) {
+        for (size_t offset : {0, 1, 31, 63}) {
+            std::uint8_t* data = buffer.data() + 64 + offset;
+            std::memset(data, 'a', size);
+            ASSERT_EQ(nullptr, search(data, 'x', size)) << func_name << ": size " << size << ", offset " << offset;
+
+            for (size_t pos = 0; pos < size; pos += (size < 300 ? 1 : 7)) {
+                data[pos] = 'x';
+                if (pos + 3 < size) data[pos + 3] = 'x';
+                ASSERT_EQ(data + pos, search(data, 'x', size)) << func_name << ": size " << size << ", offset " << offset;
+                data[pos] = 'a';
+                if (pos + 3 < size) data[pos + 3] = 'a';
+            }
+            std::memset(data, 'x', size);
+        }
+    }
+}
+
+TEST_P(MemchrTest, MatchesHighBytesAndZero) {
+    auto [search, func_name] = GetParam();
+    std::vector<std::uint8_t> data(200, 0x7F);
+    data[150] = 0xFF;
+    data[190] = 0;
+    EXPECT_EQ(data.data() + 150, search(data.data(), 0xFF, data.size())) << func_name;
+    EXPECT_EQ(data.data() + 150, search(data.data(), -1, data.size())) << func_name;
+    EXPECT_EQ(data.data() + 190, search(data.data(), 0, data.size())) << func_name;
+}
+
+TEST_P(MemrchrTest, FindsLastMatch) {
+    auto [search, func_name] = GetParam();
+    std::vector<std::uint8_t> buffer(64 + 4099 + 64, 'x');
+
+    for (size_t size : test_sizes()) {
+        for (size_t offset : {0, 1, 31, 63}) {
+            std::uint8_t* data = buffer.data() + 64 + offset;
+            std::memset(data, 'a', size);
+            ASSERT_EQ(nullptr, search(data, 'x', size)) << func_name << ": size " << size << ", offset " << offset;
+
+            for (size_t pos = 0; pos < size; pos += (size < 300 ? 1 : 7)) {
+                data[pos] = 'x';
+                if (pos >= 3) data[pos - 3] = 'x';
+                ASSERT_EQ(data + pos, search(data, 'x', size)) << func_name << ": size " << size << ", offset " << offset;
+                data[pos] = 'a';
+                if (pos >= 3) data[pos - 3] = 'a';
+            }
+            std::memset(data, 'x', size);
+        }
+    }
+}
+
+TEST_P(FindAnyOfTest, FindsFirstMemberOfSet) {
+    auto [search, func_name] = GetParam();
+    const omm::byte_set delimiters("\r\n,;\x80\xFF");
+    std::vector<std::uint8_t> buffer(64 + 4099 + 64, ',');
+
+    for (size_t size : test_sizes()) {
+        for (size_t offset : {0, 1, 33}) {
+            std::uint8_t* data = buffer.data() + 64 + offset;
+            // Non-members that share a nibble with a member
+            for (size_t i = 0; i < size; ++i) data[i] = "\x0c\x2d\x8a\xf0"[i % 4];
+            ASSERT_EQ(nullptr, search(data, size, delimiters.tables())) << func_name << ": size " << size;
+
+            for (size_t pos = 0; pos < size; pos += (size < 300 ? 1 : 7)) {
+                const std::uint8_t saved = data[pos];
+                data[pos] = "\r\n,;\x80\xFF"[pos % 6];
+                ASSERT_EQ(data + pos, search(data, size, delimiters.tables())) << func_name << ": size " << size << ", offset " << offset;
+                data[pos] = saved;
+            }
+            std::memset(data, ',', size);
+        }
+    }
+}
+
+TEST_P(FindAnyOfTest, ClassifiesEveryByteValue) {
+    auto [search, func_name] = GetParam();
+    // A set with members in every high nibble, checked against all 256 values
+    omm::byte_set set;
+    for (int b = 3; b < 256; b += 17) set.insert(static_cast<std::uint8_t>(b));
+
+    std::vector<std::uint8_t> data(256);
+    for (int b = 0; b < 256; ++b) {
+        std::fill(data.begin(), data.end(), static_cast<std::uint8_t>(b));
+        const void* expected = set.contains(static_cast<std::uint8_t>(b)) ? data.data() : nullptr;
+        ASSERT_EQ(expected, search(data.data(), data.size(), set.tables())) << func_name << ": byte " << b;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        MemchrTests,
+        MemchrTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::memchr_generic, "memchr_generic"),
+                std::make_pair(omm::memchr_avx2, "omm::memchr_avx2"),
+                std::make_pair(omm::memchr, "omm::memchr")
+        )
+);
+
+INSTANTIATE_TEST_SUITE_P(
+        MemrchrTests,
+        MemrchrTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::memrchr_generic, "memrchr_generic"),
+                std::make_pair(omm::memrchr_avx2, "omm::memrchr_avx2"),
+                std::make_pair(omm::memrchr, "omm::memrchr")
+        )
+);
+
+INSTANTIATE_TEST_SUITE_P(
+        FindAnyOfTests,
+        FindAnyOfTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::find_any_of_generic, "find_any_of_generic"),
+                std::make_pair(omm::find_any_of_avx2, "omm::find_any_of_avx2")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        MemchrTestsAVX512,
+        MemchrTest,
+        ::testing::Values(
+                std::make_pair(omm::memchr_avx512, "omm::memchr_avx512")
+        )
+);
+
+INSTANTIATE_TEST_SUITE_P(
+        MemrchrTestsAVX512,
+        MemrchrTest,
+        ::testing::Values(
+                std::make_pair(omm::memrchr_avx512, "omm::memrchr_avx512")
+        )
+);
+
+INSTANTIATE_TEST_SUITE_P(
+        FindAnyOfTestsAVX512,
+        FindAnyOfTest,
+        ::testing::Values(
+                std::make_pair(omm::find_any_of_avx512, "omm::find_any_of_avx512")
+        )
+);
+#endif
+
+TEST(FindAnyOfTest, PublicFunctionUsesSet) {
+    const std::string text = "key=value; other=thing\r\n";
+    const omm::byte_set delimiters(";\r\n");
+    EXPECT_EQ(text.data() + 9, omm::find_any_of(text.data(), text.size(), delimiters));
+    EXPECT_EQ(nullptr, omm::find_any_of(text.data(), 9, delimiters));
+    EXPECT_EQ(nullptr, omm::find_any_of(text.data(), text.size(), omm::byte_set()));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "omm/memcpy_delta.h"
+
+using MemcpyDeltaFunc = std::size_t (*)(void*, const void*, std::size_t, std::uint64_t*);
+
+class MemcpyDeltaTest : public ::testing::TestWithParam<std::pair<MemcpyDeltaFunc, const char*>> {
+protected:
+    std::mt19937 gen{42};  // Fixed seed for reproducibility
+
+    std::vector<char> generate_random_data(size_t size) {
+        std::vector<char> data(size);
+        std::uniform_int_distribution<> dis(0, 255);
+        std::generate(data.begin(), data.end(), [&]() { return static_cast<char>(dis(gen)); });
+        return data;
+    }
+};
+
+// Test that only the modified lines are reported and the result matches the source
+TEST_P(MemcpyDeltaTest, ReportsChangedLines) {
+    auto [delta_func, func_name] = GetParam();
+
+    for (size_t size : {size_t{0}, size_t{1}, size_t{63}, size_t{64}, size_t{65}, size_t{4096},
+                        size_t{64 * 64 + 17}, size_t{1 << 20}}) {
+        SCOPED_TRACE("Size: " + std::to_string(size));
+
+        auto src = generate_random_data(size);
+        auto dest = src;
+        std::vector<bool> expected((size + 63) / 64, false);
+
+        // Flip one byte in roughly every seventh line, plus the last byte
+        for (size_t line = 0; line * 64 < size; line += 7) {
+            size_t pos = line * 64 + std::uniform_int_distribution<size_t>(0, std::min<size_t>(63, size - line * 64 - 1))(gen);
+            dest[pos] = static_cast<char>(~src[pos]);
+            expected[line] = true;
+        }
+        if (size > 0) {
+            dest[size - 1] = static_cast<char>(~src[size - 1]);
+            expected[(size - 1) / 64] = true;
+        }
+
+        std::vector<std::uint64_t> bitmap(omm::dirty_bitmap_words(size), ~std::uint64_t{0});
+        size_t changed = delta_func(dest.data(), src.data(), size, bitmap.data());
+
+        EXPECT_EQ(src, dest) << func_name;
+        EXPECT_EQ(static_cast<size_t>(std::count(expected.begin(), expected.end(), true)), changed) << func_name;
+        for (size_t line = 0; line < expected.size(); ++line) {
+            bool dirty = (bitmap[line / 64] >> (line % 64)) & 1;
+            EXPECT_EQ(expected[line], dirty) << func_name << " line " << line;
+        }
+
+        // A second pass finds nothing to do
+        EXPECT_EQ(0u, delta_func(dest.data(), src.data(), size, nullptr)) << func_name;
+    }
+}
+
+// Test misaligned buffers, where lines do not coincide with cache lines
+TEST_P(MemcpyDeltaTest, UnalignedBuffers) {
+    auto [delta_func, func_name] = GetParam();
+    constexpr size_t size = 10000;
+
+    auto src = generate_random_data(size + 64);
+    std::vector<char> dest(size + 64, 0);
+
+    for (size_t src_align : {0, 3, 32}) {
+        for (size_t dest_align : {0, 5, 40}) {
+            std::fill(dest.begin(), dest.end(), 0);
+            delta_func(dest.data() + dest_align, src.data() + src_align, size, nullptr);
+            EXPECT_EQ(0, std::memcmp(dest.data() + dest_align, src.data() + src_align, size)) << func_name;
+            EXPECT_EQ(0, dest[dest_align + size]) << "Overflow detected in destination";
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyDeltaTests,
+        MemcpyDeltaTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::memcpy_delta_generic, "generic"),
+                std::make_pair(omm::memcpy_delta_avx2, "omm::memcpy_delta_avx2"),
+                std::make_pair(static_cast<MemcpyDeltaFunc>(omm::memcpy_delta), "omm::memcpy_delta")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyDeltaTestsAVX512,
+        MemcpyDeltaTest,
+        ::testing::Values(
+                std::make_pair(omm::memcpy_delta_avx512, "omm::memcpy_delta_avx512")
+        )
+);
+#endif
+
+TEST(DirtyRangesTest, CoalescesAdjacentLines) {
+    constexpr size_t size = 64 * 130 + 10;
+    std::vector<std::uint64_t> bitmap(omm::dirty_bitmap_words(size), 0);
+    auto mark = [&](size_t line) { bitmap[line / 64] |= std::uint64_t{1} << (line % 64); };
+
+    mark(0); mark(1); mark(2);
+    mark(63); mark(64);  // Spans a word boundary
+    mark(130);           // Trailing partial line
+
+    auto ranges = omm::dirty_ranges(bitmap.data(), size);
+    ASSERT_EQ(3u, ranges.size());
+    EXPECT_EQ(0u, ranges[0].offset);
+    EXPECT_EQ(3 * 64u, ranges[0].length);
+    EXPECT_EQ(63 * 64u, ranges[1].offset);
+    EXPECT_EQ(2 * 64u, ranges[1].length);
+    EXPECT_EQ(130 * 64u, ranges[2].offset);
+    EXPECT_EQ(10u, ranges[2].length);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
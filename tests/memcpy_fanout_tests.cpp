@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "omm/memcpy_fanout.h"
+
+using MemcpyFanoutFunc = void (*)(void* const*, std::size_t, const void*, std::size_t);
+
+class MemcpyFanoutTest : public ::testing::TestWithParam<std::pair<MemcpyFanoutFunc, const char*>> {
+protected:
+    std::mt19937 gen{42};  // Fixed seed for reproducibility
+
+    std::vector<char> generate_random_data(size_t size) {
+        std::vector<char> data(size);
+        std::uniform_int_distribution<> dis(0, 255);
+        std::generate(data.begin(), data.end(), [&]() { return static_cast<char>(dis(gen)); });
+        return data;
+    }
+
+    // Copies into count destinations at the given alignment offsets and checks each one
+    void check_fanout(MemcpyFanoutFunc fanout_func, const char* func_name, size_t size,
+                      const std::vector<size_t>& dest_aligns) {
+        auto src = generate_random_data(size);
+        std::vector<std::vector<char>> buffers(dest_aligns.size(), std::vector<char>(size + 128, 0));
+        std::vector<void*> dests;
+        for (size_t d = 0; d < dest_aligns.size(); ++d) {
+            dests.push_back(buffers[d].data() + dest_aligns[d]);
+        }
+
+        fanout_func(dests.data(), dests.size(), src.data(), size);
+
+        for (size_t d = 0; d < dest_aligns.size(); ++d) {
+            SCOPED_TRACE("Destination " + std::to_string(d) + ", alignment " + std::to_string(dest_aligns[d]));
+            EXPECT_EQ(0, std::memcmp(dests[d], src.data(), size)) << func_name;
+            EXPECT_EQ(0, buffers[d][dest_aligns[d] + size]) << "Overflow detected in destination";
+        }
+    }
+};
+
+// Test sizes straddling the L3 threshold with matching and mismatched destination alignments
+TEST_P(MemcpyFanoutTest, LargeSizes) {
+    auto [fanout_func, func_name] = GetParam();
+
+    for (size_t size : {size_t{G_L3_CACHE_SIZE} - 1, size_t{G_L3_CACHE_SIZE} + 1023}) {
+        SCOPED_TRACE("Size: " + std::to_string(size));
+        check_fanout(fanout_func, func_name, size, {0});
+        check_fanout(fanout_func, func_name, size, {8, 8, 8});
+        check_fanout(fanout_func, func_name, size, {3, 0, 40, 17});
+    }
+}
+
+TEST_P(MemcpyFanoutTest, SmallSizes) {
+    auto [fanout_func, func_name] = GetParam();
+
+    for (size_t size : {0, 1, 31, 64, 1000, 65536}) {
+        SCOPED_TRACE("Size: " + std::to_string(size));
+        check_fanout(fanout_func, func_name, size, {0, 1, 2});
+    }
+}
+
+TEST_P(MemcpyFanoutTest, NoDestinations) {
+    auto [fanout_func, func_name] = GetParam();
+    char src[16] = {};
+    fanout_func(nullptr, 0, src, sizeof(src));
+    SUCCEED() << func_name;
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyFanoutTests,
+        MemcpyFanoutTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::memcpy_fanout_generic, "generic"),
+                std::make_pair(omm::memcpy_fanout_avx2, "omm::memcpy_fanout_avx2")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyFanoutTestsAVX512,
+        MemcpyFanoutTest,
+        ::testing::Values(
+                std::make_pair(omm::memcpy_fanout_avx512, "omm::memcpy_fanout_avx512")
+        )
+);
+#endif
+
+TEST(MemcpyFanoutSpanTest, AcceptsMutableSpan) {
+    std::vector<char> src(4096, 7);
+    std::vector<char> a(4096), b(4096);
+    std::vector<void*> dests = {a.data(), b.data()};
+
+    omm::memcpy_fanout(src.data(), src.size(), std::span<void*>(dests));
+
+    EXPECT_EQ(src, a);
+    EXPECT_EQ(src, b);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include <numeric>
+#include <utility>
+#include "omm/memcpy.h"
+
+class MemcpyFixedTest : public ::testing::Test {
+protected:
+    static constexpr size_t GUARD = 64;
+
+    // Copies N bytes at every offset in [0, 64) and checks content and guard bytes
+    template <size_t N>
+    static void check_size() {
+        std::vector<unsigned char> src(N + 2 * GUARD);
+        std::iota(src.begin(), src.end(), static_cast<unsigned char>(N));
+
+        for (size_t offset : {0, 1, 7, 31, 63}) {
+            std::vector<unsigned char> dest(N + 2 * GUARD, 0xEE);
+            void* result = omm::memcpy<N>(dest.data() + offset, src.data() + offset);
+
+            EXPECT_EQ(dest.data() + offset, result);
+            EXPECT_EQ(0, std::memcmp(dest.data() + offset, src.data() + offset, N))
+                    << "Size " << N << ", offset " << offset;
+            if (offset > 0) {
+                EXPECT_EQ(0xEE, dest[offset - 1]) << "Underflow for size " << N;
+            }
+            EXPECT_EQ(0xEE, dest[offset + N]) << "Overflow for size " << N;
+        }
+    }
+
+    template <size_t... N>
+    static void check_sizes(std::index_sequence<N...>) {
+        (check_size<N>(), ...);
+    }
+};
+
+// Every size up to 300 bytes covers each scalar, vector and overlapping-tail case
+TEST_F(MemcpyFixedTest, AllSmallSizes) {
+    check_sizes(std::make_index_sequence<300>{});
+}
+
+// Sizes beyond the straight-line limit use the constant trip-count loop
+TEST_F(MemcpyFixedTest, MediumSizes) {
+    check_size<1024>();
+    check_size<1025>();
+    check_size<4096 + 33>();
+    check_size<65536 - 1>();
+}
+
+// Sizes at the streaming threshold are routed to the streaming kernels
+TEST_F(MemcpyFixedTest, StreamingSizes) {
+    check_size<OMM_FIXED_STREAMING_THRESHOLD>();
+    check_size<OMM_FIXED_STREAMING_THRESHOLD + 1023>();
+}
+
+struct alignas(64) Record {
+    std::uint64_t key;
+    char payload[100];
+};
+
+TEST_F(MemcpyFixedTest, CopyFixedRecord) {
+    Record src{};
+    src.key = 0x0123456789abcdefULL;
+    std::iota(std::begin(src.payload), std::end(src.payload), 'a');
+    Record dest{};
+
+    Record* result = omm::copy_fixed(&dest, &src);
+
+    EXPECT_EQ(&dest, result);
+    EXPECT_EQ(0, std::memcmp(&dest, &src, sizeof(Record)));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "omm/memcpy_persist.h"
+
+using MemcpyPersistFunc = void (*)(void*, const void*, std::size_t, void (*)(const void*, std::size_t));
+
+namespace {
+
+// Ranges handed to the flush callback by the kernel under test
+std::vector<std::pair<std::uintptr_t, std::size_t>> flushed_ranges;
+
+void record_flush(const void* addr, std::size_t n) {
+    flushed_ranges.emplace_back(reinterpret_cast<std::uintptr_t>(addr), n);
+}
+
+} // namespace
+
+class MemcpyPersistKernelTest : public ::testing::TestWithParam<std::tuple<MemcpyPersistFunc, const char*, bool>> {
+protected:
+    std::mt19937 gen{42};  // Fixed seed for reproducibility
+
+    std::vector<char> generate_random_data(size_t size) {
+        std::vector<char> data(size);
+        std::uniform_int_distribution<> dis(0, 255);
+        std::generate(data.begin(), data.end(), [&]() { return static_cast<char>(dis(gen)); });
+        return data;
+    }
+};
+
+// Every byte is copied, and every byte written with regular stores is flushed. Streaming
+// kernels must flush at most the partial lines at either end.
+TEST_P(MemcpyPersistKernelTest, CopiesAndFlushesRegularStores) {
+    auto [persist_func, func_name, streams] = GetParam();
+
+    for (size_t size : {1, 63, 64, 65, 300, 4096, 100000}) {
+        for (size_t offset : {0, 1, 17, 63}) {
+            SCOPED_TRACE(std::string(func_name) + " size " + std::to_string(size) + ", offset " + std::to_string(offset));
+            auto src = generate_random_data(size + 3);
+            std::vector<char> dest(size + offset + 64, 0);
+            char* dest_ptr = dest.data() + offset;
+
+            flushed_ranges.clear();
+            persist_func(dest_ptr, src.data() + 3, size, record_flush);
+
+            EXPECT_EQ(0, std::memcmp(dest_ptr, src.data() + 3, size));
+            EXPECT_EQ(0, dest[offset + size]) << "Overflow detected in destination";
+
+            size_t flushed = 0;
+            for (auto [addr, n] : flushed_ranges) {
+                EXPECT_GE(addr, reinterpret_cast<std::uintptr_t>(dest_ptr));
+                EXPECT_LE(addr + n, reinterpret_cast<std::uintptr_t>(dest_ptr) + size);
+                flushed += n;
+            }
+            if (streams) {
+                EXPECT_LE(flushed_ranges.size(), 2u);
+                EXPECT_LT(flushed, 2 * omm::detail::PERSIST_LINE_SIZE);
+            } else {
+                EXPECT_EQ(size, flushed);
+            }
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyPersistKernelTests,
+        MemcpyPersistKernelTest,
+        ::testing::Values(
+                std::make_tuple(omm::detail::memcpy_persist_generic, "generic", false),
+                std::make_tuple(omm::memcpy_persist_avx2, "omm::memcpy_persist_avx2", true)
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyPersistKernelTestsAVX512,
+        MemcpyPersistKernelTest,
+        ::testing::Values(
+                std::make_tuple(omm::memcpy_persist_avx512, "omm::memcpy_persist_avx512", true)
+        )
+);
+#endif
+
+// Public API against a file-backed shared mapping, with every method the CPU supports
+class MemcpyPersistTest : public ::testing::TestWithParam<omm::persist_method> {
+protected:
+    static constexpr size_t MAPPING_SIZE = 4 * 1024 * 1024;
+
+    void SetUp() override {
+        const auto method = GetParam();
+        if (method == omm::persist_method::clwb && !omm::detail::cpu_supports_clwb()) GTEST_SKIP() << "CLWB not supported";
+        if (method == omm::persist_method::clflushopt && !omm::detail::cpu_supports_clflushopt()) GTEST_SKIP() << "CLFLUSHOPT not supported";
+
+        char path[] = "/dev/shm/omm_persist_test_XXXXXX";
+        fd = mkstemp(path);
+        ASSERT_GE(fd, 0);
+        unlink(path);
+        ASSERT_EQ(0, ftruncate(fd, MAPPING_SIZE));
+        mapping = static_cast<char*>(mmap(nullptr, MAPPING_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+        ASSERT_NE(MAP_FAILED, mapping);
+    }
+
+    void TearDown() override {
+        if (mapping != nullptr && mapping != MAP_FAILED) munmap(mapping, MAPPING_SIZE);
+        if (fd >= 0) close(fd);
+    }
+
+    int fd = -1;
+    char* mapping = nullptr;
+};
+
+TEST_P(MemcpyPersistTest, CopiesIntoFileMapping) {
+    const auto method = GetParam();
+    std::mt19937 gen{7};
+    std::uniform_int_distribution<> dis(0, 255);
+    std::vector<char> src(MAPPING_SIZE);
+    std::generate(src.begin(), src.end(), [&]() { return static_cast<char>(dis(gen)); });
+
+    size_t offset = 0;
+    for (size_t size : {size_t{0}, size_t{1}, size_t{100}, size_t{OMM_PERSIST_STREAM_THRESHOLD}, size_t{5000}, size_t{1 << 20}}) {
+        ASSERT_TRUE(omm::memcpy_persist(mapping + offset, src.data() + offset, size, method));
+        offset += size + 3;
+    }
+
+    // Read the file back through the descriptor rather than the mapping
+    std::vector<char> file(offset);
+    ASSERT_EQ(static_cast<ssize_t>(offset), pread(fd, file.data(), offset, 0));
+    offset = 0;
+    for (size_t size : {size_t{0}, size_t{1}, size_t{100}, size_t{OMM_PERSIST_STREAM_THRESHOLD}, size_t{5000}, size_t{1 << 20}}) {
+        EXPECT_EQ(0, std::memcmp(file.data() + offset, src.data() + offset, size)) << "Size " << size;
+        offset += size + 3;
+    }
+
+    std::memset(mapping, 0x5A, 4096);
+    EXPECT_TRUE(omm::persist(mapping + 10, 4000, method));
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyPersistTests,
+        MemcpyPersistTest,
+        ::testing::Values(omm::persist_method::clwb, omm::persist_method::clflushopt, omm::persist_method::msync)
+);
+
+TEST(MemcpyPersistMethodTest, DefaultMatchesCpu) {
+    const auto method = omm::default_persist_method();
+    if (omm::detail::cpu_supports_clwb()) {
+        EXPECT_EQ(omm::persist_method::clwb, method);
+    } else if (omm::detail::cpu_supports_clflushopt()) {
+        EXPECT_EQ(omm::persist_method::clflushopt, method);
+    } else {
+        EXPECT_EQ(omm::persist_method::msync, method);
+    }
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
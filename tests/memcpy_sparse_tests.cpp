@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "omm/memcpy_sparse.h"
+
+using SparsePageFunc = bool (*)(void*, const void*, std::size_t, bool);
+
+class MemcpySparseTest : public ::testing::Test {
+protected:
+    static constexpr size_t PAGES = 64;
+
+    size_t page_size = omm::detail::system_page_size();
+    size_t size = PAGES * page_size;
+    std::mt19937 gen{42};  // Fixed seed for reproducibility
+
+    // Builds a source where every page whose index is a multiple of zero_stride is zero
+    std::vector<char> generate_sparse_data(size_t zero_stride) {
+        std::vector<char> data(size, 0);
+        std::uniform_int_distribution<> dis(1, 255);
+        for (size_t page = 0; page < PAGES; ++page) {
+            if (page % zero_stride == 0) continue;
+            // Leave most of the page zero so the kernel's scan has to find the data
+            size_t pos = page * page_size + std::uniform_int_distribution<size_t>(0, page_size - 1)(gen);
+            data[pos] = static_cast<char>(dis(gen));
+        }
+        return data;
+    }
+
+    static char* map_anonymous(size_t length) {
+        void* ptr = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        return ptr == MAP_FAILED ? nullptr : static_cast<char*>(ptr);
+    }
+};
+
+TEST_F(MemcpySparseTest, SkipLeavesZeroPagesUntouched) {
+    auto src = generate_sparse_data(2);
+    char* dest = map_anonymous(size);
+    ASSERT_NE(dest, nullptr);
+
+    auto stats = omm::memcpy_sparse(dest, src.data(), size);
+
+    EXPECT_EQ(0, std::memcmp(dest, src.data(), size));
+    EXPECT_EQ(PAGES, stats.pages);
+    EXPECT_EQ(PAGES / 2, stats.zero_pages);
+    EXPECT_EQ(size / 2, stats.bytes_copied);
+    munmap(dest, size);
+}
+
+TEST_F(MemcpySparseTest, DiscardReleasesDirtyPages) {
+    auto src = generate_sparse_data(3);
+    char* dest = map_anonymous(size);
+    ASSERT_NE(dest, nullptr);
+    std::memset(dest, 0xFF, size);
+
+    auto stats = omm::memcpy_sparse(dest, src.data(), size, {omm::zero_page_policy::discard});
+
+    EXPECT_EQ(0, std::memcmp(dest, src.data(), size));
+    EXPECT_EQ((PAGES + 2) / 3, stats.zero_pages);
+    munmap(dest, size);
+}
+
+TEST_F(MemcpySparseTest, PunchHoleInFileBackedDestination) {
+    auto src = generate_sparse_data(4);
+    FILE* file = std::tmpfile();
+    ASSERT_NE(file, nullptr);
+    int fd = fileno(file);
+    ASSERT_EQ(0, ftruncate(fd, static_cast<off_t>(size)));
+
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ASSERT_NE(mapping, MAP_FAILED);
+    char* dest = static_cast<char*>(mapping);
+    std::memset(dest, 0xFF, size);
+
+    auto stats = omm::memcpy_sparse(dest, src.data(), size, {omm::zero_page_policy::punch_hole, fd, 0});
+
+    EXPECT_EQ(0, std::memcmp(dest, src.data(), size));
+    EXPECT_EQ(PAGES / 4, stats.zero_pages);
+
+    // The file contents must match as well, not just the mapping
+    std::vector<char> contents(size);
+    ASSERT_EQ(static_cast<ssize_t>(size), pread(fd, contents.data(), size, 0));
+    EXPECT_EQ(0, std::memcmp(contents.data(), src.data(), size));
+
+    munmap(mapping, size);
+    std::fclose(file);
+}
+
+TEST_F(MemcpySparseTest, UnalignedHeadAndTail) {
+    auto src = generate_sparse_data(2);
+    std::vector<char> dest(size + 64, static_cast<char>(0xAA));
+
+    for (size_t offset : {1, 17, 63}) {
+        SCOPED_TRACE("Offset: " + std::to_string(offset));
+        size_t copy_size = size - page_size / 2 - offset;
+        std::fill(dest.begin(), dest.end(), static_cast<char>(0xAA));
+
+        // Use an explicit zero fill so a non-zero destination is still correct
+        omm::memcpy_sparse(dest.data() + offset, src.data() + offset, copy_size, {omm::zero_page_policy::discard});
+
+        EXPECT_EQ(0, std::memcmp(dest.data() + offset, src.data() + offset, copy_size));
+        EXPECT_EQ(static_cast<char>(0xAA), dest[offset + copy_size]) << "Overflow detected in destination";
+    }
+}
+
+class SparsePageKernelTest : public ::testing::TestWithParam<std::pair<SparsePageFunc, const char*>> {};
+
+TEST_P(SparsePageKernelTest, ZeroDetectionAndPrefix) {
+    auto [kernel, name] = GetParam();
+    constexpr size_t page = 4096;
+    alignas(64) static char src[page];
+    alignas(64) static char dest[page];
+
+    std::memset(src, 0, page);
+    std::memset(dest, 0x55, page);
+    EXPECT_TRUE(kernel(dest, src, page, true)) << name;
+    EXPECT_EQ(0x55, dest[0]) << "Zero page must not be written by " << name;
+
+    // Non-zero byte at every position class: first byte, block boundary, last byte
+    for (size_t pos : {size_t{0}, size_t{511}, size_t{512}, size_t{2048 + 33}, page - 1}) {
+        SCOPED_TRACE("Non-zero position: " + std::to_string(pos));
+        std::memset(src, 0, page);
+        std::memset(dest, 0x55, page);
+        src[pos] = 7;
+        EXPECT_FALSE(kernel(dest, src, page, true)) << name;
+        _mm_sfence();
+        EXPECT_EQ(0, std::memcmp(dest, src, page)) << name;
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        SparsePageKernels,
+        SparsePageKernelTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::memcpy_sparse_page_generic, "generic"),
+                std::make_pair(omm::memcpy_sparse_page_avx2, "omm::memcpy_sparse_page_avx2")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        SparsePageKernelsAVX512,
+        SparsePageKernelTest,
+        ::testing::Values(
+                std::make_pair(omm::memcpy_sparse_page_avx512, "omm::memcpy_sparse_page_avx512")
+        )
+);
+#endif
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -200,7 +200,7 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(
                 std::make_pair(std::memcpy, "std::memcpy"),
                 std::make_pair(omm::memcpy_avx2, "omm::memcpy_avx2"),
-                std::make_pair(omm::memcpy, "omm::memcpy")
+                std::make_pair(static_cast<MemcpyFunc>(omm::memcpy), "omm::memcpy")
         )
 );
 
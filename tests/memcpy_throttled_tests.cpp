@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <numeric>
+#include "omm/memcpy_throttled.h"
+
+class MemcpyThrottledTest : public ::testing::Test {
+protected:
+    std::mt19937 gen{42};  // Fixed seed for reproducibility
+
+    std::vector<char> generate_random_data(size_t size) {
+        std::vector<char> data(size);
+        std::uniform_int_distribution<> dis(0, 255);
+        std::generate(data.begin(), data.end(), [&]() { return static_cast<char>(dis(gen)); });
+        return data;
+    }
+};
+
+TEST_F(MemcpyThrottledTest, CopiesAllBytes) {
+    for (size_t size : {0, 1, 100, 4096, 1 << 20, (1 << 20) + 17}) {
+        SCOPED_TRACE("Size: " + std::to_string(size));
+        auto src = generate_random_data(size + 8);
+        std::vector<char> dest(size + 8, 0);
+
+        // Unthrottled, with small chunks so the chunk boundaries are exercised
+        omm::copy_throttle throttle(0, 4096 + 3);
+        throttle.copy(dest.data() + 5, src.data() + 1, size);
+
+        EXPECT_EQ(0, std::memcmp(dest.data() + 5, src.data() + 1, size));
+        EXPECT_EQ(0, dest[5 + size]) << "Overflow detected in destination";
+    }
+}
+
+TEST_F(MemcpyThrottledTest, RespectsRate) {
+    constexpr size_t size = 16 * 1024 * 1024;
+    constexpr double rate = 128.0 * 1024 * 1024;  // 128 MiB/s
+    auto src = generate_random_data(size);
+    std::vector<char> dest(size, 0);
+
+    const auto start = std::chrono::steady_clock::now();
+    omm::memcpy_throttled(dest.data(), src.data(), size, rate);
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The first chunk is covered by the initial burst
+    const double expected = static_cast<double>(size - omm::copy_throttle::DEFAULT_CHUNK_SIZE) / rate;
+    EXPECT_GE(elapsed, 0.95 * expected);
+    EXPECT_EQ(0, std::memcmp(dest.data(), src.data(), size));
+}
+
+TEST_F(MemcpyThrottledTest, AdaptiveRateStaysWithinBounds) {
+    constexpr size_t size = 8 * 1024 * 1024;
+    constexpr double rate = 1024.0 * 1024 * 1024;
+    auto src = generate_random_data(size);
+    std::vector<char> dest(size, 0);
+
+    omm::copy_throttle throttle(rate, omm::copy_throttle::DEFAULT_CHUNK_SIZE, true);
+    throttle.copy(dest.data(), src.data(), size);
+
+    EXPECT_GT(throttle.observed_throughput(), 0);
+    EXPECT_LE(throttle.effective_rate(), rate);
+    EXPECT_GE(throttle.effective_rate(), 0.1 * rate);
+    EXPECT_EQ(0, std::memcmp(dest.data(), src.data(), size));
+}
+
+// The streaming bodies have no small-size fast path, so they must handle any size
+class MemcpyStreamTest : public ::testing::TestWithParam<std::pair<void* (*)(void*, const void*, std::size_t), const char*>> {};
+
+TEST_P(MemcpyStreamTest, AllSizesAndAlignments) {
+    auto [stream_func, func_name] = GetParam();
+    std::vector<char> src(70000);
+    std::iota(src.begin(), src.end(), 0);
+
+    for (size_t size : {0, 1, 5, 31, 32, 63, 64, 65, 511, 512, 1000, 65536}) {
+        for (size_t dest_align : {0, 1, 31, 33}) {
+            std::vector<char> dest(size + 128, 0);
+            stream_func(dest.data() + dest_align, src.data() + 3, size);
+            _mm_sfence();
+            EXPECT_EQ(0, std::memcmp(dest.data() + dest_align, src.data() + 3, size))
+                    << func_name << " size " << size << " alignment " << dest_align;
+            EXPECT_EQ(0, dest[dest_align + size]) << "Overflow detected in destination";
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyStreamTests,
+        MemcpyStreamTest,
+        ::testing::Values(
+                std::make_pair(omm::memcpy_avx2_stream, "omm::memcpy_avx2_stream")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        MemcpyStreamTestsAVX512,
+        MemcpyStreamTest,
+        ::testing::Values(
+                std::make_pair(omm::memcpy_avx512_stream, "omm::memcpy_avx512_stream")
+        )
+);
+#endif
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "omm/persistent_arena.h"
+
+namespace {
+
+struct node {
+    std::uint64_t value;
+    omm::offset_ptr<node> next;
+};
+
+struct list_root {
+    std::uint64_t count;
+    omm::offset_ptr<node> head;
+};
+
+// Builds a list of count nodes holding values first, first + 1, ...
+list_root* build_list(omm::persistent_arena& arena, std::uint64_t count, std::uint64_t first = 0) {
+    auto* root = arena.construct<list_root>();
+    root->count = count;
+    for (std::uint64_t i = count; i-- > 0;) {
+        root->head = arena.construct<node>(node{first + i, root->head});
+    }
+    return root;
+}
+
+void expect_list(const list_root* root, std::uint64_t count, std::uint64_t first = 0) {
+    ASSERT_NE(nullptr, root);
+    EXPECT_EQ(count, root->count);
+    std::uint64_t expected = first;
+    for (const node* n = root->head.get(); n; n = n->next.get()) {
+        ASSERT_EQ(expected++, n->value);
+    }
+    EXPECT_EQ(first + count, expected);
+}
+
+} // namespace
+
+class PersistentArenaTest : public ::testing::Test {
+protected:
+    static constexpr std::size_t CAPACITY = 4 * 1024 * 1024;
+
+    void SetUp() override {
+        char path_template[] = "/dev/shm/omm_arena_test_XXXXXX";
+        const int fd = mkstemp(path_template);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        path = path_template;
+    }
+
+    void TearDown() override { unlink(path.c_str()); }
+
+    std::string path;
+};
+
+TEST(OffsetPtrTest, SurvivesCopyToAnotherAddress) {
+    struct pair_of {
+        int value;
+        omm::offset_ptr<int> ptr;
+    };
+    alignas(pair_of) unsigned char first[sizeof(pair_of)];
+    alignas(pair_of) unsigned char second[sizeof(pair_of)];
+
+    auto* original = new (first) pair_of{42, nullptr};
+    original->ptr = &original->value;
+    EXPECT_EQ(&original->value, original->ptr.get());
+
+    // A bitwise copy, as after remapping, points at the copy's own member
+    std::memcpy(second, first, sizeof(pair_of));
+    auto* moved = reinterpret_cast<pair_of*>(second);
+    EXPECT_EQ(&moved->value, moved->ptr.get());
+    EXPECT_EQ(42, *moved->ptr);
+
+    omm::offset_ptr<int> null_ptr;
+    EXPECT_FALSE(null_ptr);
+    EXPECT_EQ(nullptr, null_ptr.get());
+}
+
+TEST_F(PersistentArenaTest, NewArenaIsEmpty) {
+    omm::persistent_arena arena(path, CAPACITY);
+    EXPECT_FALSE(arena.relocated());
+    EXPECT_EQ(CAPACITY, arena.capacity());
+    EXPECT_EQ(omm::persistent_arena::HEADER_SIZE, arena.used());
+    EXPECT_EQ(nullptr, arena.root<list_root>());
+}
+
+TEST_F(PersistentArenaTest, ReattachesCommittedData) {
+    void* base = nullptr;
+    {
+        omm::persistent_arena arena(path, CAPACITY);
+        arena.set_root(build_list(arena, 1000));
+        arena.commit();
+        base = arena.base();
+    }
+
+    omm::persistent_arena arena(path, CAPACITY);
+    EXPECT_TRUE(arena.attached());
+    EXPECT_EQ(base, arena.base()) << "Arena should remap at its recorded base when free";
+    EXPECT_EQ(1u, arena.generation());
+    expect_list(arena.root<list_root>(), 1000);
+}
+
+TEST_F(PersistentArenaTest, DiscardsUncommittedAllocations) {
+    std::size_t committed_used = 0;
+    {
+        omm::persistent_arena arena(path, CAPACITY);
+        arena.set_root(build_list(arena, 10));
+        arena.commit();
+        committed_used = arena.used();
+
+        // Simulated crash: allocate and move the root, then drop the arena without committing
+        arena.set_root(build_list(arena, 20, 100));
+    }
+
+    omm::persistent_arena arena(path, CAPACITY);
+    EXPECT_EQ(committed_used, arena.used());
+    expect_list(arena.root<list_root>(), 10);
+}
+
+TEST_F(PersistentArenaTest, TornCommitFallsBackToPreviousRecord) {
+    {
+        omm::persistent_arena arena(path, CAPACITY);
+        arena.set_root(build_list(arena, 5));
+        arena.commit();
+        arena.set_root(build_list(arena, 7, 50));
+        arena.commit();
+
+        // Corrupt the newest record as a crash in the middle of writing it would
+        auto& header = *static_cast<omm::detail::arena_header*>(arena.base());
+        header.commits[arena.generation() & 1].used ^= 0x40;
+    }
+
+    omm::persistent_arena arena(path, CAPACITY);
+    EXPECT_EQ(1u, arena.generation());
+    expect_list(arena.root<list_root>(), 5);
+}
+
+TEST_F(PersistentArenaTest, RelocatedMappingKeepsLinks) {
+    omm::persistent_arena first(path, CAPACITY);
+    first.set_root(build_list(first, 100));
+    first.commit();
+
+    // The recorded base is occupied by the first mapping, so the second lands elsewhere
+    omm::persistent_arena second(path, CAPACITY);
+    EXPECT_TRUE(second.relocated());
+    EXPECT_NE(first.base(), second.base());
+    expect_list(second.root<list_root>(), 100);
+}
+
+TEST_F(PersistentArenaTest, GrowsExistingFile) {
+    {
+        omm::persistent_arena arena(path, CAPACITY);
+        arena.set_root(build_list(arena, 3));
+        arena.commit();
+    }
+
+    omm::persistent_arena arena(path, 2 * CAPACITY, {.huge_pages = true, .prefault = false});
+    EXPECT_EQ(2 * CAPACITY, arena.capacity());
+    expect_list(arena.root<list_root>(), 3);
+    EXPECT_NE(nullptr, arena.allocate(CAPACITY));
+}
+
+TEST_F(PersistentArenaTest, HugePagesAlignTheMapping) {
+    {
+        omm::persistent_arena arena(path, CAPACITY + 1, {.huge_pages = true});
+        EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(arena.base()) % omm::detail::HUGE_PAGE_SIZE);
+        EXPECT_EQ(0u, arena.capacity() % omm::detail::HUGE_PAGE_SIZE);
+        arena.set_root(build_list(arena, 3));
+        arena.commit();
+    }
+
+    // Reattached elsewhere, e.g. while the recorded base is taken, the mapping stays aligned
+    omm::persistent_arena holder(path, 0);
+    omm::persistent_arena arena(path, 0, {.huge_pages = true});
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(arena.base()) % omm::detail::HUGE_PAGE_SIZE);
+    expect_list(arena.root<list_root>(), 3);
+}
+
+TEST_F(PersistentArenaTest, ThrowsWhenFull) {
+    omm::persistent_arena arena(path, CAPACITY);
+    EXPECT_NE(nullptr, arena.allocate(CAPACITY - omm::persistent_arena::HEADER_SIZE, 1));
+    EXPECT_THROW(arena.allocate(1), std::bad_alloc);
+}
+
+TEST_F(PersistentArenaTest, FailedSyncKeepsArenaUsable) {
+    omm::persistent_arena arena(path, CAPACITY);
+    arena.set_root(build_list(arena, 10));
+    arena.commit();
+
+    // Unmap a page of the arena under new allocations so msync fails with ENOMEM
+    const std::size_t page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    const std::size_t offset = (arena.used() + page - 1) & ~(page - 1);
+    arena.set_root(build_list(arena, 1000, 100));
+    ASSERT_GT(arena.used(), offset + page);
+    auto* hole = static_cast<std::uint8_t*>(arena.base()) + offset;
+    ASSERT_EQ(0, munmap(hole, page));
+    EXPECT_THROW(arena.commit(), std::system_error);
+    EXPECT_EQ(1u, arena.generation());
+
+    // Map the page back, with the data it held in the file: the rest of the arena is still
+    // mapped, and a retried commit succeeds
+    const int fd = ::open(path.c_str(), O_RDWR);
+    ASSERT_GE(fd, 0);
+    ASSERT_EQ(hole, mmap(hole, page, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, static_cast<off_t>(offset)));
+    close(fd);
+    ASSERT_NE(nullptr, arena.base());
+    expect_list(arena.root<list_root>(), 1000, 100);
+    arena.commit();
+    EXPECT_EQ(2u, arena.generation());
+
+    omm::persistent_arena reopened(path, CAPACITY);
+    expect_list(reopened.root<list_root>(), 1000, 100);
+}
+
+TEST_F(PersistentArenaTest, FlushMethodCommit) {
+    const auto method = omm::default_persist_method();
+    if (method == omm::persist_method::msync) GTEST_SKIP() << "No cache line flush instruction";
+    {
+        omm::persistent_arena arena(path, CAPACITY, {.method = method});
+        arena.set_root(build_list(arena, 50));
+        arena.commit();
+    }
+    omm::persistent_arena arena(path, CAPACITY, {.method = method});
+    expect_list(arena.root<list_root>(), 50);
+}
+
+TEST(PersistentArenaOpenTest, ThrowsOnBadPath) {
+    EXPECT_THROW(omm::persistent_arena("/nonexistent_dir/omm_arena", 4096), std::system_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "omm/rcu_buffer.h"
+
+TEST(RcuBufferTest, StartsEmpty) {
+    omm::rcu_buffer buffer(4096);
+    EXPECT_EQ(4096u, buffer.capacity());
+    EXPECT_EQ(0u, buffer.version());
+
+    auto guard = buffer.read();
+    EXPECT_EQ(0u, guard.size());
+    EXPECT_NE(nullptr, guard.data());
+}
+
+TEST(RcuBufferTest, PublishesVersions) {
+    omm::rcu_buffer buffer(1024);
+
+    for (std::uint64_t version = 1; version <= 5; ++version) {
+        auto* spare = static_cast<char*>(buffer.begin_update());
+        std::memset(spare, static_cast<int>(version), 100 * version);
+        EXPECT_EQ(version, buffer.publish(100 * version));
+
+        auto guard = buffer.read();
+        EXPECT_EQ(version, guard.version());
+        ASSERT_EQ(100 * version, guard.size());
+        const auto* data = static_cast<const char*>(guard.data());
+        EXPECT_TRUE(std::all_of(data, data + guard.size(), [&](char c) { return c == static_cast<char>(version); }));
+    }
+}
+
+// Unchanged ranges come from the current version, including streamed ranges above the L3 size
+TEST(RcuBufferTest, CopyUnchangedCarriesData) {
+    for (size_t size : {size_t{4096}, size_t{G_L3_CACHE_SIZE} + 4096}) {
+        SCOPED_TRACE("Size: " + std::to_string(size));
+        omm::rcu_buffer buffer(size);
+
+        auto* first = static_cast<std::uint8_t*>(buffer.begin_update());
+        for (size_t i = 0; i < size; ++i) first[i] = static_cast<std::uint8_t>(i * 7);
+        buffer.publish(size);
+
+        // Change one byte in the middle and carry the rest over
+        auto* second = static_cast<std::uint8_t*>(buffer.begin_update());
+        const size_t changed = size / 2;
+        buffer.copy_unchanged(0, changed);
+        second[changed] = 0xAB;
+        buffer.copy_unchanged(changed + 1, size - changed - 1);
+        buffer.publish(size);
+
+        auto guard = buffer.read();
+        const auto* data = static_cast<const std::uint8_t*>(guard.data());
+        for (size_t i = 0; i < size; ++i) {
+            const auto expected = i == changed ? std::uint8_t{0xAB} : static_cast<std::uint8_t>(i * 7);
+            ASSERT_EQ(expected, data[i]) << "Byte " << i;
+        }
+    }
+}
+
+TEST(RcuBufferTest, UpdateWaitsForReadersOfSpareBuffer) {
+    omm::rcu_buffer buffer(4096);
+    buffer.begin_update();
+    buffer.publish(1);
+
+    std::atomic<bool> update_started{false};
+    std::atomic<bool> update_done{false};
+    std::thread writer;
+    {
+        auto guard = buffer.read();  // Pins version 1
+        buffer.begin_update();
+        buffer.publish(2);  // Version 2 lives in the other buffer, so no wait yet
+
+        // Version 3 reuses the buffer of version 1 and must wait for the guard
+        writer = std::thread([&] {
+            update_started = true;
+            buffer.begin_update();
+            update_done = true;
+        });
+        while (!update_started) std::this_thread::yield();
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        EXPECT_FALSE(update_done.load()) << "Spare buffer was handed out while a reader held it";
+        EXPECT_EQ(1u, guard.version());
+    }
+    writer.join();
+    EXPECT_TRUE(update_done.load());
+}
+
+TEST(RcuBufferTest, ConcurrentReadersSeeCompleteVersions) {
+    constexpr size_t words = 16 * 1024;
+    omm::rcu_buffer buffer(words * sizeof(std::uint64_t));
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> torn{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto guard = buffer.read();
+                const auto* data = static_cast<const std::uint64_t*>(guard.data());
+                const size_t count = guard.size() / sizeof(std::uint64_t);
+                for (size_t i = 0; i < count; ++i) {
+                    if (data[i] != guard.version()) {
+                        torn.fetch_add(1);
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(300);
+    while (std::chrono::steady_clock::now() < deadline) {
+        auto* spare = static_cast<std::uint64_t*>(buffer.begin_update());
+        const std::uint64_t next = buffer.version() + 1;
+        std::fill(spare, spare + words, next);
+        buffer.publish(words * sizeof(std::uint64_t));
+    }
+    stop = true;
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(0u, torn.load());
+    EXPECT_GT(buffer.version(), 1u);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
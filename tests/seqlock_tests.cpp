@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "omm/seqlock.h"
+
+using SeqlockCopyFunc = void (*)(void*, const void*, std::size_t);
+
+class SeqlockCopyTest : public ::testing::TestWithParam<std::pair<SeqlockCopyFunc, const char*>> {};
+
+TEST_P(SeqlockCopyTest, CopiesAllSizesAndAlignments) {
+    auto [copy_func, func_name] = GetParam();
+    std::mt19937 gen{42};
+    std::uniform_int_distribution<> dis(0, 255);
+
+    for (size_t size = 0; size <= 300; ++size) {
+        for (size_t offset : {0, 1, 7}) {
+            std::vector<unsigned char> src(size + offset);
+            std::generate(src.begin(), src.end(), [&]() { return static_cast<unsigned char>(dis(gen)); });
+            std::vector<unsigned char> dest(size + offset + 1, 0);
+
+            copy_func(dest.data() + offset, src.data() + offset, size);
+            ASSERT_EQ(0, std::memcmp(dest.data() + offset, src.data() + offset, size))
+                    << func_name << ": size " << size << ", offset " << offset;
+            ASSERT_EQ(0, dest[offset + size]) << "Overflow detected in destination";
+        }
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+        SeqlockCopyTests,
+        SeqlockCopyTest,
+        ::testing::Values(
+                std::make_pair(omm::detail::seqlock_read_generic, "seqlock_read_generic"),
+                std::make_pair(omm::detail::seqlock_write_generic, "seqlock_write_generic"),
+                std::make_pair(omm::seqlock_copy_avx2, "omm::seqlock_copy_avx2")
+        )
+);
+
+#ifdef __AVX512F__
+INSTANTIATE_TEST_SUITE_P(
+        SeqlockCopyTestsAVX512,
+        SeqlockCopyTest,
+        ::testing::Values(
+                std::make_pair(omm::seqlock_copy_avx512, "omm::seqlock_copy_avx512")
+        )
+);
+#endif
+
+namespace {
+
+// Every word holds the same version, so a torn snapshot has mixed words
+struct snapshot {
+    std::uint64_t words[512];  // 4 KiB
+};
+
+bool consistent(const snapshot& s) {
+    return std::all_of(std::begin(s.words), std::end(s.words), [&](std::uint64_t w) { return w == s.words[0]; });
+}
+
+} // namespace
+
+TEST(SeqlockTest, LoadReturnsLastStore) {
+    omm::seqlock<snapshot> lock;
+    EXPECT_EQ(0u, lock.sequence());
+
+    snapshot value;
+    std::fill(std::begin(value.words), std::end(value.words), 7);
+    lock.store(value);
+    EXPECT_EQ(2u, lock.sequence());
+
+    snapshot out {};
+    EXPECT_EQ(2u, lock.load(out));
+    EXPECT_EQ(0, std::memcmp(&out, &value, sizeof(value)));
+}
+
+TEST(SeqlockTest, ConcurrentReadersSeeConsistentSnapshots) {
+    omm::seqlock<snapshot> lock;
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> torn{0};
+    std::atomic<size_t> reads{0};
+
+    std::thread writer([&] {
+        snapshot value;
+        for (std::uint64_t version = 1; !stop.load(std::memory_order_relaxed); ++version) {
+            std::fill(std::begin(value.words), std::end(value.words), version);
+            lock.store(value);
+        }
+    });
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r) {
+        readers.emplace_back([&] {
+            snapshot out;
+            std::uint64_t last_sequence = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                const std::uint64_t sequence = lock.load(out);
+                if (!consistent(out) || sequence % 2 != 0 || sequence < last_sequence) torn.fetch_add(1);
+                // Version v is written as sequence 2v
+                if (sequence != 0 && out.words[0] != sequence / 2) torn.fetch_add(1);
+                last_sequence = sequence;
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    stop = true;
+    writer.join();
+    for (auto& reader : readers) reader.join();
+
+    EXPECT_EQ(0u, torn.load());
+    EXPECT_GT(reads.load(), 0u);
+}
+
+TEST(SeqlockTest, ConcurrentWritersAreSerialized) {
+    alignas(64) std::uint64_t shared[64] = {};
+    std::atomic<std::uint64_t> seq{0};
+    constexpr int WRITES = 2000;
+
+    std::vector<std::thread> writers;
+    for (std::uint64_t id = 1; id <= 2; ++id) {
+        writers.emplace_back([&, id] {
+            std::uint64_t value[64];
+            std::fill(std::begin(value), std::end(value), id);
+            for (int i = 0; i < WRITES; ++i) omm::seqlock_write(shared, value, sizeof(value), seq);
+        });
+    }
+    for (auto& writer : writers) writer.join();
+
+    std::uint64_t out[64];
+    EXPECT_EQ(4u * WRITES, omm::seqlock_copy(out, shared, sizeof(out), seq));
+    EXPECT_TRUE(std::all_of(std::begin(out), std::end(out), [&](std::uint64_t w) { return w == out[0]; }));
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
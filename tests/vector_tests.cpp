@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "omm/vector.h"
+
+// Owns a heap object, so it is not trivially copyable but can be relocated by copying bytes
+struct Handle {
+    std::unique_ptr<std::uint64_t> value;
+
+    explicit Handle(std::uint64_t v) : value(std::make_unique<std::uint64_t>(v)) {}
+};
+
+template <>
+struct omm::is_trivially_relocatable<Handle> : std::true_type {};
+
+// Throws from its constructors once budget of them have run, and counts live instances
+struct Throwing {
+    static inline int budget = 0;
+    static inline int live = 0;
+
+    Throwing() { construct(); }
+    Throwing(const Throwing&) { construct(); }
+    ~Throwing() { --live; }
+
+    static void construct() {
+        if (budget-- == 0) throw std::runtime_error("Throwing");
+        ++live;
+    }
+};
+
+TEST(VectorTest, PushBackAcrossHugeStorageThreshold) {
+    omm::vector<std::uint64_t> values;
+    const size_t count = 3 * omm::vector<std::uint64_t>::HUGE_STORAGE_THRESHOLD / sizeof(std::uint64_t);
+
+    for (size_t i = 0; i < count; ++i) {
+        values.push_back(i * 2654435761u);
+    }
+
+    ASSERT_EQ(count, values.size());
+    EXPECT_GE(values.capacity(), count);
+    EXPECT_TRUE(values.is_mapped());
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(i * 2654435761u, values[i]) << "Element " << i;
+    }
+}
+
+TEST(VectorTest, SmallStorageUsesHeap) {
+    omm::vector<int> values = {1, 2, 3};
+    EXPECT_FALSE(values.is_mapped());
+    EXPECT_EQ(3u, values.size());
+    EXPECT_EQ(3, values.back());
+}
+
+TEST(VectorTest, NonTrivialElements) {
+    omm::vector<std::string> strings;
+    for (int i = 0; i < 1000; ++i) {
+        strings.emplace_back("string number " + std::to_string(i));
+    }
+
+    omm::vector<std::string> copy = strings;
+    strings.clear();
+
+    ASSERT_EQ(1000u, copy.size());
+    for (int i = 0; i < 1000; ++i) {
+        EXPECT_EQ("string number " + std::to_string(i), copy[i]);
+    }
+}
+
+TEST(VectorTest, RelocatableOptIn) {
+    static_assert(omm::is_trivially_relocatable_v<Handle>);
+    static_assert(!std::is_trivially_copyable_v<Handle>);
+
+    omm::vector<Handle> handles;
+    const size_t count = 2 * omm::vector<Handle>::HUGE_STORAGE_THRESHOLD / sizeof(Handle);
+    for (size_t i = 0; i < count; ++i) {
+        handles.emplace_back(i);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(i, *handles[i].value);
+    }
+}
+
+TEST(VectorTest, ResizeUninitializedAndReserve) {
+    omm::vector<std::uint32_t> values;
+    values.reserve(100);
+    EXPECT_GE(values.capacity(), 100u);
+
+    values.resize_uninitialized(1 << 22);
+    ASSERT_EQ(size_t{1} << 22, values.size());
+    for (size_t i = 0; i < values.size(); ++i) values[i] = static_cast<std::uint32_t>(i);
+
+    values.resize(10);
+    EXPECT_EQ(10u, values.size());
+    EXPECT_EQ(9u, values.back());
+
+    values.resize(20, 7u);
+    EXPECT_EQ(7u, values[19]);
+}
+
+TEST(VectorTest, GrowsFromOwnElement) {
+    // Arguments referring to an element stay valid while the storage is reallocated
+    omm::vector<std::string> strings = {std::string(100, 'a')};
+    strings.reserve(1);
+    for (size_t i = 0; i < 10; ++i) strings.push_back(strings[0]);
+    strings.resize(strings.capacity() + 1, strings.back());
+    for (const auto& s : strings) ASSERT_EQ(std::string(100, 'a'), s);
+
+    omm::vector<std::uint64_t> values = {7};
+    const size_t count = 2 * omm::vector<std::uint64_t>::HUGE_STORAGE_THRESHOLD / sizeof(std::uint64_t);
+    while (values.size() < count) values.push_back(values.back());
+    values.resize(values.capacity() + 1, values[0]);
+    for (size_t i = 0; i < values.size(); ++i) ASSERT_EQ(7u, values[i]) << "Element " << i;
+}
+
+TEST(VectorTest, ConstructorsReleaseStorageWhenElementThrows) {
+    // Run under a leak checker: the storage allocated before the throw must be freed
+    const size_t count = 2 * omm::vector<Throwing>::HUGE_STORAGE_THRESHOLD / sizeof(Throwing);
+    for (const size_t size : {size_t{8}, count}) {
+        Throwing::budget = -1;
+        const omm::vector<Throwing> original(size);
+        const Throwing prototype;
+
+        Throwing::budget = static_cast<int>(size / 2);
+        EXPECT_THROW(omm::vector<Throwing> copy(original), std::runtime_error);
+        Throwing::budget = static_cast<int>(size / 2);
+        EXPECT_THROW(omm::vector<Throwing> filled(size, prototype), std::runtime_error);
+        Throwing::budget = static_cast<int>(size / 2);
+        EXPECT_THROW(omm::vector<Throwing> constructed(size), std::runtime_error);
+        Throwing::budget = 1;
+        EXPECT_THROW((omm::vector<Throwing>{prototype, prototype, prototype}), std::runtime_error);
+
+        EXPECT_EQ(static_cast<int>(size) + 1, Throwing::live) << "Partially built elements should be destroyed";
+    }
+    EXPECT_EQ(0, Throwing::live);
+}
+
+TEST(VectorTest, MoveAndSwap) {
+    omm::vector<int> a(5, 42);
+    omm::vector<int> b = std::move(a);
+
+    EXPECT_TRUE(a.empty());
+    ASSERT_EQ(5u, b.size());
+    EXPECT_EQ(42, b[4]);
+
+    a.push_back(1);
+    a.swap(b);
+    EXPECT_EQ(1u, b.size());
+    EXPECT_EQ(5u, a.size());
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}